@@ -0,0 +1,55 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <vector>
+#include "VoiceRenderPool.h"
+
+//==============================================================================
+/**
+ * Synthesiser that can render its active voices in parallel on the shared
+ * VoiceRenderPool. Each voice renders into its own scratch buffer, and the
+ * buffers are summed into the output in voice order, so the result is the same
+ * as single-threaded rendering. Small workloads stay on the calling thread.
+ */
+class AcidSynthesiser : public juce::Synthesiser
+{
+public:
+    AcidSynthesiser() = default;
+
+    // Allocate per-voice scratch buffers (call from prepareToPlay, after adding voices)
+    void prepare(int maximumBlockSize, int numChannels);
+
+    void setParallelRenderingEnabled(bool shouldBeEnabled) { parallelRenderingEnabled = shouldBeEnabled; }
+    bool isParallelRenderingEnabled() const { return parallelRenderingEnabled; }
+
+protected:
+    void renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+
+private:
+    // Renders one active voice into its scratch channels
+    struct VoiceRenderJob : public VoiceRenderPool::Job
+    {
+        explicit VoiceRenderJob(AcidSynthesiser& s) : owner(s) {}
+        void run(int jobIndex) override;
+
+        AcidSynthesiser& owner;
+        int numChannels = 0;
+        int numSamples = 0;
+    };
+
+    static constexpr int kMinParallelVoices = 2;   // Fewer active voices aren't worth the hand-off
+    static constexpr int kMinParallelSamples = 16; // Nor are very short sub-blocks
+    static constexpr int kMaxScratchChannels = 2;
+
+    juce::SharedResourcePointer<VoiceRenderPool> renderPool;
+    VoiceRenderJob renderJob { *this };
+    bool parallelRenderingEnabled = false;
+
+    juce::AudioBuffer<float> voiceScratch;   // numVoices * numChannels channels
+    std::vector<float*> scratchChannels;     // Cached write pointers into voiceScratch
+    std::vector<juce::SynthesiserVoice*> activeVoices;
+    int scratchNumChannels = 0;
+    int scratchNumSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AcidSynthesiser)
+};
@@ -2,6 +2,7 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_core/juce_core.h>
+#include "VoiceParams.h"
 
 //==============================================================================
 /**
@@ -28,6 +29,9 @@ public:
 
     void setCurrentPlaybackSampleRate(double newRate) override;
 
+    // Apply a per-block parameter snapshot, recomputing derived values only for dirty groups
+    void applyParameters(const VoiceParams& params, uint32_t dirtyFlags);
+
     // Main Parameter setters
     void setCutoff(float cutoffHz);
     void setResonance(float resonance);
@@ -70,6 +74,11 @@ public:
     void setVolumeLFO(int rate, int waveform, float depth);
     void setDelayMixLFO(int rate, int waveform, float depth);
 
+    // Quality controls (set by the CPU governor)
+    static constexpr int maxUnisonVoices = 3; // Unison voices per oscillator at full quality
+    void setQuality(int maxUnisonVoicesToRender, int lfoControlIntervalSamples);
+    void setVoiceEnabled(bool shouldBeEnabled) { voiceEnabled = shouldBeEnabled; } // Disabled voices take no new notes
+
 private:
     // LFO State structure
     struct LFO
@@ -105,6 +114,7 @@ private:
     juce::ADSR noiseADSR; // Dedicated envelope for noise decay
     juce::ADSR::Parameters noiseADSRParams;
     double pinkNoiseB0 = 0.0, pinkNoiseB1 = 0.0, pinkNoiseB2 = 0.0; // Pink noise filter state
+    double filteredNoiseB1 = 0.0, filteredNoiseB2 = 0.0; // Band-pass noise filter state (per voice, voices may render in parallel)
 
     // Saturation/Drive
     float driveAmount = 0.0f;
@@ -153,12 +163,18 @@ private:
     double driftPitchRatio3 = 1.0;
 
     // Unison state (multiple detuned voices)
-    static constexpr int maxUnisonVoices = 3;
     double unisonAngles1[maxUnisonVoices] = {0.0, 0.0, 0.0}; // Separate angles per voice
     double unisonAngles2[maxUnisonVoices] = {0.0, 0.0, 0.0};
     double unisonAngles3[maxUnisonVoices] = {0.0, 0.0, 0.0};
     double unisonPhaseOffsets[maxUnisonVoices] = {0.0, juce::MathConstants<double>::pi / 6.0, -juce::MathConstants<double>::pi / 6.0}; // Phase spread
     float unisonDetuneAmounts[maxUnisonVoices] = {0.0f, -1.0f, 1.0f}; // Multiplier for ±10 cents max
+    double unisonDetuneRatios[maxUnisonVoices] = {1.0, 1.0, 1.0}; // Pitch ratios, recomputed when unison changes
+    int unisonVoiceLimit = maxUnisonVoices; // Lowered by the CPU governor
+
+    // Quality state
+    bool voiceEnabled = true;
+    int lfoControlInterval = 1;   // Samples between LFO evaluations (1 = every sample)
+    int lfoSamplesUntilUpdate = 0;
 
     // 10 Dedicated LFOs (one for each parameter)
     LFO cutoffLFO;
@@ -171,6 +187,15 @@ private:
     LFO driveLFO;
     LFO volumeLFO;
     LFO delayMixLFO;
+    juce::Random lfoRandom; // Per-voice source for sample & hold LFOs (std::rand isn't thread-safe)
+
+    // Last evaluated LFO values, held between control-rate updates
+    struct LFOValues
+    {
+        double cutoff = 0.0, resonance = 0.0, envMod = 0.0, decay = 0.0, accent = 0.0;
+        double waveform = 0.0, subOsc = 0.0, drive = 0.0, volume = 0.0;
+    };
+    LFOValues heldLFOValues;
 
     // Helper functions
     double generateSingleOscillator(Oscillator& osc);
@@ -178,6 +203,9 @@ private:
     void processFilter(double& sample, double cutoffLFOValue, double resonanceLFOValue, float modulatedEnvMod, float filterEnvValue);
     void applySaturation(double& sample);
     void updateAngleDelta();
+    void updateUnisonDetune();
+    static void assignOscillator(Oscillator& osc, float wave, int coarse, float fine, float mix);
+    static void assignLFO(LFO& lfo, int rate, int waveform, float depth);
     double getLFOValue(LFO& lfo);
     void updateLFOFrequency(LFO& lfo);
     void advanceLFO(LFO& lfo);
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "NoteSet.h"
+#include <array>
+
+//==============================================================================
+/**
+ * The arpeggiator's note cycle, compiled ahead of the steps that play it.
+ *
+ * compile() lays out one full cycle (held notes x octaves, in the mode's order)
+ * whenever the held notes, mode or octave count change; each step then just
+ * reads the next entry. Random mode draws from the Up cycle with this
+ * instance's own generator rather than the shared, locked system one.
+ * Storage is fixed-size, so it's safe on the audio thread.
+ */
+class ArpPattern
+{
+public:
+    enum Mode { up = 0, down, upDown, random, asPlayed };
+
+    static constexpr int maxHeldNotes = 128;
+    static constexpr int maxOctaves = 4;
+    using HeldNotes = NoteSet<maxHeldNotes>; // In the order they were played
+
+    ArpPattern();
+
+    // Recompiles if any input differs from the last compile (position is kept, wrapped to the new length)
+    void update(const HeldNotes& heldNotes, int mode, int octaves);
+
+    // Makes the next step the first of the cycle
+    void restart() { position = 0; }
+
+    // Next note of the cycle, or -1 if there are none
+    int next();
+
+    int getLength() const { return length; }
+
+private:
+    void compile(const HeldNotes& heldNotes);
+
+    static constexpr int maxLength = maxHeldNotes * maxOctaves * 2;
+
+    std::array<uint8_t, maxLength> cycle {};
+    int length = 0;
+    int position = 0;
+
+    // Inputs of the last compile
+    HeldNotes compiledNotes;
+    int compiledMode = -1;
+    int compiledOctaves = 0;
+
+    juce::Random generator; // Random mode
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ArpPattern)
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "ParameterSchema.h"
+#include "SharedResourceCache.h"
+#include <memory>
+
+//==============================================================================
+/**
+ * Synth preset bank compiled from the system and user JSON files into a flat
+ * binary file that is memory-mapped at load.
+ *
+ * Layout: a fixed header, then one row of Param::numParams floats per preset
+ * (plain values by Param::Id, NaN where the preset leaves a parameter alone),
+ * then a name/description offset pair per preset, then a UTF-8 string table.
+ * The header records the JSON files' sizes and modification times plus a hash
+ * of the parameter schema; if any of those change, the bank is recompiled.
+ * Looking up a preset's name or values is a pointer offset.
+ */
+class CompiledPresetBank
+{
+public:
+    /** Maps binaryFile if it's up to date with the JSON files, otherwise compiles and
+        rewrites it first. If the file can't be written, the compiled bank is kept in memory. */
+    static std::shared_ptr<const CompiledPresetBank> openOrCompile(const juce::File& binaryFile,
+                                                                   const juce::File& systemJSON,
+                                                                   const juce::File& userJSON,
+                                                                   SharedResourceCache& cache);
+
+    int getNumPresets() const { return header != nullptr ? static_cast<int>(header->numPresets) : 0; }
+    int getNumSystemPresets() const { return header != nullptr ? static_cast<int>(header->numSystemPresets) : 0; }
+
+    juce::String getName(int index) const;
+    juce::String getDescription(int index) const;
+
+    /** Plain values indexed by Param::Id; NaN where the preset doesn't set the parameter. */
+    const float* getValues(int index) const;
+
+    // Fixed-size file header (native little-endian)
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t schemaHash;
+        uint32_t numParams;
+        uint32_t numPresets;
+        uint32_t numSystemPresets;
+        uint32_t stringTableOffset;
+        uint32_t stringTableSize;
+        int64_t systemModified;
+        int64_t systemSize;
+        int64_t userModified;
+        int64_t userSize;
+    };
+
+private:
+    struct SourceStamp
+    {
+        int64_t systemModified = 0, systemSize = -1, userModified = 0, userSize = -1;
+    };
+
+    static constexpr uint32_t kMagic = 0x4b425053; // "SPBK"
+    static constexpr uint32_t kVersion = 1;
+
+    CompiledPresetBank() = default;
+
+    bool attach(const void* data, size_t size, const SourceStamp& expected);
+    static uint32_t schemaHash();
+    static SourceStamp stampOf(const juce::File& systemJSON, const juce::File& userJSON);
+    static juce::MemoryBlock compile(const juce::var& systemPresets, const juce::var& userPresets, const SourceStamp& stamp);
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    juce::MemoryBlock ownedData; // Used when the binary file couldn't be written
+
+    const Header* header = nullptr;
+    const float* rows = nullptr;
+    const uint32_t* stringOffsets = nullptr; // Name and description offset per preset
+    const char* strings = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CompiledPresetBank)
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * Watches how long processBlock takes compared to the block deadline
+ * (numSamples / sampleRate) and steps synth quality down when the deadline gets
+ * close, then back up once load has stayed low for a while (hysteresis).
+ *
+ * Called from the audio thread; the step, load and change history can be read
+ * from the message thread for display.
+ */
+class CpuGovernor
+{
+public:
+    // Quality steps, in the order they are given up
+    enum QualityStep
+    {
+        fullQuality = 0,
+        reducedUnison,   // Unison limited to a single voice per oscillator
+        reducedLFORate,  // LFOs evaluated at control rate instead of per sample
+        reducedVoices,   // Polyphony halved
+        numQualitySteps
+    };
+
+    struct Change
+    {
+        juce::uint32 timeMs = 0; // juce::Time::getMillisecondCounter() when it happened
+        int fromStep = 0;
+        int toStep = 0;
+        float load = 0.0f;       // Smoothed load that triggered the change
+    };
+
+    static constexpr int kHistorySize = 16;
+
+    CpuGovernor() = default;
+
+    void prepare(double sampleRate);
+    void setEnabled(bool shouldBeEnabled);
+
+    // Feed the time one block took; returns the quality step to use from now on
+    int update(double elapsedSeconds, int numSamples);
+
+    int getQualityStep() const { return qualityStep.load(std::memory_order_relaxed); }
+    float getLoad() const { return smoothedLoad.load(std::memory_order_relaxed); }
+
+    // Copies up to maxChanges of the most recent changes into dest, newest first
+    int getHistory(Change* dest, int maxChanges) const;
+
+    static juce::String getStepName(int step);
+
+private:
+    void setStep(int newStep, float load);
+
+    static constexpr float kStepDownLoad = 0.75f;      // Fraction of the deadline
+    static constexpr float kStepUpLoad = 0.45f;
+    static constexpr double kMinSecondsBetweenDrops = 0.1;
+    static constexpr double kRecoverySeconds = 2.0;     // Load must stay low this long to step up
+
+    double sampleRate = 44100.0;
+    bool enabled = true;
+    float load = 0.0f;
+    double samplesSinceChange = 0.0;
+    double samplesBelowThreshold = 0.0;
+
+    std::atomic<int> qualityStep { fullQuality };
+    std::atomic<float> smoothedLoad { 0.0f };
+
+    // History ring, each entry packed into one word so readers never see a torn entry
+    std::atomic<uint64_t> history[kHistorySize] = {};
+    std::atomic<int> historyCount { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CpuGovernor)
+};
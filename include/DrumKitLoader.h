@@ -0,0 +1,67 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "DrumSampler.h"
+#include "SharedResourceCache.h"
+
+//==============================================================================
+/**
+ * Finds drum kits on disk and loads them on a background thread.
+ *
+ * The built-in samples folder is listed first as "Default", followed by every
+ * sub-folder of the kits directory. Inside a kit folder, files are matched to
+ * lanes by name prefix (Kick, Snare, HatClosed, HatOpen). Samples come from the
+ * process-wide SharedResourceCache, already resampled to the session rate, so
+ * instances using the same kit share one copy. Finished kits are posted to the
+ * DrumSampler; kits it retires are deleted here.
+ */
+class DrumKitLoader : private juce::Thread
+{
+public:
+    DrumKitLoader(DrumSampler& sampler, const juce::File& defaultKitDirectory, const juce::File& kitsDirectory);
+    ~DrumKitLoader() override;
+
+    // Message thread
+    juce::StringArray getKitNames() const;
+    int getSelectedKit() const { return selectedKit.load(); }
+    void selectKit(int index);
+    void rescan();
+
+    // Rebuilds the current kit at the new rate (call from prepareToPlay)
+    void setSampleRate(double newSampleRate);
+
+private:
+    void run() override;
+
+    struct KitLocation
+    {
+        juce::String name;
+        juce::File directory;
+    };
+
+    void scanKits();
+    void findLaneFiles(const KitLocation& location);
+
+    static constexpr int kRetireCheckMs = 200;
+
+    DrumSampler& sampler;
+    const juce::File defaultKitDirectory;
+    const juce::File kitsDirectory;
+
+    juce::SharedResourcePointer<SharedResourceCache> sharedResources;
+
+    mutable juce::CriticalSection kitListLock;
+    juce::Array<KitLocation> kitList;
+
+    std::atomic<int> selectedKit { 0 };
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<bool> scanRequested { true };
+    juce::WaitableEvent wakeUp;
+
+    // Loader thread only
+    int loadedKit = -1;
+    double builtSampleRate = 0.0;
+    juce::File laneFiles[DrumSampler::numLanes]; // Files of the loaded kit
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumKitLoader)
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "SharedResourceCache.h"
+#include <atomic>
+#include <memory>
+#include <utility>
+
+//==============================================================================
+/**
+ * Sample playback engine for the drum machine.
+ *
+ * Each lane has a small pool of voices so fast repeats overlap instead of
+ * cutting each other off, and a closed hat chokes any ringing open hat with a
+ * short fade. Kits are built off the audio thread from samples already
+ * resampled to the session rate and handed over with an atomic pointer
+ * exchange; hits from the outgoing kit fade out before it is passed back for
+ * deletion.
+ */
+class DrumSampler
+{
+public:
+    enum Lane { kick = 0, snare, closedHat, openHat, numLanes };
+
+    static constexpr int kVoicesPerLane = 4;
+    static constexpr int kChokeFadeSamples = 64;
+
+    /** One sample per lane at the session rate. Immutable once posted; the
+        samples themselves live in the SharedResourceCache. */
+    struct Kit
+    {
+        juce::String name;
+        double sampleRate = 0.0;
+        std::shared_ptr<const SharedResourceCache::AudioSample> lanes[numLanes];
+    };
+
+    DrumSampler() = default;
+    ~DrumSampler();
+
+    // Stops all voices (call from prepareToPlay)
+    void reset();
+
+    // Hands a kit to the audio thread, replacing any kit it hasn't picked up yet (not the audio thread)
+    void postKit(std::unique_ptr<Kit> kit);
+
+    // Deletes kits the audio thread has finished with (same thread as postKit)
+    void collectRetiredKits();
+
+    // Starts a hit sampleOffset samples into the next render call
+    void trigger(int lane, int sampleOffset = 0);
+
+    // Adds all playing voices into output, scaled by each lane's gain
+    void render(juce::AudioBuffer<float>& output, int startSample, int numSamples, const float* laneGains);
+
+    bool hasSample(int lane) const
+    {
+        return currentKit != nullptr && currentKit->lanes[lane] != nullptr
+               && currentKit->lanes[lane]->buffer.getNumSamples() > 0;
+    }
+
+private:
+    struct Voice
+    {
+        const Kit* kit = nullptr; // Kit the hit was started from
+        bool active = false;
+        int position = 0;         // Read position in the lane's sample
+        int startDelay = 0;       // Samples to wait before the hit starts
+        int fadeRemaining = -1;   // Choke fade countdown, -1 when not choking
+        juce::uint32 age = 0;     // Trigger order, for stealing the oldest voice
+    };
+
+    void choke(Voice& voice);
+    void renderVoice(Voice& voice, int lane, juce::AudioBuffer<float>& output,
+                     int startSample, int numSamples, float gain);
+
+    // Audio thread: swaps in a posted kit once the previous one is no longer playing
+    void applyPendingKit();
+    bool isKitPlaying(const Kit* kit) const;
+    bool retireKit(Kit* kit);
+
+    Voice voices[numLanes][kVoicesPerLane];
+    juce::uint32 triggerCounter = 0;
+
+    Kit* currentKit = nullptr;  // Audio thread
+    Kit* previousKit = nullptr; // Audio thread; still fading out after a swap
+    std::atomic<Kit*> pendingKit { nullptr };
+
+    // Kits waiting to be deleted off the audio thread
+    static constexpr int kRetireSlots = 8;
+    juce::AbstractFifo retireFifo { kRetireSlots };
+    Kit* retiredKits[kRetireSlots] = {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumSampler)
+};
@@ -6,8 +6,8 @@
 
 //==============================================================================
 /**
- * Drum Machine Tab - 16-step drum sequencer with 4 lanes
- * Kick, Snare, Closed Hat, Open Hat
+ * Drum Machine Tab - drum sequencer (up to 256 steps, shown a page of 16 at
+ * a time) with 4 lanes: Kick, Snare, Closed Hat, Open Hat
  */
 class DrumTab : public juce::Component, private juce::Timer
 {
@@ -23,7 +23,7 @@ private:
     SnorkelSynthAudioProcessor& audioProcessor;
 
     // Constants
-    static constexpr int NUM_STEPS = 16;
+    static constexpr int NUM_STEPS = PatternData::stepsPerPage; // Columns; column N shows step page * 16 + N
     static constexpr int NUM_LANES = 4; // Kick, Snare, CHat, OHat
 
     // Lane names
@@ -33,7 +33,24 @@ private:
     juce::ToggleButton enableToggle;
     juce::Label enableLabel;
 
-    // Step buttons grid [lane][step]
+    // Kit selector (kits are found in the background, so the list is refreshed from the timer)
+    juce::ComboBox kitSelector;
+    juce::Label kitLabel;
+    juce::StringArray lastKitNames;
+    void updateKitSelector();
+
+    // Step count and the page of 16 steps the grid shows
+    juce::Slider stepsSlider;
+    juce::Label stepsLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> stepsAttachment;
+    juce::Slider pageSlider;
+    juce::Label pageLabel;
+    int page = 0;
+    int lastNumSteps = 0;
+    int stepForColumn(int column) const { return page * NUM_STEPS + column; }
+    void updatePageRange();
+
+    // Step buttons grid [lane][column]
     juce::TextButton stepButtons[NUM_LANES][NUM_STEPS];
 
     // Per-lane volume sliders
@@ -53,19 +70,30 @@ private:
     juce::Label sidechainLengthLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sidechainMagnitudeAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sidechainLengthAttachment;
-
-    // Pattern selection buttons (1-8)
-    static constexpr int NUM_PATTERNS = 8;
+    juce::Slider sidechainAttackSlider;
+    juce::Label sidechainAttackLabel;
+    juce::Slider sidechainHoldSlider;
+    juce::Label sidechainHoldLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sidechainAttackAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sidechainHoldAttachment;
+
+    // Pattern selection buttons (8 per bank, banks A-H)
+    static constexpr int NUM_PATTERNS = PatternData::drumPatternsPerBank;
+    static constexpr int NUM_BANKS = PatternData::numDrumBanks;
     juce::TextButton patternButtons[NUM_PATTERNS];
+    juce::ComboBox bankSelector;
+    int bank = 0;
     void onPatternButtonClicked(int patternIndex);
     void updatePatternButtonStates();
 
-    // Chain sequencer (1-8 steps, each selects a pattern)
+    // Chain sequencer (1-8 steps, each selects a pattern of the chain's bank)
     static constexpr int NUM_CHAIN_STEPS = 8;
     juce::ToggleButton chainEnableToggle;
     juce::Label chainEnableLabel;
     juce::Slider chainStepsSlider;
     juce::Label chainStepsLabel;
+    juce::ComboBox chainBankSelector;
+    juce::Label chainBankLabel;
     juce::Slider chainStepSliders[NUM_CHAIN_STEPS];
     juce::Label chainStepLabels[NUM_CHAIN_STEPS];
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> chainEnableAttachment;
@@ -81,7 +109,7 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> enableAttachment;
 
     // Button click handlers
-    void onStepButtonClicked(int lane, int step);
+    void onStepButtonClicked(int lane, int column);
     void updateButtonStates();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumTab)
@@ -8,7 +8,7 @@
 /**
  * Filter Tab - Contains filter and envelope controls
  */
-class FilterTab : public juce::Component
+class FilterTab : public juce::Component, private juce::ChangeListener
 {
 public:
     FilterTab(SnorkelSynthAudioProcessor& p);
@@ -17,6 +17,10 @@ public:
     void paint(juce::Graphics&) override;
     void resized() override;
 
+    // Preset banks load in the background; refill the selector when they arrive
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+    void refreshPresetSelector();
+
 private:
     SnorkelSynthAudioProcessor& audioProcessor;
 
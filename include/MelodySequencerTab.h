@@ -101,11 +101,12 @@ public:
 
 //==============================================================================
 /**
- * Melody Sequencer Tab - Contains 16-step melodic sequencer
+ * Melody Sequencer Tab - Contains the melodic sequencer (up to 256 steps,
+ * shown a page of 16 at a time)
  */
 class SnorkelSynthAudioProcessorEditor; // Forward declaration
 
-class MelodySequencerTab : public juce::Component, private juce::Timer
+class MelodySequencerTab : public juce::Component, private juce::Timer, private juce::ChangeListener
 {
 public:
     MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSynthAudioProcessorEditor& e);
@@ -115,6 +116,10 @@ public:
     void resized() override;
     void timerCallback() override;
 
+    // Preset banks load in the background; refill the selector when they arrive
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+    void refreshPresetSelector();
+
 private:
     SnorkelSynthAudioProcessor& audioProcessor;
     SnorkelSynthAudioProcessorEditor& editor;
@@ -141,12 +146,33 @@ private:
     juce::ComboBox rateSelector;
     juce::Slider gateSlider;
 
-    // 16 steps x 8 buttons (scale degrees)
-    static constexpr int NUM_STEPS = 16;
+    // 16 columns x 8 buttons (scale degrees); column N shows step page * 16 + N
+    static constexpr int NUM_STEPS = PatternData::stepsPerPage;
     static constexpr int NUM_SCALE_DEGREES = 8;
     StepButton stepButtons[NUM_STEPS][NUM_SCALE_DEGREES];
 
-    // Per-step accent modulation (16 steps)
+    // Pattern selector (1-64) and page of the pattern the grid shows
+    juce::ComboBox patternSelector;
+    juce::Label patternLabel;
+    juce::Slider pageSlider;
+    juce::Label pageLabel;
+    int page = 0;
+    int lastMelodyPattern = 0;
+    int lastNumSteps = 0;
+    int stepForColumn(int column) const { return page * NUM_STEPS + column; }
+    void updatePageRange();
+    void setStepCount(int numSteps); // Split into the store's melody pages and seqsteps
+
+    // The pattern the grid shows (the one playing) and an edit of it
+    const PatternData::MelodyPattern& getMelody() const;
+    template <typename EditFn>
+    void editMelody(EditFn&& editFn)
+    {
+        const int index = audioProcessor.currentMelodyPatternIndex;
+        audioProcessor.patternStore.edit([index, &editFn](PatternData& patterns) { editFn(patterns.melody[index]); });
+    }
+
+    // Per-step accent modulation (repeats every 16 steps, so one row serves every page)
     juce::Slider accentSliders[NUM_STEPS];
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> accentAttachments[NUM_STEPS];
 
@@ -175,21 +201,21 @@ private:
 
     // Attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> enableAttachment;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> stepsAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> rateAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> gateAttachment;
 
-    // Button click handlers
-    void onStepButtonClicked(int step, int degree);
+    // Button click handlers (columns of the grid)
+    void onStepButtonClicked(int column, int degree);
     void updateButtonStates();
     void updateOctaveDisplay();
-    void updateOctaveDisplayForStep(int step);
-    void onOctaveUpClicked(int step, int degree);
-    void onOctaveDownClicked(int step, int degree);
+    void updateOctaveDisplayForColumn(int column);
+    void onOctaveUpClicked(int column, int degree);
+    void onOctaveDownClicked(int column, int degree);
     void loadPreset(int presetIndex);
     void onRandomClicked();
-    void generateTrueRandom();
-    void generateWeightedRandom(int specificConfigIndex = -1); // -1 = random, 0-3 = specific config
+    // Randomizers fill the shown page: steps firstStep to firstStep + 15
+    void generateTrueRandom(PatternData::MelodyPattern& melody, int firstStep);
+    void generateWeightedRandom(PatternData::MelodyPattern& melody, int firstStep, int specificConfigIndex = -1); // -1 = random, 0-3 = specific config
     void onMutateClicked();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MelodySequencerTab)
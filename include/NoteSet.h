@@ -0,0 +1,51 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+
+//==============================================================================
+/**
+ * A set of MIDI notes stored inline, in the order they were added.
+ *
+ * For the audio thread: it never allocates. Notes added past Capacity are
+ * dropped (the arpeggiator can hold all 128 notes, so nothing is lost there).
+ */
+template <int Capacity>
+class NoteSet
+{
+public:
+    // Appends note unless it's already present; returns false if it was present or the set is full
+    bool add(int note)
+    {
+        if (count == Capacity || contains(note))
+            return false;
+
+        notes[static_cast<size_t>(count++)] = static_cast<int8_t>(note);
+        return true;
+    }
+
+    // Removes note, keeping the order of the rest
+    void remove(int note)
+    {
+        auto* last = std::remove(begin(), end(), static_cast<int8_t>(note));
+        count = static_cast<int>(last - begin());
+    }
+
+    bool contains(int note) const { return std::find(begin(), end(), static_cast<int8_t>(note)) != end(); }
+    void clear() { count = 0; }
+    void sort() { std::sort(begin(), end()); }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    int operator[](int index) const { return notes[static_cast<size_t>(index)]; }
+
+    int8_t* begin() { return notes.data(); }
+    int8_t* end() { return notes.data() + count; }
+    const int8_t* begin() const { return notes.data(); }
+    const int8_t* end() const { return notes.data() + count; }
+
+private:
+    std::array<int8_t, Capacity> notes {};
+    int count = 0;
+};
@@ -11,7 +11,7 @@ class SnorkelSynthAudioProcessorEditor;
 /**
  * Oscillator Tab - Contains oscillator and amplitude controls
  */
-class OscTab : public juce::Component
+class OscTab : public juce::Component, private juce::ChangeListener
 {
 public:
     OscTab(SnorkelSynthAudioProcessor& p, SnorkelSynthAudioProcessorEditor& e);
@@ -20,6 +20,10 @@ public:
     void paint(juce::Graphics&) override;
     void resized() override;
 
+    // Preset banks load in the background; refill the selector when they arrive
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+    void refreshPresetSelector();
+
 private:
     SnorkelSynthAudioProcessor& audioProcessor;
     SnorkelSynthAudioProcessorEditor& editor;
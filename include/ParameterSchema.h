@@ -0,0 +1,465 @@
+#pragma once
+
+#include <cstdint>
+#include "VoiceParams.h"
+
+//==============================================================================
+/**
+ * Compile-time description of every plugin parameter. The processor builds its
+ * APVTS layout, synth preset load/save and the indexed value array from this
+ * one table, so adding a parameter means adding one enum entry and one row.
+ *
+ * Param::Id order is the table order (checked below) and must stay stable:
+ * voices and the processor index straight into it on the audio thread.
+ */
+namespace Param
+{
+    enum Id : int
+    {
+        // Main
+        cutoff = 0, resonance, envMod, accent,
+
+        // Filter / amplitude ADSR
+        filterAttack, filterDecay, filterSustain, filterRelease,
+        ampAttack, ampDecay, ampSustain, ampRelease,
+
+        // Oscillators (wave, coarse, fine, mix per oscillator)
+        osc1Wave, osc1Coarse, osc1Fine, osc1Mix,
+        osc2Wave, osc2Coarse, osc2Fine, osc2Mix,
+        osc3Wave, osc3Coarse, osc3Fine, osc3Mix,
+
+        // Noise
+        noiseType, noiseDecay, noiseMix,
+
+        // Output / pitch
+        drive, volume, globalOctave,
+
+        // Analog character
+        drift, phaseRandom, unison,
+
+        // Filter & saturation
+        filterFeedback, saturationType,
+
+        // Delay
+        delayTime, delayFeedback, delayMix,
+
+        // Dedicated LFOs: rate, wave, depth per target, in VoiceParams::LFOIndex order
+        firstLFO,
+        lastLFO = firstLFO + VoiceParams::numLFOs * 3 - 1,
+
+        // Arpeggiator
+        arpOnOff, arpMode, arpRate, arpOctaves, arpGate, arpOctaveShift, arpSwing,
+
+        // Sequencer
+        seqEnabled, seqRoot, seqScale, seqSteps, seqRate, seqGate,
+        seqOctave1,
+        seqOctave16 = seqOctave1 + 15,
+        seqCutoff1,
+        seqCutoff16 = seqCutoff1 + 15,
+        seqAccentVol, seqAccentCutoff, seqAccentRes, seqAccentDecay, seqAccentDrive,
+        seqSongEnabled,
+
+        // Progression
+        progEnabled, progSteps, progLength,
+        progStep1,
+        progStep16 = progStep1 + 15,
+
+        // Global
+        globalBpm, masterVolume,
+
+        // Drums
+        drumEnable, drumSteps, drumKickVol, drumSnareVol, drumClosedHatVol, drumOpenHatVol,
+        drumMasterVol, drumSidechainMag, drumSidechainLen, drumSidechainAttack, drumSidechainHold,
+        drumChainEnabled, drumChainSteps,
+        drumChainStep1,
+        drumChainStep8 = drumChainStep1 + 7,
+
+        // Performance
+        parallelRender, cpuGovernor,
+
+        numParams
+    };
+
+    // Indexed helpers for the repeated groups
+    constexpr Id lfoRate(int lfo)       { return static_cast<Id>(firstLFO + lfo * 3); }
+    constexpr Id lfoWave(int lfo)       { return static_cast<Id>(firstLFO + lfo * 3 + 1); }
+    constexpr Id lfoDepth(int lfo)      { return static_cast<Id>(firstLFO + lfo * 3 + 2); }
+    constexpr Id seqOctave(int step)    { return static_cast<Id>(seqOctave1 + step); }
+    constexpr Id seqCutoff(int step)    { return static_cast<Id>(seqCutoff1 + step); }
+    constexpr Id progStep(int step)     { return static_cast<Id>(progStep1 + step); }
+    constexpr Id drumChainStep(int step){ return static_cast<Id>(drumChainStep1 + step); }
+
+    enum class Type : uint8_t { Float, Int, Choice, Bool };
+
+    enum class Group : uint8_t
+    {
+        Synth, Modulation, Arpeggiator, Sequencer, Progression, Global, Drums, Performance
+    };
+
+    // What loading a synth preset does when the preset has no value for a parameter
+    enum class Missing : uint8_t
+    {
+        Skip,       // Leave the current value alone (keys added after the first presets)
+        UseDefault  // Reset to the parameter default
+    };
+
+    //==============================================================================
+    struct Spec
+    {
+        Id index;
+        const char* id;       // APVTS parameter ID (also used by the UI attachments)
+        const char* name;
+        Type type;
+        float minValue, maxValue, interval, skew;
+        float defaultValue;   // Plain value (choice index for Choice, 0/1 for Bool)
+        const char* const* choices;
+        int numChoices;
+        Group group;
+
+        // Synth preset JSON (nullptr = not stored in synth presets)
+        const char* presetKey = nullptr;
+        const char* legacyPresetKey = nullptr; // Older key read when presetKey is absent
+        Missing missing = Missing::Skip;
+
+        constexpr Spec inPreset(const char* key, Missing whenMissing, const char* legacyKey = nullptr) const
+        {
+            Spec s = *this;
+            s.presetKey = key;
+            s.missing = whenMissing;
+            s.legacyPresetKey = legacyKey;
+            return s;
+        }
+
+        // Integer-valued parameters are written to presets as ints
+        constexpr bool isDiscrete() const { return type != Type::Float; }
+    };
+
+    constexpr Spec makeFloat(Id index, const char* id, const char* name, float minValue, float maxValue,
+                             float interval, float defaultValue, Group group, float skew = 1.0f)
+    {
+        return { index, id, name, Type::Float, minValue, maxValue, interval, skew, defaultValue, nullptr, 0, group };
+    }
+
+    constexpr Spec makeInt(Id index, const char* id, const char* name, int minValue, int maxValue,
+                           int defaultValue, Group group)
+    {
+        return { index, id, name, Type::Int, static_cast<float>(minValue), static_cast<float>(maxValue), 1.0f, 1.0f,
+                 static_cast<float>(defaultValue), nullptr, 0, group };
+    }
+
+    template <int N>
+    constexpr Spec makeChoice(Id index, const char* id, const char* name, const char* const (&choices)[N],
+                              int defaultIndex, Group group)
+    {
+        return { index, id, name, Type::Choice, 0.0f, static_cast<float>(N - 1), 1.0f, 1.0f,
+                 static_cast<float>(defaultIndex), choices, N, group };
+    }
+
+    constexpr Spec makeBool(Id index, const char* id, const char* name, bool defaultValue, Group group)
+    {
+        return { index, id, name, Type::Bool, 0.0f, 1.0f, 1.0f, 1.0f, defaultValue ? 1.0f : 0.0f, nullptr, 0, group };
+    }
+}
+
+//==============================================================================
+// Default Parameter Values
+namespace Defaults
+{
+    static constexpr float kCutoff = 1000.0f;
+    static constexpr float kResonance = 0.7f;
+    static constexpr float kEnvMod = 0.5f;
+    static constexpr float kDecay = 0.3f;
+    static constexpr float kAccent = 0.5f;
+    static constexpr float kWaveform = 0.0f;  // 0.0=saw, 1.0=square, morph in between
+    static constexpr float kSubOsc = 0.5f;
+    static constexpr float kDrive = 0.0f;
+    static constexpr float kVolume = 0.5f;
+    static constexpr int   kDelayTime = 1;  // 1/8 note (index 1)
+    static constexpr float kDelayFeedback = 0.3f;
+    static constexpr float kDelayMix = 0.0f; // Off by default
+
+    // Dedicated LFO defaults (each parameter has its own LFO)
+    static constexpr int   kLFORate = 6;     // Default: 1/1 (whole note)
+    static constexpr int   kLFOWaveform = 0; // Default: Sine wave
+    static constexpr float kLFODepth = 0.0f; // Default: Off
+}
+
+//==============================================================================
+// Choice lists
+namespace ParamChoices
+{
+    inline constexpr const char* kSaturationTypes[] = { "Clean", "Warm", "Tube", "Hard", "Acid" };
+    inline constexpr const char* kDelayTimes[] = { "1/16", "1/16.", "1/16T", "1/8", "1/8.", "1/8T", "1/4", "1/4.", "1/4T", "1/2", "1/2.", "1/1" };
+    inline constexpr const char* kLFORates[] = { "1/16", "1/8", "1/4", "1/3", "1/2", "3/4", "1/1", "3/2", "2/1", "3/1", "4/1", "6/1", "8/1", "12/1", "16/1" };
+    inline constexpr const char* kLFOWaveforms[] = { "Sine", "Triangle", "Saw Up", "Saw Down", "Square", "Random" };
+    inline constexpr const char* kArpModes[] = { "Up", "Down", "Up-Down", "Random", "As Played" };
+    inline constexpr const char* kNoteRates[] = { "1/32", "1/32.", "1/16", "1/16.", "1/16T", "1/8", "1/8.", "1/8T", "1/4", "1/4.", "1/4T", "1/2", "1/2.", "1/1" };
+    inline constexpr const char* kRootNotes[] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+    inline constexpr const char* kScales[] = { "Major", "Minor", "Dorian", "Phrygian", "Lydian", "Mixolydian", "Aeolian", "Locrian", "Harmonic Minor", "Melodic Minor", "Pentatonic Major", "Pentatonic Minor", "Blues" };
+    inline constexpr const char* kProgressionLengths[] = { "1/2", "1", "2", "3", "4" };
+}
+
+//==============================================================================
+// The table
+namespace Param
+{
+    using G = Group;
+    using M = Missing;
+    namespace C = ParamChoices;
+
+    inline constexpr Spec kSpecs[] =
+    {
+        // Main
+        makeFloat(cutoff, "cutoff", "Cutoff", 20.0f, 5000.0f, 1.0f, Defaults::kCutoff, G::Synth, 0.3f).inPreset("cutoff", M::UseDefault),
+        makeFloat(resonance, "resonance", "Resonance", 0.0f, 1.5f, 0.01f, Defaults::kResonance, G::Synth).inPreset("resonance", M::UseDefault),
+        makeFloat(envMod, "envmod", "Env Mod", 0.0f, 1.0f, 0.01f, Defaults::kEnvMod, G::Synth).inPreset("envMod", M::UseDefault),
+        makeFloat(accent, "accent", "Accent", 0.0f, 1.0f, 0.01f, Defaults::kAccent, G::Synth).inPreset("accent", M::UseDefault),
+
+        // Filter ADSR (3ms attack, 300ms decay, no sustain - classic 303 behavior)
+        makeFloat(filterAttack, "filterattack", "Filter Attack", 0.0f, 2.0f, 0.001f, 0.003f, G::Synth, 0.5f).inPreset("filterAttack", M::Skip),
+        makeFloat(filterDecay, "filterdecay", "Filter Decay", 0.001f, 5.0f, 0.001f, 0.3f, G::Synth, 0.5f).inPreset("filterDecay", M::Skip),
+        makeFloat(filterSustain, "filtersustain", "Filter Sustain", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("filterSustain", M::Skip),
+        makeFloat(filterRelease, "filterrelease", "Filter Release", 0.0f, 5.0f, 0.001f, 0.1f, G::Synth, 0.5f).inPreset("filterRelease", M::Skip),
+
+        // Amplitude ADSR
+        makeFloat(ampAttack, "ampattack", "Amp Attack", 0.0f, 2.0f, 0.001f, 0.003f, G::Synth, 0.5f).inPreset("ampAttack", M::Skip),
+        makeFloat(ampDecay, "ampdecay", "Amp Decay", 0.001f, 5.0f, 0.001f, 0.3f, G::Synth, 0.5f).inPreset("ampDecay", M::Skip),
+        makeFloat(ampSustain, "ampsustain", "Amp Sustain", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("ampSustain", M::Skip),
+        makeFloat(ampRelease, "amprelease", "Amp Release", 0.0f, 5.0f, 0.001f, 0.1f, G::Synth, 0.5f).inPreset("ampRelease", M::Skip),
+
+        // Oscillator 1 (old presets stored its wave as "waveform")
+        makeFloat(osc1Wave, "osc1wave", "Osc 1 Wave", 0.0f, 1.0f, 0.01f, 0.5f, G::Synth).inPreset("osc1Wave", M::UseDefault, "waveform"),
+        makeInt(osc1Coarse, "osc1coarse", "Osc 1 Coarse", -24, 24, 0, G::Synth).inPreset("osc1Coarse", M::UseDefault),
+        makeFloat(osc1Fine, "osc1fine", "Osc 1 Fine", -100.0f, 100.0f, 1.0f, 0.0f, G::Synth).inPreset("osc1Fine", M::UseDefault),
+        makeFloat(osc1Mix, "osc1mix", "Osc 1 Mix", 0.0f, 1.0f, 0.01f, 0.7f, G::Synth).inPreset("osc1Mix", M::UseDefault),
+
+        // Oscillator 2 (off for old presets)
+        makeFloat(osc2Wave, "osc2wave", "Osc 2 Wave", 0.0f, 1.0f, 0.01f, 0.5f, G::Synth).inPreset("osc2Wave", M::UseDefault),
+        makeInt(osc2Coarse, "osc2coarse", "Osc 2 Coarse", -24, 24, 0, G::Synth).inPreset("osc2Coarse", M::UseDefault),
+        makeFloat(osc2Fine, "osc2fine", "Osc 2 Fine", -100.0f, 100.0f, 1.0f, 0.0f, G::Synth).inPreset("osc2Fine", M::UseDefault),
+        makeFloat(osc2Mix, "osc2mix", "Osc 2 Mix", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("osc2Mix", M::UseDefault),
+
+        // Oscillator 3 (sub osc by default; old presets stored its mix as "subOsc")
+        makeFloat(osc3Wave, "osc3wave", "Osc 3 Wave", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("osc3Wave", M::UseDefault),
+        makeInt(osc3Coarse, "osc3coarse", "Osc 3 Coarse", -24, 24, -12, G::Synth).inPreset("osc3Coarse", M::UseDefault),
+        makeFloat(osc3Fine, "osc3fine", "Osc 3 Fine", -100.0f, 100.0f, 1.0f, 0.0f, G::Synth).inPreset("osc3Fine", M::UseDefault),
+        makeFloat(osc3Mix, "osc3mix", "Osc 3 Mix", 0.0f, 1.0f, 0.01f, 0.5f, G::Synth).inPreset("osc3Mix", M::UseDefault, "subOsc"),
+
+        // Noise oscillator (white, sustained, off)
+        makeFloat(noiseType, "noisetype", "Noise Type", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("noiseType", M::Skip),
+        makeFloat(noiseDecay, "noisedecay", "Noise Decay", 0.0f, 2.0f, 0.01f, 2.0f, G::Synth).inPreset("noiseDecay", M::Skip),
+        makeFloat(noiseMix, "noisemix", "Noise Mix", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("noiseMix", M::Skip),
+
+        makeFloat(drive, "drive", "Drive", 0.0f, 1.0f, 0.01f, Defaults::kDrive, G::Synth).inPreset("drive", M::UseDefault),
+        makeFloat(volume, "volume", "Volume", 0.0f, 1.0f, 0.01f, Defaults::kVolume, G::Synth).inPreset("volume", M::UseDefault),
+        makeInt(globalOctave, "globaloctave", "Global Octave", -2, 2, 0, G::Synth).inPreset("globalOctave", M::Skip),
+
+        // Analog character
+        makeFloat(drift, "drift", "Drift", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("drift", M::Skip),
+        makeFloat(phaseRandom, "phaserandom", "Phase Random", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("phaseRandom", M::Skip),
+        makeFloat(unison, "unison", "Unison", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("unison", M::Skip),
+
+        // Filter & saturation
+        makeFloat(filterFeedback, "filterfeedback", "Filter Feedback", 0.0f, 1.0f, 0.01f, 0.0f, G::Synth).inPreset("filterFeedback", M::Skip),
+        makeChoice(saturationType, "saturationtype", "Saturation Type", C::kSaturationTypes, 0, G::Synth).inPreset("saturationType", M::Skip),
+
+        // Delay
+        makeChoice(delayTime, "delaytime", "Delay Time", C::kDelayTimes, Defaults::kDelayTime, G::Synth).inPreset("delayTime", M::UseDefault),
+        makeFloat(delayFeedback, "delayfeedback", "Delay Feedback", 0.0f, 0.95f, 0.01f, Defaults::kDelayFeedback, G::Synth).inPreset("delayFeedback", M::UseDefault),
+        makeFloat(delayMix, "delaymix", "Delay Mix", 0.0f, 1.0f, 0.01f, Defaults::kDelayMix, G::Synth).inPreset("delayMix", M::UseDefault),
+
+        // Dedicated LFOs
+        makeChoice(lfoRate(0), "cutofflfor", "Cutoff LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(0), "cutofflfow", "Cutoff LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(0), "cutofflfod", "Cutoff LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(1), "resonancelforate", "Resonance LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(1), "resonancelfowave", "Resonance LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(1), "resonancelfodepth", "Resonance LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(2), "envmodlforate", "EnvMod LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(2), "envmodlfowave", "EnvMod LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(2), "envmodlfodepth", "EnvMod LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(3), "decaylforate", "Decay LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(3), "decaylfowave", "Decay LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(3), "decaylfodepth", "Decay LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(4), "accentlforate", "Accent LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(4), "accentlfowave", "Accent LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(4), "accentlfodepth", "Accent LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(5), "waveformlforate", "Waveform LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(5), "waveformlfowave", "Waveform LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(5), "waveformlfodepth", "Waveform LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(6), "subosclforate", "SubOsc LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(6), "subosclfowave", "SubOsc LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(6), "subosclfodepth", "SubOsc LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(7), "drivelforate", "Drive LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(7), "drivelfowave", "Drive LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(7), "drivelfodepth", "Drive LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(8), "volumelforate", "Volume LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(8), "volumelfowave", "Volume LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(8), "volumelfodepth", "Volume LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        makeChoice(lfoRate(9), "delaymixlforate", "DelayMix LFO Rate", C::kLFORates, Defaults::kLFORate, G::Modulation),
+        makeChoice(lfoWave(9), "delaymixlfowave", "DelayMix LFO Wave", C::kLFOWaveforms, Defaults::kLFOWaveform, G::Modulation),
+        makeFloat(lfoDepth(9), "delaymixlfodepth", "DelayMix LFO Depth", 0.0f, 0.5f, 0.01f, Defaults::kLFODepth, G::Modulation),
+
+        // Arpeggiator (enabled, 1/8, 2 octaves, 80% gate, straight timing)
+        makeBool(arpOnOff, "arponoff", "Arp On/Off", true, G::Arpeggiator),
+        makeChoice(arpMode, "arpmode", "Arp Mode", C::kArpModes, 0, G::Arpeggiator),
+        makeChoice(arpRate, "arprate", "Arp Rate", C::kNoteRates, 5, G::Arpeggiator),
+        makeInt(arpOctaves, "arpoctaves", "Arp Octaves", 1, 4, 2, G::Arpeggiator),
+        makeFloat(arpGate, "arpgate", "Arp Gate", 0.1f, 1.0f, 0.01f, 0.8f, G::Arpeggiator),
+        makeInt(arpOctaveShift, "arpoctaveshift", "Arp Octave Shift", -2, 2, 0, G::Arpeggiator),
+        makeFloat(arpSwing, "arpswing", "Arp Swing", 0.0f, 1.0f, 0.01f, 0.0f, G::Arpeggiator),
+
+        // Sequencer (enabled, C minor, 16 steps of 1/16, 80% gate)
+        makeBool(seqEnabled, "seqenabled", "Seq Enabled", true, G::Sequencer),
+        makeChoice(seqRoot, "seqroot", "Seq Root", C::kRootNotes, 0, G::Sequencer),
+        makeChoice(seqScale, "seqscale", "Seq Scale", C::kScales, 1, G::Sequencer),
+        makeInt(seqSteps, "seqsteps", "Seq Steps", 1, 16, 16, G::Sequencer),
+        makeChoice(seqRate, "seqrate", "Seq Rate", C::kNoteRates, 2, G::Sequencer),
+        makeFloat(seqGate, "seqgate", "Seq Gate", 0.1f, 1.0f, 0.01f, 0.8f, G::Sequencer),
+
+        // Sequencer per-step octave
+        makeInt(seqOctave(0), "seqoctave1", "Seq Octave 1", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(1), "seqoctave2", "Seq Octave 2", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(2), "seqoctave3", "Seq Octave 3", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(3), "seqoctave4", "Seq Octave 4", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(4), "seqoctave5", "Seq Octave 5", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(5), "seqoctave6", "Seq Octave 6", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(6), "seqoctave7", "Seq Octave 7", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(7), "seqoctave8", "Seq Octave 8", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(8), "seqoctave9", "Seq Octave 9", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(9), "seqoctave10", "Seq Octave 10", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(10), "seqoctave11", "Seq Octave 11", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(11), "seqoctave12", "Seq Octave 12", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(12), "seqoctave13", "Seq Octave 13", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(13), "seqoctave14", "Seq Octave 14", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(14), "seqoctave15", "Seq Octave 15", -2, 2, 0, G::Sequencer),
+        makeInt(seqOctave(15), "seqoctave16", "Seq Octave 16", -2, 2, 0, G::Sequencer),
+
+        // Sequencer per-step cutoff modulation (continuous)
+        makeFloat(seqCutoff(0), "seqcutoff1", "Seq Cutoff 1", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(1), "seqcutoff2", "Seq Cutoff 2", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(2), "seqcutoff3", "Seq Cutoff 3", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(3), "seqcutoff4", "Seq Cutoff 4", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(4), "seqcutoff5", "Seq Cutoff 5", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(5), "seqcutoff6", "Seq Cutoff 6", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(6), "seqcutoff7", "Seq Cutoff 7", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(7), "seqcutoff8", "Seq Cutoff 8", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(8), "seqcutoff9", "Seq Cutoff 9", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(9), "seqcutoff10", "Seq Cutoff 10", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(10), "seqcutoff11", "Seq Cutoff 11", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(11), "seqcutoff12", "Seq Cutoff 12", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(12), "seqcutoff13", "Seq Cutoff 13", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(13), "seqcutoff14", "Seq Cutoff 14", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(14), "seqcutoff15", "Seq Cutoff 15", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqCutoff(15), "seqcutoff16", "Seq Cutoff 16", -1.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+
+        // Sequencer accent control amounts (continuous)
+        makeFloat(seqAccentVol, "seqaccentvol", "Seq Accent Volume", 0.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqAccentCutoff, "seqaccentcutoff", "Seq Accent Cutoff", 0.0f, 1.0f, 0.0f, 0.5f, G::Sequencer),
+        makeFloat(seqAccentRes, "seqaccentres", "Seq Accent Resonance", 0.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqAccentDecay, "seqaccentdecay", "Seq Accent Decay", 0.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+        makeFloat(seqAccentDrive, "seqaccentdrive", "Seq Accent Drive", 0.0f, 1.0f, 0.0f, 0.0f, G::Sequencer),
+
+        // Melody song (the entries live with the patterns)
+        makeBool(seqSongEnabled, "seqsongenabled", "Seq Song Enabled", false, G::Sequencer),
+
+        // Progression (enabled, 4 steps of 1 bar, all on scale degree 1)
+        makeBool(progEnabled, "progenabled", "Progression Enabled", true, G::Progression),
+        makeInt(progSteps, "progsteps", "Progression Steps", 1, 16, 4, G::Progression),
+        makeChoice(progLength, "proglength", "Progression Length", C::kProgressionLengths, 1, G::Progression),
+        makeInt(progStep(0), "progstep1", "Progression Step 1", 1, 8, 1, G::Progression),
+        makeInt(progStep(1), "progstep2", "Progression Step 2", 1, 8, 1, G::Progression),
+        makeInt(progStep(2), "progstep3", "Progression Step 3", 1, 8, 1, G::Progression),
+        makeInt(progStep(3), "progstep4", "Progression Step 4", 1, 8, 1, G::Progression),
+        makeInt(progStep(4), "progstep5", "Progression Step 5", 1, 8, 1, G::Progression),
+        makeInt(progStep(5), "progstep6", "Progression Step 6", 1, 8, 1, G::Progression),
+        makeInt(progStep(6), "progstep7", "Progression Step 7", 1, 8, 1, G::Progression),
+        makeInt(progStep(7), "progstep8", "Progression Step 8", 1, 8, 1, G::Progression),
+        makeInt(progStep(8), "progstep9", "Progression Step 9", 1, 8, 1, G::Progression),
+        makeInt(progStep(9), "progstep10", "Progression Step 10", 1, 8, 1, G::Progression),
+        makeInt(progStep(10), "progstep11", "Progression Step 11", 1, 8, 1, G::Progression),
+        makeInt(progStep(11), "progstep12", "Progression Step 12", 1, 8, 1, G::Progression),
+        makeInt(progStep(12), "progstep13", "Progression Step 13", 1, 8, 1, G::Progression),
+        makeInt(progStep(13), "progstep14", "Progression Step 14", 1, 8, 1, G::Progression),
+        makeInt(progStep(14), "progstep15", "Progression Step 15", 1, 8, 1, G::Progression),
+        makeInt(progStep(15), "progstep16", "Progression Step 16", 1, 8, 1, G::Progression),
+
+        // Global (120 BPM, master at 12 o'clock)
+        makeFloat(globalBpm, "globalbpm", "BPM", 60.0f, 200.0f, 1.0f, 120.0f, G::Global),
+        makeFloat(masterVolume, "mastervolume", "Master Volume", 0.0f, 1.0f, 0.01f, 0.5f, G::Global),
+
+        // Drum machine
+        makeBool(drumEnable, "drumenable", "Drum Enable", true, G::Drums),
+        makeInt(drumSteps, "drumsteps", "Drum Steps", 1, 256, 16, G::Drums),
+        makeFloat(drumKickVol, "drumkickvol", "Kick Volume", 0.0f, 1.0f, 0.01f, 0.8f, G::Drums),
+        makeFloat(drumSnareVol, "drumsnarevol", "Snare Volume", 0.0f, 1.0f, 0.01f, 0.8f, G::Drums),
+        makeFloat(drumClosedHatVol, "drumchatvol", "Closed Hat Volume", 0.0f, 1.0f, 0.01f, 0.8f, G::Drums),
+        makeFloat(drumOpenHatVol, "drumohatvol", "Open Hat Volume", 0.0f, 1.0f, 0.01f, 0.8f, G::Drums),
+        makeFloat(drumMasterVol, "drummastervol", "Drum Master Volume", 0.0f, 2.0f, 0.01f, 1.0f, G::Drums),
+        makeFloat(drumSidechainMag, "drumsidechainmag", "Sidechain Magnitude", 0.0f, 1.0f, 0.01f, 0.5f, G::Drums),
+        makeFloat(drumSidechainLen, "drumsidechainlen", "Sidechain Length", 0.0f, 1.0f, 0.01f, 0.5f, G::Drums),
+        makeFloat(drumSidechainAttack, "drumsidechainatk", "Sidechain Attack", 0.0f, 50.0f, 0.1f, 0.0f, G::Drums, 0.5f),
+        makeFloat(drumSidechainHold, "drumsidechainhold", "Sidechain Hold", 0.0f, 250.0f, 1.0f, 0.0f, G::Drums, 0.5f),
+
+        // Drum chain
+        makeBool(drumChainEnabled, "drumchainenabled", "Drum Chain Enabled", false, G::Drums),
+        makeInt(drumChainSteps, "drumchainsteps", "Drum Chain Steps", 1, 8, 4, G::Drums),
+        makeInt(drumChainStep(0), "drumchainstep1", "Drum Chain Step 1", 1, 8, 1, G::Drums),
+        makeInt(drumChainStep(1), "drumchainstep2", "Drum Chain Step 2", 1, 8, 2, G::Drums),
+        makeInt(drumChainStep(2), "drumchainstep3", "Drum Chain Step 3", 1, 8, 3, G::Drums),
+        makeInt(drumChainStep(3), "drumchainstep4", "Drum Chain Step 4", 1, 8, 4, G::Drums),
+        makeInt(drumChainStep(4), "drumchainstep5", "Drum Chain Step 5", 1, 8, 1, G::Drums),
+        makeInt(drumChainStep(5), "drumchainstep6", "Drum Chain Step 6", 1, 8, 1, G::Drums),
+        makeInt(drumChainStep(6), "drumchainstep7", "Drum Chain Step 7", 1, 8, 1, G::Drums),
+        makeInt(drumChainStep(7), "drumchainstep8", "Drum Chain Step 8", 1, 8, 1, G::Drums),
+
+        // Performance
+        makeBool(parallelRender, "parallelrender", "Parallel Voice Rendering", false, G::Performance),
+        makeBool(cpuGovernor, "cpugovernor", "CPU Governor", true, G::Performance),
+    };
+
+    constexpr const Spec& spec(Id index) { return kSpecs[index]; }
+
+    // Every row must sit at its own enum index
+    constexpr bool tableIsOrdered()
+    {
+        for (int i = 0; i < numParams; ++i)
+            if (kSpecs[i].index != i)
+                return false;
+        return true;
+    }
+
+    // FNV-1a of one parameter ID; stored with saved values so they can be matched after the table changes
+    constexpr uint32_t idHash(const char* id)
+    {
+        uint32_t hash = 2166136261u;
+        for (const char* c = id; *c != 0; ++c)
+            hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+        return hash;
+    }
+
+    // FNV-1a over the parameter IDs in table order, so reordering or renaming changes it
+    constexpr uint32_t schemaHash()
+    {
+        uint32_t hash = 2166136261u;
+        for (const auto& s : kSpecs)
+        {
+            for (const char* c = s.id; *c != 0; ++c)
+                hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+            hash = (hash ^ 0xffu) * 16777619u;
+        }
+        return hash;
+    }
+
+    static_assert(sizeof(kSpecs) / sizeof(kSpecs[0]) == numParams, "One table row per Param::Id");
+    static_assert(tableIsOrdered(), "Parameter table rows must follow Param::Id order");
+}
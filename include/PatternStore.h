@@ -0,0 +1,223 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//==============================================================================
+/**
+ * One complete version of the melody and drum pattern banks, and the melody song.
+ *
+ * Every pattern has room for maxSteps steps; melodyPages with the seqsteps
+ * parameter, and the drumsteps parameter, set how many of them play. The
+ * banks are fixed-size arrays, so
+ * a version is a single allocation made on the message thread and the audio
+ * thread only ever indexes into it.
+ */
+struct PatternData
+{
+    static constexpr int maxSteps = 256;
+    static constexpr int stepsPerPage = 16; // Steps the editors show at once
+    static constexpr int numScaleDegrees = 8;
+    static constexpr int numMelodyPatterns = 64;
+    static constexpr int numDrumPatterns = 64;
+    static constexpr int numDrumLanes = 4;
+    static constexpr int maxSongEntries = 32;
+    static constexpr int maxMelodyPages = maxSteps / stepsPerPage;
+    static constexpr int drumPatternsPerBank = 8; // Patterns a drum chain step picks from
+    static constexpr int numDrumBanks = numDrumPatterns / drumPatternsPerBank;
+
+    /** A melody pattern, one array per step attribute so a step reads only what it uses. */
+    struct MelodyPattern
+    {
+        static constexpr uint8_t alwaysPlays = 100;
+
+        MelodyPattern() { std::fill(std::begin(probability), std::end(probability), alwaysPlays); }
+
+        uint8_t noteMask[maxSteps] {};  // Bit N = scale degree N plays
+        uint32_t octaves[maxSteps] {};  // Per-note octave offset (-2 to +2), 3 bits per degree
+        uint8_t probability[maxSteps];  // Chance the step plays, in percent
+
+        int getOctave(int step, int degree) const
+        {
+            const auto bits = static_cast<int>((octaves[step] >> (degree * 3)) & 0x7u);
+            return bits >= 4 ? bits - 8 : bits; // 3-bit two's complement
+        }
+
+        void setOctave(int step, int degree, int octave)
+        {
+            const int shift = degree * 3;
+            const auto bits = static_cast<uint32_t>(juce::jlimit(-2, 2, octave)) & 0x7u;
+            octaves[step] = (octaves[step] & ~(0x7u << shift)) | (bits << shift);
+        }
+
+        bool isStepEmpty(int step) const
+        {
+            return noteMask[step] == 0 && octaves[step] == 0 && probability[step] == alwaysPlays;
+        }
+    };
+
+    /** A drum pattern: one trigger bit per lane and step. */
+    struct DrumPattern
+    {
+        static constexpr int stepsPerWord = 64;
+        static constexpr int numWords = maxSteps / stepsPerWord;
+
+        uint64_t triggers[numDrumLanes][numWords] {};
+
+        bool isOn(int lane, int step) const { return ((triggers[lane][step / stepsPerWord] >> (step % stepsPerWord)) & 1u) != 0; }
+
+        void set(int lane, int step, bool on)
+        {
+            const auto bit = uint64_t { 1 } << (step % stepsPerWord);
+            auto& word = triggers[lane][step / stepsPerWord];
+            word = on ? (word | bit) : (word & ~bit);
+        }
+
+        // Lanes triggering on step (bit N = lane N)
+        uint32_t lanesAt(int step) const
+        {
+            uint32_t lanes = 0;
+            for (int lane = 0; lane < numDrumLanes; ++lane)
+                lanes |= (isOn(lane, step) ? 1u : 0u) << lane;
+            return lanes;
+        }
+    };
+
+    /** The melody song: patterns played in order, each for a number of loops. The song repeats. */
+    struct MelodySong
+    {
+        static constexpr int maxRepeats = 16;
+
+        struct Entry
+        {
+            uint8_t pattern = 0; // Index into melody
+            uint8_t repeats = 1; // Loops of the pattern before the next entry
+        };
+
+        struct Position
+        {
+            int entry = 0;
+            int repeat = 0;
+        };
+
+        Entry entries[maxSongEntries] {};
+        int numEntries = 1;
+
+        int getNumEntries() const { return juce::jlimit(1, maxSongEntries, numEntries); }
+        int getRepeats(int entry) const { return juce::jlimit(1, maxRepeats, static_cast<int>(entries[entry].repeats)); }
+        int getPattern(int entry) const { return juce::jlimit(0, numMelodyPatterns - 1, static_cast<int>(entries[entry].pattern)); }
+
+        // Where the song is after position's loop
+        Position next(Position position) const
+        {
+            if (position.entry >= getNumEntries())
+                return {};
+            if (++position.repeat < getRepeats(position.entry))
+                return position;
+            return { (position.entry + 1) % getNumEntries(), 0 };
+        }
+
+        // Where the song is on a loop counted from its start
+        Position locate(long long loop) const
+        {
+            long long songLoops = 0;
+            for (int entry = 0; entry < getNumEntries(); ++entry)
+                songLoops += getRepeats(entry);
+
+            long long remaining = ((loop % songLoops) + songLoops) % songLoops;
+            for (int entry = 0; entry < getNumEntries(); ++entry)
+            {
+                if (remaining < getRepeats(entry))
+                    return { entry, static_cast<int>(remaining) };
+                remaining -= getRepeats(entry);
+            }
+            return {};
+        }
+    };
+
+    MelodyPattern melody[numMelodyPatterns];
+    DrumPattern drums[numDrumPatterns];
+    MelodySong song;
+
+    // Kept here rather than in the parameters, so seqsteps (1-16) and drumchainstepN
+    // (1-8) automation means what it did before the banks grew
+    int melodyPages = 1;   // The melody plays melodyPages - 1 full pages, then seqsteps steps
+    int drumChainBank = 0; // Drum chain steps pick patterns from this bank
+
+    int getMelodyLength(int lastPageSteps) const
+    {
+        return (juce::jlimit(1, maxMelodyPages, melodyPages) - 1) * stepsPerPage
+             + juce::jlimit(1, stepsPerPage, lastPageSteps);
+    }
+
+    int getDrumChainPattern(int chainStepValue) const
+    {
+        return juce::jlimit(0, numDrumBanks - 1, drumChainBank) * drumPatternsPerBank
+             + juce::jlimit(1, drumPatternsPerBank, chainStepValue) - 1;
+    }
+
+    uint32_t version = 0; // Set by PatternStore on publish; a freed version's address can be reused, its number can't
+};
+
+//==============================================================================
+/**
+ * Sequencer and drum patterns shared by the editor and the audio thread.
+ *
+ * Published versions are immutable. The message thread edits a private copy
+ * of the latest version and swaps it in with one atomic pointer store, so a
+ * multi-cell edit (a mutate, a randomize, a preset load) is seen either not
+ * at all or completely. The audio thread pins the version it's using for the
+ * block with a single hazard pointer and never blocks or frees; replaced
+ * versions are deleted on the message thread once they're no longer pinned,
+ * at the next publish or by a timer that runs while any are left.
+ *
+ * There is one writer (the message thread) and one real-time reader (the audio
+ * thread). Other threads, such as a host saving state in the background, copy
+ * the latest version with copyLatest(), which pins it with a second hazard.
+ */
+class PatternStore : private juce::Timer
+{
+public:
+    PatternStore();
+    ~PatternStore() override;
+
+    // Message thread: the latest version. Only the message thread replaces it, so it's stable there.
+    const PatternData& getCurrent() const { return *latest; }
+
+    // Message thread: copy the latest version, let editFn change the copy, then publish it
+    template <typename EditFn>
+    void edit(EditFn&& editFn)
+    {
+        auto next = std::make_unique<PatternData>(*latest);
+        editFn(*next);
+        publish(std::move(next));
+    }
+
+    // Audio thread: pin the latest version until release()
+    const PatternData* acquire();
+    void release() { hazard.store(nullptr); }
+
+    // Any thread but the audio thread: copy the latest version into destination
+    void copyLatest(PatternData& destination);
+
+private:
+    static const PatternData* pin(std::atomic<const PatternData*>& slot, const std::atomic<const PatternData*>& source);
+    void publish(std::unique_ptr<PatternData> next);
+    void reclaim();
+    void timerCallback() override;
+
+    static constexpr int kReclaimIntervalMs = 100; // Longer than any audio block holds a pin
+
+    std::unique_ptr<PatternData> latest;                   // Message thread
+    std::vector<std::unique_ptr<PatternData>> retired;     // Replaced, possibly still pinned
+    std::atomic<const PatternData*> current { nullptr };
+    std::atomic<const PatternData*> hazard { nullptr };    // Version the audio thread is reading
+    std::atomic<const PatternData*> copyHazard { nullptr }; // Version copyLatest() is reading
+    std::mutex copyLock;                                   // One copyLatest() at a time
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PatternStore)
+};
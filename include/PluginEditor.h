@@ -9,6 +9,7 @@
 #include "ModulationTab.h"
 #include "MelodySequencerTab.h"
 #include "ProgressionTab.h"
+#include "SongTab.h"
 #include "DrumTab.h"
 
 //==============================================================================
@@ -42,6 +43,7 @@ private:
     std::unique_ptr<ModulationTab> modulationTab;
     std::unique_ptr<MelodySequencerTab> melodySequencerTab;
     std::unique_ptr<ProgressionTab> progressionTab;
+    std::unique_ptr<SongTab> songTab;
     std::unique_ptr<DrumTab> drumTab;
 
     // Play/Stop button for standalone mode
@@ -63,6 +65,12 @@ private:
 
     // Message display label
     juce::Label messageLabel;
+    juce::uint32 messageClearTime = 0; // Millisecond counter at which to clear the message (0 = none)
+
+    // CPU load / quality step display (click for governor options and history)
+    juce::TextButton cpuButton;
+    void updateCpuButton();
+    void showCpuMenu();
 
     // Parameter attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> bpmAttachment;
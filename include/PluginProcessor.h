@@ -5,6 +5,25 @@
 #include <juce_data_structures/juce_data_structures.h>
 #include <juce_dsp/juce_dsp.h>
 #include "AcidVoice.h"
+#include "AcidSynthesiser.h"
+#include "CpuGovernor.h"
+#include "StereoDelay.h"
+#include "SidechainEnvelope.h"
+#include "DrumSampler.h"
+#include "DrumKitLoader.h"
+#include "SharedResourceCache.h"
+#include "PresetBankLoader.h"
+#include "PresetSnapshot.h"
+#include "PresetJournal.h"
+#include "PluginState.h"
+#include "PatternStore.h"
+#include "TransportClock.h"
+#include "SequencerEventList.h"
+#include "NoteSet.h"
+#include "ArpPattern.h"
+#include "RealtimeSanitizer.h"
+#include "ParameterSchema.h"
+#include <array>
 
 // Forward declaration
 class SnorkelSynthAudioProcessorEditor;
@@ -13,7 +32,7 @@ class SnorkelSynthAudioProcessorEditor;
 /**
  * Main audio processor for Snorkel Synth VST plugin
  */
-class SnorkelSynthAudioProcessor : public juce::AudioProcessor
+class SnorkelSynthAudioProcessor : public juce::AudioProcessor, private PresetJournal::Listener
 {
 public:
     //==============================================================================
@@ -57,18 +76,20 @@ public:
 
     //==============================================================================
     // JSON Preset Management
-    void loadPresetsFromJSON();
+    void loadPresetsFromJSON(); // Reloads the banks in the background; see presetBanksChanged
     void saveSynthPresetToJSON(const juce::String& presetName);
     void saveSequencerPresetToJSON(const juce::String& presetName);
     juce::StringArray getSynthPresetNames() const;
     juce::StringArray getSequencerPresetNames() const;
 
     // Public access to JSON data for UI components
-    juce::var synthPresetsJSON;  // Combined system + user presets for UI
+    std::shared_ptr<const CompiledPresetBank> synthPresetBank; // System + user synth presets, memory-mapped
     juce::var sequencerPresetsJSON;
     juce::var randomizationConfigJSON;
     int numSystemSynthPresets = 0;  // Track count of system presets for divider
     int numSystemSequencerPresets = 0;  // Track count of system sequencer presets for divider
+    bool presetBanksLoaded = false;
+    juce::ChangeBroadcaster presetBanksChanged; // Sent on the message thread after the banks (re)load
 
     //==============================================================================
     // Playback control (starts/stops arp and sequencer)
@@ -81,200 +102,46 @@ public:
     void setEditor(SnorkelSynthAudioProcessorEditor* editor) { currentEditor = editor; }
     void showEditorMessage(const juce::String& message);
 
+    //==============================================================================
+    // CPU governor (quality step, load and change history for the editor)
+    const CpuGovernor& getCpuGovernor() const { return cpuGovernor; }
+
 private:
     //==============================================================================
-    juce::Synthesiser synth;
+    AcidSynthesiser synth;
     juce::AudioProcessorValueTreeState parameters;
     SnorkelSynthAudioProcessorEditor* currentEditor = nullptr;
 
-    // Main Parameter IDs
-    static constexpr const char* CUTOFF_ID = "cutoff";
-    static constexpr const char* RESONANCE_ID = "resonance";
-    static constexpr const char* ENV_MOD_ID = "envmod";
-    static constexpr const char* ACCENT_ID = "accent";
-
-    // Three parallel oscillators
-    static constexpr const char* OSC1_WAVE_ID = "osc1wave";
-    static constexpr const char* OSC1_COARSE_ID = "osc1coarse";
-    static constexpr const char* OSC1_FINE_ID = "osc1fine";
-    static constexpr const char* OSC1_MIX_ID = "osc1mix";
-
-    static constexpr const char* OSC2_WAVE_ID = "osc2wave";
-    static constexpr const char* OSC2_COARSE_ID = "osc2coarse";
-    static constexpr const char* OSC2_FINE_ID = "osc2fine";
-    static constexpr const char* OSC2_MIX_ID = "osc2mix";
-
-    static constexpr const char* OSC3_WAVE_ID = "osc3wave";
-    static constexpr const char* OSC3_COARSE_ID = "osc3coarse";
-    static constexpr const char* OSC3_FINE_ID = "osc3fine";
-    static constexpr const char* OSC3_MIX_ID = "osc3mix";
-
-    static constexpr const char* NOISE_TYPE_ID = "noisetype";
-    static constexpr const char* NOISE_DECAY_ID = "noisedecay";
-    static constexpr const char* NOISE_MIX_ID = "noisemix";
-
-    static constexpr const char* DRIVE_ID = "drive";
-    static constexpr const char* VOLUME_ID = "volume";
-    static constexpr const char* GLOBAL_OCTAVE_ID = "globaloctave";
-
-    // Analog character parameters
-    static constexpr const char* DRIFT_ID = "drift";
-    static constexpr const char* PHASE_RANDOM_ID = "phaserandom";
-    static constexpr const char* UNISON_ID = "unison";
-
-    static constexpr const char* DELAY_TIME_ID = "delaytime";
-    static constexpr const char* DELAY_FEEDBACK_ID = "delayfeedback";
-    static constexpr const char* DELAY_MIX_ID = "delaymix";
-
-    // Filter & Saturation Enhancement Parameters
-    static constexpr const char* FILTER_FEEDBACK_ID = "filterfeedback";
-    static constexpr const char* SATURATION_TYPE_ID = "saturationtype";
-
-    // Filter ADSR Parameters
-    static constexpr const char* FILTER_ATTACK_ID = "filterattack";
-    static constexpr const char* FILTER_DECAY_ID = "filterdecay";
-    static constexpr const char* FILTER_SUSTAIN_ID = "filtersustain";
-    static constexpr const char* FILTER_RELEASE_ID = "filterrelease";
-
-    // Amplitude ADSR Parameters
-    static constexpr const char* AMP_ATTACK_ID = "ampattack";
-    static constexpr const char* AMP_DECAY_ID = "ampdecay";
-    static constexpr const char* AMP_SUSTAIN_ID = "ampsustain";
-    static constexpr const char* AMP_RELEASE_ID = "amprelease";
-
-    // Dedicated LFO Parameter IDs (Rate, Waveform, Depth for each parameter)
-    static constexpr const char* CUTOFF_LFO_RATE_ID = "cutofflfor";
-    static constexpr const char* CUTOFF_LFO_WAVE_ID = "cutofflfow";
-    static constexpr const char* CUTOFF_LFO_DEPTH_ID = "cutofflfod";
-
-    static constexpr const char* RESONANCE_LFO_RATE_ID = "resonancelforate";
-    static constexpr const char* RESONANCE_LFO_WAVE_ID = "resonancelfowave";
-    static constexpr const char* RESONANCE_LFO_DEPTH_ID = "resonancelfodepth";
-
-    static constexpr const char* ENVMOD_LFO_RATE_ID = "envmodlforate";
-    static constexpr const char* ENVMOD_LFO_WAVE_ID = "envmodlfowave";
-    static constexpr const char* ENVMOD_LFO_DEPTH_ID = "envmodlfodepth";
-
-    static constexpr const char* DECAY_LFO_RATE_ID = "decaylforate";
-    static constexpr const char* DECAY_LFO_WAVE_ID = "decaylfowave";
-    static constexpr const char* DECAY_LFO_DEPTH_ID = "decaylfodepth";
-
-    static constexpr const char* ACCENT_LFO_RATE_ID = "accentlforate";
-    static constexpr const char* ACCENT_LFO_WAVE_ID = "accentlfowave";
-    static constexpr const char* ACCENT_LFO_DEPTH_ID = "accentlfodepth";
-
-    static constexpr const char* WAVEFORM_LFO_RATE_ID = "waveformlforate";
-    static constexpr const char* WAVEFORM_LFO_WAVE_ID = "waveformlfowave";
-    static constexpr const char* WAVEFORM_LFO_DEPTH_ID = "waveformlfodepth";
-
-    static constexpr const char* SUBOSC_LFO_RATE_ID = "subosclforate";
-    static constexpr const char* SUBOSC_LFO_WAVE_ID = "subosclfowave";
-    static constexpr const char* SUBOSC_LFO_DEPTH_ID = "subosclfodepth";
-
-    static constexpr const char* DRIVE_LFO_RATE_ID = "drivelforate";
-    static constexpr const char* DRIVE_LFO_WAVE_ID = "drivelfowave";
-    static constexpr const char* DRIVE_LFO_DEPTH_ID = "drivelfodepth";
-
-    static constexpr const char* VOLUME_LFO_RATE_ID = "volumelforate";
-    static constexpr const char* VOLUME_LFO_WAVE_ID = "volumelfowave";
-    static constexpr const char* VOLUME_LFO_DEPTH_ID = "volumelfodepth";
-
-    static constexpr const char* DELAYMIX_LFO_RATE_ID = "delaymixlforate";
-    static constexpr const char* DELAYMIX_LFO_WAVE_ID = "delaymixlfowave";
-    static constexpr const char* DELAYMIX_LFO_DEPTH_ID = "delaymixlfodepth";
-
-    // Arpeggiator Parameter IDs
-    static constexpr const char* ARP_ONOFF_ID = "arponoff";
-    static constexpr const char* ARP_MODE_ID = "arpmode";
-    static constexpr const char* ARP_RATE_ID = "arprate";
-    static constexpr const char* ARP_OCTAVES_ID = "arpoctaves";
-    static constexpr const char* ARP_GATE_ID = "arpgate";
-    static constexpr const char* ARP_OCTAVE_SHIFT_ID = "arpoctaveshift";
-    static constexpr const char* ARP_SWING_ID = "arpswing";
-
-    // Sequencer Parameter IDs
-    static constexpr const char* SEQ_ENABLED_ID = "seqenabled";
-    static constexpr const char* SEQ_ROOT_ID = "seqroot";
-    static constexpr const char* SEQ_SCALE_ID = "seqscale";
-    static constexpr const char* SEQ_STEPS_ID = "seqsteps";
-    static constexpr const char* SEQ_RATE_ID = "seqrate";
-    static constexpr const char* SEQ_GATE_ID = "seqgate";
-
-    // Sequencer per-step octave (16 steps)
-    static constexpr const char* SEQ_OCTAVE1_ID = "seqoctave1";
-    static constexpr const char* SEQ_OCTAVE2_ID = "seqoctave2";
-    static constexpr const char* SEQ_OCTAVE3_ID = "seqoctave3";
-    static constexpr const char* SEQ_OCTAVE4_ID = "seqoctave4";
-    static constexpr const char* SEQ_OCTAVE5_ID = "seqoctave5";
-    static constexpr const char* SEQ_OCTAVE6_ID = "seqoctave6";
-    static constexpr const char* SEQ_OCTAVE7_ID = "seqoctave7";
-    static constexpr const char* SEQ_OCTAVE8_ID = "seqoctave8";
-    static constexpr const char* SEQ_OCTAVE9_ID = "seqoctave9";
-    static constexpr const char* SEQ_OCTAVE10_ID = "seqoctave10";
-    static constexpr const char* SEQ_OCTAVE11_ID = "seqoctave11";
-    static constexpr const char* SEQ_OCTAVE12_ID = "seqoctave12";
-    static constexpr const char* SEQ_OCTAVE13_ID = "seqoctave13";
-    static constexpr const char* SEQ_OCTAVE14_ID = "seqoctave14";
-    static constexpr const char* SEQ_OCTAVE15_ID = "seqoctave15";
-    static constexpr const char* SEQ_OCTAVE16_ID = "seqoctave16";
-
-    // Sequencer per-step cutoff modulation (16 steps)
-    static constexpr const char* SEQ_CUTOFF1_ID = "seqcutoff1";
-    static constexpr const char* SEQ_CUTOFF2_ID = "seqcutoff2";
-    static constexpr const char* SEQ_CUTOFF3_ID = "seqcutoff3";
-    static constexpr const char* SEQ_CUTOFF4_ID = "seqcutoff4";
-    static constexpr const char* SEQ_CUTOFF5_ID = "seqcutoff5";
-    static constexpr const char* SEQ_CUTOFF6_ID = "seqcutoff6";
-    static constexpr const char* SEQ_CUTOFF7_ID = "seqcutoff7";
-    static constexpr const char* SEQ_CUTOFF8_ID = "seqcutoff8";
-    static constexpr const char* SEQ_CUTOFF9_ID = "seqcutoff9";
-    static constexpr const char* SEQ_CUTOFF10_ID = "seqcutoff10";
-    static constexpr const char* SEQ_CUTOFF11_ID = "seqcutoff11";
-    static constexpr const char* SEQ_CUTOFF12_ID = "seqcutoff12";
-    static constexpr const char* SEQ_CUTOFF13_ID = "seqcutoff13";
-    static constexpr const char* SEQ_CUTOFF14_ID = "seqcutoff14";
-    static constexpr const char* SEQ_CUTOFF15_ID = "seqcutoff15";
-    static constexpr const char* SEQ_CUTOFF16_ID = "seqcutoff16";
-
-    // Sequencer accent control amounts
-    static constexpr const char* SEQ_ACCENT_VOL_ID = "seqaccentvol";
-    static constexpr const char* SEQ_ACCENT_CUTOFF_ID = "seqaccentcutoff";
-    static constexpr const char* SEQ_ACCENT_RES_ID = "seqaccentres";
-    static constexpr const char* SEQ_ACCENT_DECAY_ID = "seqaccentdecay";
-    static constexpr const char* SEQ_ACCENT_DRIVE_ID = "seqaccentdrive";
-
-    // Progression Parameter IDs
-    static constexpr const char* PROG_ENABLED_ID = "progenabled";
-    static constexpr const char* PROG_STEPS_ID = "progsteps";
-    static constexpr const char* PROG_LENGTH_ID = "proglength";
-    static constexpr const char* PROG_STEP1_ID = "progstep1";
-    static constexpr const char* PROG_STEP2_ID = "progstep2";
-    static constexpr const char* PROG_STEP3_ID = "progstep3";
-    static constexpr const char* PROG_STEP4_ID = "progstep4";
-    static constexpr const char* PROG_STEP5_ID = "progstep5";
-    static constexpr const char* PROG_STEP6_ID = "progstep6";
-    static constexpr const char* PROG_STEP7_ID = "progstep7";
-    static constexpr const char* PROG_STEP8_ID = "progstep8";
-    static constexpr const char* PROG_STEP9_ID = "progstep9";
-    static constexpr const char* PROG_STEP10_ID = "progstep10";
-    static constexpr const char* PROG_STEP11_ID = "progstep11";
-    static constexpr const char* PROG_STEP12_ID = "progstep12";
-    static constexpr const char* PROG_STEP13_ID = "progstep13";
-    static constexpr const char* PROG_STEP14_ID = "progstep14";
-    static constexpr const char* PROG_STEP15_ID = "progstep15";
-    static constexpr const char* PROG_STEP16_ID = "progstep16";
-
-    // Global Parameters
-    static constexpr const char* GLOBAL_BPM_ID = "globalbpm";
-    static constexpr const char* MASTER_VOLUME_ID = "mastervolume";
+    // Parameter layout built from the Param::kSpecs table
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+    // Indexed parameter access, resolved once in the constructor so the audio
+    // thread never looks parameters up by string
+    std::array<std::atomic<float>*, Param::numParams> paramValues {};
+    std::array<juce::RangedAudioParameter*, Param::numParams> paramObjects {};
+    void setParamNotifyingHost(Param::Id id, float plainValue);
+
+    // While a preset switch is in flight the audio thread reads the published
+    // snapshot instead of the host parameters, which are still being updated
+    float param(Param::Id id) const
+    {
+        const auto i = static_cast<size_t>(id);
+        return presetOverrideActive.load(std::memory_order_relaxed) ? presetOverride[i].load(std::memory_order_relaxed)
+                                                                    : paramValues[i]->load();
+    }
 
 public:
     // Sequencer state (public for UI access)
-    static constexpr int NUM_SEQ_STEPS = 16;
+    static constexpr int MAX_SEQ_STEPS = 256;
+    static constexpr int NUM_SEQ_ACCENTS = 16; // seqcutoff1-16, repeating every 16 steps
     static constexpr int NUM_SCALE_DEGREES = 8;
-    uint8_t sequencerPattern[NUM_SEQ_STEPS]; // Bitmask: bit N = degree N is active (0 = no notes)
-    int8_t sequencerOctave[NUM_SEQ_STEPS][NUM_SCALE_DEGREES]; // Per-note octave offset (-2 to +2)
+    static constexpr int NUM_MELODY_PATTERNS = 64;
+    PatternStore patternStore; // Sequencer and drum patterns; edit on the message thread with patternStore.edit()
+    std::atomic<int> currentMelodyPatternIndex { 0 };
+    std::atomic<int> pendingMelodyPatternIndex { -1 }; // -1 = no pending change
     int currentSeqStep = 0;
+    void selectMelodyPattern(int index); // Queue pattern change for the pattern's next loop
+    int currentSongEntry = 0; // Song entry playing while song mode is on
     float getCurrentSeqCutoffMod() const; // Get cutoff modulation for current sequencer step
 
     // Progression state (public for UI access)
@@ -282,38 +149,97 @@ public:
     int currentProgressionStep = 0;
 
     // Drum machine state (public for UI access)
-    static constexpr int NUM_DRUM_STEPS = 16;
+    static constexpr int MAX_DRUM_STEPS = 256;
     static constexpr int NUM_DRUM_LANES = 4; // Kick, Snare, CHat, OHat
-    static constexpr int NUM_DRUM_PATTERNS = 8;
-    int drumPatterns[NUM_DRUM_PATTERNS][NUM_DRUM_LANES][NUM_DRUM_STEPS] = {{{0}}}; // 8 patterns
-    int currentDrumPatternIndex = 0;
-    int pendingDrumPatternIndex = -1; // -1 = no pending change
+    static constexpr int NUM_DRUM_PATTERNS = 64;
+    std::atomic<int> currentDrumPatternIndex { 0 };
+    std::atomic<int> pendingDrumPatternIndex { -1 }; // -1 = no pending change
     int currentDrumStep = 0;
     void selectDrumPattern(int index); // Queue pattern change for next bar
 
     // Drum chain state (public for UI)
     int currentDrumChainStep = 0;
-    float sidechainEnvelope = 0.0f; // Current sidechain ducking amount (0-1)
-    float getSidechainEnvelope() const { return sidechainEnvelope; }
+    float getSidechainEnvelope() const { return sidechainEnvelope.getLevel(); } // Current ducking amount (0-1)
 
     // Drum sample storage and playback
-    juce::AudioBuffer<float> drumSamples[NUM_DRUM_LANES];
-    int drumSamplePositions[NUM_DRUM_LANES] = {0}; // Playback position for each lane
-    bool drumSamplePlaying[NUM_DRUM_LANES] = {false};
-    void loadDrumSamples();
+    DrumSampler drumSampler; // Lanes map to DrumSampler::Lane
+    static_assert(NUM_DRUM_LANES == DrumSampler::numLanes, "Drum lanes and sampler lanes must match");
+    static_assert(MAX_SEQ_STEPS == PatternData::maxSteps && NUM_SCALE_DEGREES == PatternData::numScaleDegrees
+                      && NUM_MELODY_PATTERNS == PatternData::numMelodyPatterns
+                      && NUM_DRUM_PATTERNS == PatternData::numDrumPatterns && NUM_DRUM_LANES == PatternData::numDrumLanes
+                      && MAX_DRUM_STEPS == PatternData::maxSteps,
+                  "Pattern store layout must match the processor's");
+    static_assert(NUM_SEQ_ACCENTS == SequencerEventList::numAccents, "Accent parameters and event list must match");
+    std::unique_ptr<DrumKitLoader> drumKitLoader; // Loads kits in the background; declared after drumSampler
+
+    // Drum kits (message thread)
+    juce::StringArray getDrumKitNames() const { return drumKitLoader->getKitNames(); }
+    int getSelectedDrumKit() const { return drumKitLoader->getSelectedKit(); }
+    void selectDrumKit(int index) { drumKitLoader->selectKit(index); }
 
 private:
-    // Parameter update
+    // Parameter update (pushes a VoiceParams snapshot, only the groups that changed)
     void updateVoiceParameters();
+    VoiceParams lastVoiceParams {};
+    bool voiceParamsValid = false;
+
+    // CPU governor
+    CpuGovernor cpuGovernor;
+    int appliedQualityStep = CpuGovernor::fullQuality;
+    void applyQualityStep(int step);
+
+    // Preset banks, configs and drum samples shared by every instance in the process
+    juce::SharedResourcePointer<SharedResourceCache> sharedResources;
 
     // Preset management
-    void loadPresetFromJSON(int presetIndex);
+    std::unique_ptr<PresetBankLoader> presetBankLoader;
+    juce::SharedResourcePointer<PresetJournal> presetJournal; // Writes saved user presets in the background, one writer per process
+    bool initialPresetPending = true; // Load the first preset when the banks arrive, unless a program was chosen
+
+    // Saved user presets the loaded banks don't contain yet. They're listed after
+    // the bank's presets until a reload that follows their compaction arrives.
+    struct PendingPreset
+    {
+        PresetJournal::Bank bank = PresetJournal::Bank::synth;
+        juce::var preset;
+        PresetSnapshot::Values values {}; // Synth presets: the compiled row (NaN = not stored)
+        int journalSequence = 0;
+        uint32_t reloadGeneration = 0;    // Bank load that includes it; 0 until compacted
+    };
+    std::vector<PendingPreset> pendingPresets;
+    void presetsCompacted(int lastSequence) override; // Any instance's saves; reloads the banks
+    const PendingPreset* getPendingSynthPreset(int index) const;
+
+    // Host program list: synth preset names plus the user divider, rebuilt only when the bank changes
+    juce::CriticalSection programLock;
+    juce::StringArray programNames;
+    int currentProgram = 0;
+    void rebuildProgramList();
+    void applyPresetBanks(PresetBankLoader::Banks& banks);
+    void loadPresetFromJSON(int presetIndex, bool crossfade = true);
+    void applyParameterValues(const float* values, bool crossfade, bool asGesture = true); // Plain values by Param::Id, NaN = leave alone
+
+    // Batched preset apply: the message thread publishes the whole target vector,
+    // the audio thread switches to it between two short gain ramps
+    PresetSnapshot presetSnapshot;
+    PresetSnapshot::Values outgoingPreset {};      // Audio thread: values held while fading out
+    PresetSnapshot::Values incomingPreset {};      // Audio thread: values switched to at the fade's midpoint
+    std::array<std::atomic<float>, Param::numParams> presetOverride {};
+    std::atomic<bool> presetOverrideActive { false };
+    uint32_t presetSnapshotSeen = 0;               // Audio thread: last sequence read
+    enum class PresetFade { idle, fadingOut, switchPending, fadingIn, holding };
+    PresetFade presetFade = PresetFade::idle;
+    int presetFadeSamples = 256;                   // Length of each gain ramp, set from the sample rate
+    int presetFadePosition = 0;                    // Samples of the current ramp done so far
+    void setPresetOverride(const PresetSnapshot::Values& values);
+    void beginPresetSwitchSubBlock();
+    void endPresetSwitchSubBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
     juce::File getDataDirectory() const;
     juce::String formatJSON(const juce::var& json, int indentLevel = 0) const;
 
     // Delay effect
-    juce::dsp::DelayLine<float> delayLine { 192000 }; // Max 4 seconds at 48kHz
-    std::vector<float> delayBuffer;
+    StereoDelay stereoDelay;
+    std::vector<float> delayMixCurve; // Per-sample wet amount, shared by both channels
     double currentSampleRate = 44100.0;
     double currentBPM = 120.0;
 
@@ -325,59 +251,94 @@ private:
         int waveform = 0; // 0=Sine
         float depth = 0.0f;
         float lastRandomValue = 0.0f;
+        float segmentStart = 0.0f;  // Mix curve ramp being played out
+        float segmentEnd = 0.0f;
+        int segmentPosition = -1;   // Samples into the ramp; -1 = start a new one
     };
     DelayMixLFO delayMixLFO;
+    juce::Random delayMixRandom;
+    static constexpr int kDelayMixLFOInterval = 32; // Samples between LFO evaluations in the mix curve
 
     // Arpeggiator state
-    std::vector<int> heldNotes; // Currently held MIDI notes
-    int currentArpNote = 0;      // Index into heldNotes
-    double arpStepTime = 0.0;    // Time since last arp step (in samples)
-    double lastNoteOffTime = 0.0; // Time for note-off based on gate length
+    ArpPattern::HeldNotes heldNotes; // Currently held MIDI notes, in played order
+    ArpPattern arpPattern;       // Compiled note cycle and position
+    StepCursor arpCursor;        // Beat of the next arp step
+    double arpNoteOffBeat = 0.0; // Beat of the gate-off for the sounding note
     int lastPlayedNote = -1;     // Last arpeggio note that was triggered
     bool isNoteCurrentlyOn = false; // Track if we're in note-on phase
     int arpStepCounter = 0;      // Counter for swing (even/odd steps)
     int lastProgressionStepForArp = -1; // Track progression step to detect changes
 
+    // Patterns pinned for the current block (audio thread)
+    const PatternData* activePatterns = nullptr;
+
+    // Sub-block processing
+    int preparedBlockSize = 0;           // Largest block the work buffers hold; bigger host blocks are split
+    void renderBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages); // At most preparedBlockSize samples
+    juce::MidiBuffer subBlockMidi;       // Incoming + generated MIDI for the current sub-block
+    juce::MidiBuffer chunkMidi;          // Incoming MIDI of one piece of an oversized host block
+    juce::MidiBuffer arpMidi;            // Arpeggiator output, swapped into subBlockMidi
+    juce::MidiBuffer seqMidi;            // Sequencer output, appended to subBlockMidi
+    static constexpr int kMidiBufferBytes = 2048; // Reserved for each of the above in prepareToPlay
+    juce::AudioBuffer<float> drumBuffer; // Dry drum bus, added after the delay
+    SidechainEnvelope sidechainEnvelope;  // Kick ducking, triggered from processDrums
+    std::vector<float> sidechainGain;     // Per-sample ducking gain for the current block
+    int getSamplesUntilNextStepEvent(int maxSamples) const; // Shortens a sub-block to end at the next step/gate event
+
     // Playback state - controls whether arp/sequencer are active
     bool isPlaybackActive = false;
-    double totalPlaybackTime = 0.0; // Track total time for bar synchronization
+    TransportClock transportClock; // Beat position shared by every step engine
+    bool hostWasPlaying = false;
+    bool hostTimelineLocked = false;  // Clock follows the host's ppq position
+    static constexpr double kMaxHostDriftBeats = 1.0 / 16.0; // Larger differences are jumps (loops, seeks)
+    void followHostTimeline(bool hostPlaying, juce::Optional<double> hostPpq);
+    void chaseHostPosition(double beat); // Picks every engine up mid-pattern at beat
 
     // Arpeggiator helper functions
-    void processArpeggiator(juce::MidiBuffer& midiMessages, int numSamples);
-    double getArpStepLengthInSamples() const;
+    void processArpeggiator(juce::MidiBuffer& midiMessages, int startSample, int numSamples);
+    double getArpStepBeats() const;
     int getNextArpNote();
 
     // Sequencer state (private timing/control variables)
-    double seqStepTime = 0.0;
-    double lastSeqNoteOffTime = 0.0;
-    int lastSeqPlayedNote = -1;
+    StepCursor seqCursor;
+    double seqNoteOffBeat = 0.0;
     bool isSeqNoteCurrentlyOn = false;
     float seqAccentDecayMod = 0.0f; // Current accent decay modulation
 
     // Sequencer helper functions
-    void processSequencer(juce::MidiBuffer& midiMessages, int numSamples);
-    double getSeqStepLengthInSamples() const;
-    std::vector<int> getSequencerNotes(int step); // Returns all active MIDI notes for a step
-    int scaleDegreesToMidiNote(int scaleDegree, int rootNote, int scaleType);
-    std::vector<int> lastSeqPlayedNotes; // Track multiple notes for note-off
+    void processSequencer(juce::MidiBuffer& midiMessages, int startSample, int numSamples);
+    double getSeqStepBeats() const; // Also the drum step length
+    int getSeqStepCount() const; // The pinned patterns' melody pages, the last one seqsteps long
+    SequencerEventList seqEvents; // The current pattern's notes (audio thread)
+    SequencerEventList::Inputs getSequencerInputs() const;
+    juce::Random seqGenerator; // Step probability (audio thread)
+    NoteSet<SequencerEventList::numScaleDegrees> lastSeqPlayedNotes; // Track multiple notes for note-off
+
+    // Melody song: which entry, and which repeat of it, the sequencer is on
+    int currentSongRepeat = 0;
+    bool songStarted = false; // The first loop plays entry 1 rather than advancing past it
+    void setSongPosition(PatternData::MelodySong::Position position);
+    void advanceSong(); // At the current pattern's loop point
 
     // Progression state and helpers
-    double progressionBarTime = 0.0;
-    bool progressionWasEnabled = false;
-    bool progressionSyncedToBar = false;
-    void updateProgressionStep(int numSamples);
+    StepCursor progressionCursor;
+    bool progressionSyncedToBar = false; // Step 0 has started on a bar line
+    void updateProgressionStep();
     int getCurrentProgressionOffset() const;
 
     // Drum machine state and helpers
-    double drumStepTime = 0.0;
-    double drumChainBarTime = 0.0;
-    void processDrums(int numSamples);
+    StepCursor drumCursor;
+    void processDrums();
+    void renderDrumSamples(int startSample, int numSamples); // Mixes playing lanes into drumBuffer
     void updateDrumChain(int numSamples);
+    int getDrumChainPattern(int chainStep) const; // From the pinned patterns' chain bank
 
     // Delay Mix LFO helper functions
     void updateDelayMixLFO();
-    double getDelayMixLFOValue();
-    void advanceDelayMixLFO();
+    double getDelayMixLFOValue() const;
+    void advanceDelayMixLFO(int numSamples);
+    void fillDelayMixCurve(float baseMix, int startSample, int numSamples);
+    void renderDelay(juce::AudioBuffer<float>& buffer, int startSample, int numSamples); // Tempo-synced delay on one sub-block
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SnorkelSynthAudioProcessor)
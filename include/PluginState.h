@@ -0,0 +1,74 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "ParameterSchema.h"
+#include "PatternStore.h"
+#include <array>
+
+//==============================================================================
+/**
+ * Binary plugin state: parameters plus the sequencer and drum patterns.
+ *
+ * Layout (little-endian): magic, format version, schema hash, then tagged
+ * chunks of { tag, byte size, payload }. Readers skip chunks they don't know,
+ * so later versions can add chunks without breaking older ones.
+ *
+ *  PARM  one float (plain value) per parameter, by Param::Id
+ *  PKEY  Param::idHash of each PARM entry; only read when the schema hash
+ *        differs, to move values to their parameter's new index
+ *  MELO  current pattern, then per pattern: its used step count, then that
+ *        many step bitmasks, packed per-note octaves (3 bytes per step) and
+ *        probabilities
+ *  DRUM  current pattern, then per pattern: its used step count, then one
+ *        bit per step for each lane
+ *  SONG  melody song entry count, then { pattern, repeats } per entry
+ *  SEQX  melody pages, then the drum chain bank: the parts of the step
+ *        count and chain that don't fit the seqsteps and drumchainstepN ranges
+ *
+ * Patterns store only up to their last non-empty step.
+ */
+class PluginState
+{
+public:
+    static constexpr int maxSteps = PatternData::maxSteps;
+    static constexpr int numScaleDegrees = PatternData::numScaleDegrees;
+    static constexpr int numMelodyPatterns = PatternData::numMelodyPatterns;
+    static constexpr int numDrumPatterns = PatternData::numDrumPatterns;
+    static constexpr int numDrumLanes = PatternData::numDrumLanes;
+
+    struct Patterns : PatternData
+    {
+        int currentMelodyPattern = 0;
+        int currentDrumPattern = 0;
+    };
+
+    // Values are plain parameter values by Param::Id
+    static void write(juce::MemoryBlock& dest, const std::array<float, Param::numParams>& values, const Patterns& patterns);
+
+    /** Returns false if data isn't in this format (e.g. an older XML state).
+        Parameters the state doesn't hold are set to NaN; patterns are only
+        touched when their chunk is present, and hasPatterns reports whether it was. */
+    static bool read(const void* data, size_t size, std::array<float, Param::numParams>& values,
+                     Patterns& patterns, bool& hasPatterns);
+
+    static bool isBinaryState(const void* data, size_t size);
+
+private:
+    static constexpr uint32_t kMagic = 0x54534e53; // "SNST"
+    static constexpr uint32_t kVersion = 1;
+
+    static constexpr uint32_t tag(const char (&name)[5])
+    {
+        return static_cast<uint32_t>(static_cast<uint8_t>(name[0]))
+             | static_cast<uint32_t>(static_cast<uint8_t>(name[1])) << 8
+             | static_cast<uint32_t>(static_cast<uint8_t>(name[2])) << 16
+             | static_cast<uint32_t>(static_cast<uint8_t>(name[3])) << 24;
+    }
+
+    static void readParameters(juce::MemoryInputStream& params, juce::MemoryInputStream* keys, bool sameSchema,
+                               std::array<float, Param::numParams>& values);
+    static void readMelody(juce::MemoryInputStream& in, Patterns& patterns);
+    static void readDrums(juce::MemoryInputStream& in, Patterns& patterns);
+    static void readSong(juce::MemoryInputStream& in, Patterns& patterns);
+    static void readExtents(juce::MemoryInputStream& in, Patterns& patterns);
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include "SharedResourceCache.h"
+#include "CompiledPresetBank.h"
+#include <atomic>
+#include <functional>
+
+//==============================================================================
+/**
+ * Reads the synth and sequencer preset banks and the randomization config on a
+ * background thread, so creating a plugin instance never waits on disk.
+ *
+ * When a load finishes, onLoaded is called on the message thread with the
+ * combined (system + user) banks. Nothing is written to disk.
+ */
+class PresetBankLoader : private juce::Thread, private juce::AsyncUpdater
+{
+public:
+    struct Banks
+    {
+        std::shared_ptr<const CompiledPresetBank> synthPresets; // System presets, then user presets
+        juce::var sequencerPresets;   // { "presets": [system..., user...] }
+        juce::var randomizationConfig;
+        int numSystemSynthPresets = 0;
+        int numSystemSequencerPresets = 0;
+        uint32_t generation = 0;      // Covers every load() request up to this one
+    };
+
+    explicit PresetBankLoader(const juce::File& dataDirectory);
+    ~PresetBankLoader() override;
+
+    // Called on the message thread with each finished load
+    std::function<void(Banks&)> onLoaded;
+
+    // Starts a background (re)load; a load already running is followed by another one.
+    // Returns the request's generation: a Banks with generation >= it reflects the files as of this call.
+    uint32_t load();
+
+    // Maps (recompiling if stale) the synth preset bank next to its JSON files
+    static std::shared_ptr<const CompiledPresetBank> openSynthBank(const juce::File& dataDirectory, SharedResourceCache& cache);
+
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    Banks readBanks();
+    juce::var readCombined(const juce::File& systemFile, const juce::File& userFile, int& numSystemPresets);
+
+    const juce::File dataDirectory;
+    juce::SharedResourcePointer<SharedResourceCache> sharedResources;
+
+    juce::WaitableEvent loadRequested;
+    std::atomic<uint32_t> requestedGeneration { 0 };
+    juce::CriticalSection resultLock;
+    std::unique_ptr<Banks> result; // Finished load waiting for the message thread
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBankLoader)
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include <atomic>
+
+//==============================================================================
+/**
+ * Saves user presets in the background without rewriting the user banks on
+ * every save.
+ *
+ * append() only queues the preset, so the calling thread doesn't wait on disk
+ * and the cost doesn't grow with the size of the library. The writer thread
+ * appends each preset as one line to user_presets.journal. Once saves have
+ * been quiet for kCompactDelayMs (and when the journal is destroyed), it folds
+ * the journal into synth_presets_user.json and sequencer_presets_user.json. Both
+ * banks are written to temporary files before either is renamed over the old
+ * one, and then the journal is deleted; if only the synth bank gets renamed, the
+ * journal keeps just the sequencer records. A journal left behind by a crash is compacted when
+ * the writer starts; a truncated last line is ignored.
+ *
+ * There is one journal per process (hold it through juce::SharedResourcePointer
+ * and open() it with the data directory), so instances never race each other
+ * on the file. Appending and compacting also hold an InterProcessLock, for
+ * hosts that run instances in separate processes.
+ */
+class PresetJournal : private juce::Thread, private juce::AsyncUpdater
+{
+public:
+    enum class Bank { synth, sequencer };
+
+    // Told on the message thread after a compaction, with the last sequence number it covered
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void presetsCompacted(int lastSequence) = 0;
+    };
+
+    PresetJournal();
+    ~PresetJournal() override;
+
+    // Message thread: starts the writer on the first call; later calls keep the first directory
+    void open(const juce::File& dataDirectory);
+
+    // Message thread: queue a preset for its user bank; returns the save's sequence number
+    int append(Bank bank, const juce::var& preset);
+
+    void addListener(Listener* listener) { listeners.add(listener); }
+    void removeListener(Listener* listener) { listeners.remove(listener); }
+
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    bool writeQueued(); // False if the records had to stay queued
+    bool compact();
+    static bool mergeBank(const juce::File& userFile, const juce::Array<juce::var>& journaled, juce::String& mergedJSON);
+    static bool writeTemporary(juce::TemporaryFile& temp, const juce::String& text);  // Empty text: nothing to write
+    static bool commitTemporary(juce::TemporaryFile& temp, const juce::String& text);
+    static bool replaceAtomically(const juce::File& file, const juce::String& text);
+
+    struct Record
+    {
+        int sequence = 0;
+        juce::String line; // One JSON object: { "bank": ..., "preset": ... }
+    };
+
+    static constexpr int kCompactDelayMs = 500;
+
+    juce::File dataDirectory;                    // Set once by open()
+    juce::File journalFile;
+    juce::InterProcessLock fileLock { "SnorkelSynthPresetJournal" };
+    juce::ListenerList<Listener> listeners;
+
+    juce::CriticalSection queueLock;
+    juce::Array<Record> queue;
+    int nextSequence = 1;                        // Message thread
+    juce::WaitableEvent recordsQueued;
+
+    bool journalDirty = false;                   // Writer thread: the journal holds records
+    int lastWrittenSequence = 0;                 // Writer thread
+    std::atomic<int> lastCompactedSequence { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetJournal)
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "ParameterSchema.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * Hands a complete set of parameter values from the message thread to the
+ * audio thread in one piece.
+ *
+ * The writer (message thread only) publishes the values before and after the
+ * switch under a sequence lock; the audio thread copies them without blocking
+ * and retries on the next block if it raced a write, so it never sees half of
+ * one preset and half of another. Each publish gets a new even sequence
+ * number, which the writer marks as applied once the host-facing parameters
+ * have caught up.
+ */
+class PresetSnapshot
+{
+public:
+    using Values = std::array<float, Param::numParams>;
+
+    PresetSnapshot()
+    {
+        for (size_t i = 0; i < target.size(); ++i)
+        {
+            previous[i].store(0.0f, std::memory_order_relaxed);
+            target[i].store(0.0f, std::memory_order_relaxed);
+        }
+    }
+
+    // Message thread: publish the current and target parameter vectors and return the sequence number
+    uint32_t publish(const Values& currentValues, const Values& targetValues, bool crossfade)
+    {
+        const uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed); // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < targetValues.size(); ++i)
+        {
+            previous[i].store(currentValues[i], std::memory_order_relaxed);
+            target[i].store(targetValues[i], std::memory_order_relaxed);
+        }
+        fade.store(crossfade, std::memory_order_relaxed);
+
+        sequence.store(seq + 2, std::memory_order_release);
+        return seq + 2;
+    }
+
+    // Message thread: the host-facing parameters now hold the snapshot's values
+    void markApplied(uint32_t seq) { appliedSequence.store(seq, std::memory_order_release); }
+
+    // Audio thread: copy the latest snapshot if it's newer than lastSeen.
+    // Returns false when there's nothing new or a write was in progress.
+    bool readIfNewer(Values& currentValues, Values& targetValues, uint32_t& lastSeen, bool& crossfade) const
+    {
+        const uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0 || before == lastSeen)
+            return false;
+
+        for (size_t i = 0; i < targetValues.size(); ++i)
+        {
+            currentValues[i] = previous[i].load(std::memory_order_relaxed);
+            targetValues[i] = target[i].load(std::memory_order_relaxed);
+        }
+        crossfade = fade.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before)
+            return false;
+
+        lastSeen = before;
+        return true;
+    }
+
+    // Audio thread: has the writer finished applying snapshot seq to the parameters?
+    bool isApplied(uint32_t seq) const
+    {
+        return static_cast<int32_t>(appliedSequence.load(std::memory_order_acquire) - seq) >= 0;
+    }
+
+private:
+    std::array<std::atomic<float>, Param::numParams> previous;
+    std::array<std::atomic<float>, Param::numParams> target;
+    std::atomic<bool> fade { false };
+    std::atomic<uint32_t> sequence { 0 };
+    std::atomic<uint32_t> appliedSequence { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetSnapshot)
+};
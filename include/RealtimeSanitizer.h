@@ -0,0 +1,52 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/**
+ * Opt-in check that the audio thread doesn't allocate, lock or block.
+ *
+ * Configure with -DSNORKEL_RT_SANITIZER=ON (off by default, meant for debug
+ * and CI builds). processBlock opens a Scope; while one is open on a thread,
+ * every heap allocation or free on it, and every call marked with
+ * SNORKEL_RT_BLOCKING, is reported to stderr with a stack trace and counted.
+ *
+ * With Clang 20 or later the option also builds with -fsanitize=realtime, and
+ * the Scope marks the thread real-time for it, which adds mutex locks, file
+ * and socket IO, sleeps and direct malloc calls (juce::HeapBlock, so MidiBuffer
+ * growth) to what's caught. Other compilers get the built-in operator new and
+ * delete check only.
+ *
+ * With the option off, the macros compile to nothing.
+ */
+#if SNORKEL_RT_SANITIZER
+
+namespace RealtimeSanitizer
+{
+    class Scope
+    {
+    public:
+        Scope();
+        ~Scope();
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    bool isInRealtimeScope();
+
+    // Reports a blocking call if the current thread is in a Scope
+    void notifyBlockingCall(const char* functionName);
+
+    // Violations reported so far (for a CI run to check before exiting)
+    int getViolationCount();
+}
+
+ #define SNORKEL_RT_SCOPE RealtimeSanitizer::Scope realtimeSanitizerScope
+ #define SNORKEL_RT_BLOCKING(functionName) RealtimeSanitizer::notifyBlockingCall(functionName)
+
+#else
+
+ #define SNORKEL_RT_SCOPE
+ #define SNORKEL_RT_BLOCKING(functionName)
+
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "PatternStore.h"
+#include <array>
+
+//==============================================================================
+/**
+ * The melody sequencer's pattern, compiled to a flat list of note events.
+ *
+ * Everything a step's notes depend on (pattern, octaves, root, scale, step
+ * count, progression chord, gate and per-step accent) is gathered into
+ * Inputs. Only the active steps are compiled. update() recompiles only when those differ from the last compile,
+ * so on most steps the sequencer just reads the step's slice of the list.
+ * Storage is fixed-size and nothing allocates, so it's safe on the audio thread.
+ */
+class SequencerEventList
+{
+public:
+    static constexpr int numSteps = PatternData::maxSteps;
+    static constexpr int numScaleDegrees = PatternData::numScaleDegrees;
+    static constexpr int maxEvents = numSteps * numScaleDegrees;
+    static constexpr int numAccents = 16; // The accent row repeats every 16 steps
+    static constexpr int ticksPerStep = 960; // Event positions and lengths, unswung
+
+    struct Inputs
+    {
+        const PatternData::MelodyPattern* pattern = nullptr;
+        uint32_t patternVersion = 0; // Published versions are immutable, so this and pattern identify the data
+        int rootNote = 0;
+        int scaleType = 0;
+        int activeSteps = numSteps;
+        int progressionOffset = 0; // Scale degrees the progression shifts every note by
+        float gate = 0.8f;         // Note length as a fraction of a step
+        std::array<float, numAccents> accents {}; // Per-step accent (-1 to +1)
+
+        bool operator==(const Inputs& other) const;
+        bool operator!=(const Inputs& other) const { return !(*this == other); }
+    };
+
+    struct Event
+    {
+        uint32_t tick = 0;      // Step * ticksPerStep
+        uint16_t length = 0;    // Ticks
+        uint8_t note = 0;
+        uint8_t velocity = 0;
+        uint8_t probability = PatternData::MelodyPattern::alwaysPlays; // The step's, in percent
+        float accent = 0.0f;
+    };
+
+    // Recompiles if inputs changed since the last compile; returns true if it did
+    bool update(const Inputs& inputs);
+
+    // Events starting on step (in note order); empty for rests and steps past the active count
+    const Event* stepBegin(int step) const { return events.data() + stepStart[static_cast<size_t>(juce::jlimit(0, numSteps, step))]; }
+    const Event* stepEnd(int step) const { return events.data() + stepStart[static_cast<size_t>(juce::jlimit(0, numSteps, step + 1))]; }
+
+    // The whole pattern, sorted by tick (e.g. for a preview)
+    const Event* begin() const { return events.data(); }
+    const Event* end() const { return events.data() + numEvents; }
+
+    // Scale degree (0-7, 7 = octave) to MIDI note around C3
+    static int scaleDegreeToNote(int scaleDegree, int rootNote, int scaleType);
+
+private:
+    void compile();
+
+    Inputs compiledInputs;
+    bool compiled = false;
+    std::array<Event, maxEvents> events {};
+    std::array<int, numSteps + 1> stepStart {}; // events[stepStart[s]] .. events[stepStart[s + 1]] start on step s
+    int numEvents = 0;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <map>
+#include <memory>
+
+//==============================================================================
+/**
+ * Read-only resources shared by every plugin instance in the process (hold it
+ * through juce::SharedResourcePointer): parsed JSON files and decoded audio.
+ *
+ * Entries are keyed by file path and re-read when the file's modification time
+ * or size changes, so a preset file saved by one instance is picked up by the
+ * next one that asks. Returned data must be treated as immutable.
+ */
+class SharedResourceCache
+{
+public:
+    struct AudioSample
+    {
+        juce::AudioBuffer<float> buffer;
+        double sampleRate = 0.0;
+    };
+
+    SharedResourceCache();
+
+    /** Parsed contents of a JSON file, or a void var if it's missing or invalid. */
+    juce::var getJSON(const juce::File& file);
+
+    /** Decoded audio file, resampled when targetSampleRate is non-zero and differs
+        from the file's rate. Kept only while something still holds the pointer. */
+    std::shared_ptr<const AudioSample> getAudio(const juce::File& file, double targetSampleRate = 0.0);
+
+private:
+    struct FileStamp
+    {
+        juce::Time modified;
+        juce::int64 size = -1;
+
+        static FileStamp of(const juce::File& file) { return { file.getLastModificationTime(), file.getSize() }; }
+        bool operator==(const FileStamp& other) const { return modified == other.modified && size == other.size; }
+    };
+
+    struct JSONEntry
+    {
+        FileStamp stamp;
+        juce::var value;
+    };
+
+    struct AudioEntry
+    {
+        FileStamp stamp;
+        std::weak_ptr<const AudioSample> sample;
+    };
+
+    std::shared_ptr<const AudioSample> decode(const juce::File& file);
+    static std::shared_ptr<const AudioSample> resample(const AudioSample& source, double targetSampleRate);
+
+    static constexpr juce::int64 kMemoryMapThreshold = 1024 * 1024; // Map audio files bigger than 1 MB
+
+    juce::CriticalSection jsonLock;
+    std::map<juce::String, JSONEntry> jsonEntries;
+
+    juce::CriticalSection audioLock;
+    std::map<juce::String, AudioEntry> audioEntries; // Keyed by path plus target rate
+    juce::AudioFormatManager formatManager;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedResourceCache)
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+ * Kick-triggered ducking envelope with linear attack, hold and release stages.
+ *
+ * The processor triggers it at the kick's sample position (sub-blocks are cut
+ * at drum steps, so that's the start of a sub-block) and renders it into a
+ * per-sample gain buffer. Stage lengths are latched when each stage starts, so
+ * the curve is the same whatever the host block size.
+ */
+class SidechainEnvelope
+{
+public:
+    SidechainEnvelope() = default;
+
+    // Shape used by the next trigger; lengths in samples, depth 0-1
+    void setShape(float attackSamples, float holdSamples, float releaseSamples, float depth);
+
+    // Starts a new duck from the current level at the next rendered sample
+    void trigger();
+    void reset();
+
+    // Writes the ducking gain (1 = no duck) for the next numSamples samples
+    void render(float* gain, int numSamples);
+
+    bool isActive() const { return stage != Stage::idle; }
+    float getLevel() const { return level; } // Current ducking amount (0-1)
+
+private:
+    enum class Stage { idle, attack, hold, release };
+
+    void enterStage(Stage newStage);
+
+    Stage stage = Stage::idle;
+    float level = 0.0f;
+    float increment = 0.0f;   // Per-sample level change in the current stage
+    int samplesLeft = 0;      // Samples remaining in the current stage
+
+    float attackLength = 0.0f;
+    float holdLength = 0.0f;
+    float releaseLength = 0.0f;
+    float targetDepth = 0.0f;
+    float stageDepth = 0.0f;  // Depth latched at trigger time
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SidechainEnvelope)
+};
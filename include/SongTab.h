@@ -0,0 +1,50 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+ * Song tab for chaining melody patterns: each entry plays a pattern for a
+ * number of loops, then the next entry takes over at the pattern's loop point
+ */
+class SongTab : public juce::Component, private juce::Timer
+{
+public:
+    SongTab(SnorkelSynthAudioProcessor& p);
+    ~SongTab() override;
+
+    //==============================================================================
+    void paint(juce::Graphics&) override;
+    void resized() override;
+    void timerCallback() override;
+
+private:
+    SnorkelSynthAudioProcessor& audioProcessor;
+
+    static constexpr int NUM_ENTRIES = PatternData::maxSongEntries;
+
+    // Shows the song as stored in the pattern store
+    void refreshFromSong();
+
+    // Enable toggle
+    juce::ToggleButton enableToggle;
+    juce::Label enableLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> enableAttachment;
+
+    // Entry count
+    juce::Slider entriesSlider;
+    juce::Label entriesLabel;
+
+    // Per entry: the pattern it plays and how many times (displayed in four rows)
+    juce::Slider patternSliders[NUM_ENTRIES];
+    juce::Slider repeatSliders[NUM_ENTRIES];
+    juce::Label entryLabels[NUM_ENTRIES];
+
+    // Song version last shown, and the entry playing, for visual feedback
+    uint32_t shownVersion = 0;
+    int currentEntry = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SongTab)
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+ * Tempo-synced stereo feedback delay used for the synth's delay effect.
+ *
+ * Both channels share one circular buffer write position and delay time. While
+ * the delay time is steady, each block is processed as whole spans copied in
+ * and out of the circular buffer with FloatVectorOperations. When the tempo or
+ * delay division changes, the delay time glides to the new value (with
+ * interpolated reads) instead of jumping, which avoids clicks.
+ */
+class StereoDelay
+{
+public:
+    StereoDelay() = default;
+
+    // Allocate for the longest delay and block size (call from prepareToPlay)
+    void prepare(double sampleRate, int maximumBlockSize, double maximumDelaySeconds);
+    void reset();
+
+    // Target delay in samples; a change glides there over kGlideSeconds
+    void setDelaySamples(float newDelaySamples);
+    void setFeedback(float newFeedback) { feedback = newFeedback; }
+
+    // Processes up to two channels in place. mixCurve holds the wet amount (0-1) for each sample.
+    void process(float* const* channels, int numChannels, int numSamples, const float* mixCurve);
+
+private:
+    void processSteady(float* const* channels, int numChannels, int startSample, int numSamples, const float* mixCurve);
+    void processGliding(float* const* channels, int numChannels, int startSample, int numSamples, const float* mixCurve);
+
+    static constexpr int kMaxChannels = 2;
+    static constexpr double kGlideSeconds = 0.05;
+
+    juce::AudioBuffer<float> ring;       // Power-of-two length, one channel per output channel
+    juce::AudioBuffer<float> wetScratch; // Delayed signal for the span being processed
+    int ringMask = 0;
+    int writePosition = 0;
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> delaySamples;
+    bool hasDelayTime = false;
+    float feedback = 0.0f;
+    double sampleRate = 44100.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StereoDelay)
+};
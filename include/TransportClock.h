@@ -0,0 +1,107 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+/**
+ * Musical position shared by the arpeggiator, sequencer, drums and progression.
+ *
+ * The clock counts beats (quarter notes) and advances by whole sub-blocks.
+ * Each engine keeps a StepCursor holding the beat its next step falls on, so
+ * step times follow the tempo rather than a per-engine sample counter: a tempo
+ * change moves later steps instead of bunching them up, and every step lands
+ * on the same absolute sample whatever the host's block size.
+ * samplesUntil() tells processBlock where to end the sub-block, so each step
+ * is handled at the start of a sub-block at its exact sample offset.
+ *
+ * While the host plays, beat 0 is the host's ppq 0 and bar lines follow its
+ * time signature and last bar start, so the engines stay on the DAW grid.
+ */
+class TransportClock
+{
+public:
+    void prepare(double newSampleRate) { sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0; }
+    void setTempo(double bpm) { beatsPerMinute = juce::jmax(1.0, bpm); }
+    void reset(double beat = 0.0) { currentBeat = beat; }
+
+    // Bar grid: length from the time signature, phase from a known bar line
+    void setTimeSignature(int numerator, int denominator);
+    void setBarStart(double beat) { barOriginBeat = beat; }
+    double getBeatsPerBar() const { return beatsPerBar; }
+
+    // Position at the start of the current sub-block
+    double getBeat() const { return currentBeat; }
+    double getSamplesPerBeat() const { return sampleRate * 60.0 / beatsPerMinute; }
+
+    // Whole samples from now until beat (0 if it's already due)
+    int samplesUntil(double beat) const;
+
+    // Moves past a rendered sub-block
+    void advance(int numSamples) { currentBeat += numSamples / getSamplesPerBeat(); }
+
+    // First multiple of gridBeats at or after the current position (where an engine starting now begins)
+    double nextGridBeat(double gridBeats) const
+    {
+        return std::ceil(currentBeat / gridBeats - kBeatEpsilon) * gridBeats;
+    }
+
+    // First bar line at or after the current position
+    double nextBarBeat() const;
+
+    // Bar lines fall on getBarPhase() + n * getBeatsPerBar()
+    double getBarPhase() const;
+
+    // Is an event at beat due at the start of this sub-block? Allows for rounding in samplesUntil().
+    bool isDue(double beat) const { return currentBeat >= beat - kBeatEpsilon; }
+
+    // Swing delays off-beat steps: even steps last longer and odd steps shorter, so pairs keep their length
+    static double swungStepBeats(double stepBeats, float swing, int stepIndex)
+    {
+        return stepBeats * ((stepIndex % 2 == 0) ? (1.0 + swing * 0.5) : (1.0 - swing * 0.5));
+    }
+
+    // Beats per step for a note-rate choice index (1/32 ... 1/1)
+    static double noteRateToBeats(int rateIndex);
+
+    /** The first swung step (counting from beat 0) starting at or after beat:
+        its index and the beat it starts on. Used to pick up a pattern
+        mid-way after the host jumps. */
+    struct StepPosition
+    {
+        long long index = 0;
+        double beat = 0.0;
+    };
+    static StepPosition locateStep(double beat, double stepBeats, float swing);
+
+private:
+    static constexpr double kBeatEpsilon = 1.0e-9;
+
+    double sampleRate = 44100.0;
+    double beatsPerMinute = 120.0;
+    double currentBeat = 0.0;
+    double beatsPerBar = 4.0;
+    double barOriginBeat = 0.0;
+};
+
+//==============================================================================
+/** The beat an engine's next step falls on. */
+class StepCursor
+{
+public:
+    void restartAt(double beat) { nextBeat = beat; }
+    double getNextBeat() const { return nextBeat; }
+    bool isDue(const TransportClock& clock) const { return clock.isDue(nextBeat); }
+
+    // Called after handling a step, with that step's (swung) length. A cursor
+    // that's still behind the clock (its engine was paused, or the rate just
+    // got much faster) restarts from now rather than firing the missed steps.
+    void advance(double stepBeats, const TransportClock& clock)
+    {
+        nextBeat += stepBeats;
+        if (isDue(clock))
+            nextBeat = clock.getBeat() + stepBeats;
+    }
+
+private:
+    double nextBeat = 0.0;
+};
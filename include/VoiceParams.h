@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+//==============================================================================
+/**
+ * Plain snapshot of every per-voice parameter, built once per block by the
+ * processor and handed to all voices together with a bitmask of the groups that
+ * changed since the previous block. Voices only recompute derived values
+ * (pitch increments, LFO frequencies, envelope rates) for dirty groups.
+ */
+struct VoiceParams
+{
+    enum LFOIndex
+    {
+        cutoffLFO = 0, resonanceLFO, envModLFO, decayLFO, accentLFO,
+        waveformLFO, subOscLFO, driveLFO, volumeLFO, delayMixLFO,
+        numLFOs
+    };
+
+    struct Oscillator
+    {
+        float wave;   // 0=sine, 0.5=saw, 1=square
+        int coarse;   // -24 to +24 semitones
+        float fine;   // -100 to +100 cents
+        float mix;    // 0 to 1
+    };
+
+    struct Envelope
+    {
+        float attack, decay, sustain, release;
+    };
+
+    struct LFO
+    {
+        int rate;
+        int waveform;
+        float depth;
+    };
+
+    // Filter
+    float cutoff, resonance, envMod, accent, filterFeedback;
+
+    // Sources
+    Oscillator osc[3];
+    float noiseMix, noiseType, noiseDecay;
+
+    // Output stage
+    float drive;
+    int saturationType;
+    float volume;
+
+    // Pitch / tempo
+    int globalOctave;
+    double bpm;
+
+    // Analog character
+    float drift, phaseRandom, unison;
+
+    // Envelopes
+    Envelope filterEnv, ampEnv;
+
+    // Dedicated LFOs
+    LFO lfo[numLFOs];
+
+    //==============================================================================
+    // Change groups
+    enum DirtyFlags : uint32_t
+    {
+        filterDirty      = 1u << 0,
+        osc1Dirty        = 1u << 1,
+        osc2Dirty        = 1u << 2,
+        osc3Dirty        = 1u << 3,
+        noiseDirty       = 1u << 4,
+        noiseDecayDirty  = 1u << 5,
+        driveDirty       = 1u << 6,
+        volumeDirty      = 1u << 7,
+        octaveDirty      = 1u << 8,
+        bpmDirty         = 1u << 9,
+        analogDirty      = 1u << 10,
+        filterEnvDirty   = 1u << 11,
+        ampEnvDirty      = 1u << 12,
+        firstLFODirty    = 1u << 16, // One bit per LFO from here (16 to 25)
+        allDirty         = 0xffffffffu
+    };
+
+    static constexpr uint32_t lfoDirtyBit(int index) { return firstLFODirty << index; }
+
+    // Bitmask of groups that differ between two snapshots
+    static uint32_t diff(const VoiceParams& a, const VoiceParams& b)
+    {
+        uint32_t dirty = 0;
+
+        if (a.cutoff != b.cutoff || a.resonance != b.resonance || a.envMod != b.envMod
+            || a.accent != b.accent || a.filterFeedback != b.filterFeedback)
+            dirty |= filterDirty;
+
+        for (int i = 0; i < 3; ++i)
+            if (a.osc[i].wave != b.osc[i].wave || a.osc[i].coarse != b.osc[i].coarse
+                || a.osc[i].fine != b.osc[i].fine || a.osc[i].mix != b.osc[i].mix)
+                dirty |= osc1Dirty << i;
+
+        if (a.noiseMix != b.noiseMix || a.noiseType != b.noiseType)
+            dirty |= noiseDirty;
+        if (a.noiseDecay != b.noiseDecay)
+            dirty |= noiseDecayDirty;
+        if (a.drive != b.drive || a.saturationType != b.saturationType)
+            dirty |= driveDirty;
+        if (a.volume != b.volume)
+            dirty |= volumeDirty;
+        if (a.globalOctave != b.globalOctave)
+            dirty |= octaveDirty;
+        if (a.bpm != b.bpm)
+            dirty |= bpmDirty;
+        if (a.drift != b.drift || a.phaseRandom != b.phaseRandom || a.unison != b.unison)
+            dirty |= analogDirty;
+        if (!sameEnvelope(a.filterEnv, b.filterEnv))
+            dirty |= filterEnvDirty;
+        if (!sameEnvelope(a.ampEnv, b.ampEnv))
+            dirty |= ampEnvDirty;
+
+        for (int i = 0; i < numLFOs; ++i)
+            if (a.lfo[i].rate != b.lfo[i].rate || a.lfo[i].waveform != b.lfo[i].waveform
+                || a.lfo[i].depth != b.lfo[i].depth)
+                dirty |= lfoDirtyBit(i);
+
+        return dirty;
+    }
+
+private:
+    static bool sameEnvelope(const Envelope& a, const Envelope& b)
+    {
+        return a.attack == b.attack && a.decay == b.decay && a.sustain == b.sustain && a.release == b.release;
+    }
+};
+
+static_assert(std::is_trivially_copyable<VoiceParams>::value && std::is_standard_layout<VoiceParams>::value,
+              "VoiceParams must stay a plain snapshot");
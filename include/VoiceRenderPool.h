@@ -0,0 +1,64 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * Small pool of real-time priority worker threads used to render synth voices
+ * in parallel. One pool is shared by every plugin instance in the process
+ * (hold it through juce::SharedResourcePointer).
+ *
+ * No threads exist until an instance first asks for a batch: that batch renders
+ * on the calling thread, and a message-thread timer starts the workers. Workers
+ * that haven't seen a request for a second park on an event until the next one,
+ * so the pool costs nothing while parallel rendering is off.
+ *
+ * Jobs are claimed from a single atomic word, so dispatching a batch never takes
+ * a lock, and the audio thread never wakes a worker: awake workers spin for a
+ * short while, then poll every millisecond. The calling thread joins in and runs
+ * any job no worker has claimed, then spins on the barrier.
+ */
+class VoiceRenderPool : private juce::Timer
+{
+public:
+    /** A batch of independent jobs, indexed 0 to numJobs - 1. */
+    struct Job
+    {
+        virtual ~Job() = default;
+        virtual void run(int jobIndex) = 0;
+    };
+
+    VoiceRenderPool();
+    ~VoiceRenderPool() override;
+
+    /** Runs job.run() for every index across the workers and the calling thread,
+        returning once all of them have finished. Returns false without running
+        anything when the workers aren't awake yet or the pool is busy with another
+        instance's batch - the caller should then render on its own thread. */
+    bool runBatch(Job& job, int numJobs);
+
+private:
+    class Worker;
+
+    void timerCallback() override; // Starts, wakes and parks the workers
+    void workerLoop(Worker& worker);
+    bool runPendingJobs();
+
+    juce::OwnedArray<Worker> workers; // Message thread only
+
+    // Job word layout: [batch:32][jobCount:16][nextJob:16]
+    std::atomic<uint64_t> jobWord { 0 };
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<int> jobsFinished { 0 };
+    std::atomic<bool> batchInProgress { false };
+    uint32_t batchCounter = 0; // Only touched while holding batchInProgress
+
+    std::atomic<bool> batchRequested { false }; // Audio threads: a batch was asked for since the last timer tick
+    std::atomic<bool> workersAwake { false };   // Workers poll for jobs while set, and park otherwise
+    int idleTicks = 0;                          // Timer ticks without a request (message thread)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoiceRenderPool)
+};
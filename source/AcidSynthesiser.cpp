@@ -0,0 +1,75 @@
+#include "AcidSynthesiser.h"
+
+void AcidSynthesiser::prepare(int maximumBlockSize, int numChannels)
+{
+    scratchNumChannels = juce::jlimit(1, kMaxScratchChannels, numChannels);
+    scratchNumSamples = juce::jmax(1, maximumBlockSize);
+
+    const int numVoices = getNumVoices();
+    voiceScratch.setSize(numVoices * scratchNumChannels, scratchNumSamples);
+    voiceScratch.clear();
+
+    // Cache channel pointers so worker threads never touch the AudioBuffer object itself
+    scratchChannels.resize(static_cast<size_t>(numVoices * scratchNumChannels));
+    for (int ch = 0; ch < numVoices * scratchNumChannels; ++ch)
+        scratchChannels[static_cast<size_t>(ch)] = voiceScratch.getWritePointer(ch);
+
+    activeVoices.resize(static_cast<size_t>(numVoices), nullptr);
+}
+
+void AcidSynthesiser::renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    const int numChannels = outputAudio.getNumChannels();
+
+    bool canRenderInParallel = parallelRenderingEnabled
+                               && numSamples >= kMinParallelSamples
+                               && numSamples <= scratchNumSamples
+                               && numChannels <= scratchNumChannels
+                               && static_cast<int>(activeVoices.size()) == voices.size();
+
+    // Collect the voices that have something to render
+    int numActive = 0;
+    if (canRenderInParallel)
+    {
+        for (auto* voice : voices)
+            if (voice->isVoiceActive())
+                activeVoices[static_cast<size_t>(numActive++)] = voice;
+    }
+
+    if (!canRenderInParallel || numActive < kMinParallelVoices)
+    {
+        juce::Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+        return;
+    }
+
+    renderJob.numChannels = numChannels;
+    renderJob.numSamples = numSamples;
+
+    if (!renderPool->runBatch(renderJob, numActive))
+    {
+        // Pool busy or unavailable - render everything on this thread
+        juce::Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+        return;
+    }
+
+    // Sum in voice order so the output doesn't depend on thread scheduling
+    for (int i = 0; i < numActive; ++i)
+        for (int ch = 0; ch < numChannels; ++ch)
+            outputAudio.addFrom(ch, startSample,
+                                scratchChannels[static_cast<size_t>(i * scratchNumChannels + ch)],
+                                numSamples);
+}
+
+void AcidSynthesiser::VoiceRenderJob::run(int jobIndex)
+{
+    float* channels[kMaxScratchChannels] = {};
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        channels[ch] = owner.scratchChannels[static_cast<size_t>(jobIndex * owner.scratchNumChannels + ch)];
+        juce::FloatVectorOperations::clear(channels[ch], numSamples);
+    }
+
+    // Lightweight view onto the preallocated scratch channels (no allocation)
+    juce::AudioBuffer<float> voiceBuffer(channels, numChannels, numSamples);
+    owner.activeVoices[static_cast<size_t>(jobIndex)]->renderNextBlock(voiceBuffer, 0, numSamples);
+}
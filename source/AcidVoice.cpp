@@ -31,7 +31,7 @@ AcidVoice::AcidVoice()
 
 bool AcidVoice::canPlaySound(juce::SynthesiserSound* sound)
 {
-    return dynamic_cast<AcidSound*>(sound) != nullptr;
+    return voiceEnabled && dynamic_cast<AcidSound*>(sound) != nullptr;
 }
 
 void AcidVoice::startNote(int midiNoteNumber, float velocity,
@@ -71,6 +71,9 @@ void AcidVoice::startNote(int midiNoteNumber, float velocity,
     // Update frequency
     updateAngleDelta();
 
+    // Evaluate LFOs on the first sample of the note
+    lfoSamplesUntilUpdate = 0;
+
     // Start all ADSRs
     ampADSR.noteOn();
     filterADSR.noteOn();
@@ -106,17 +109,31 @@ void AcidVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
 
     while (--numSamples >= 0)
     {
-        // Get all 10 LFO modulation values (-1 to +1)
-        double cutoffLFOValue = getLFOValue(cutoffLFO);
-        double resonanceLFOValue = getLFOValue(resonanceLFO);
-        double envModLFOValue = getLFOValue(envModLFO);
-        double decayLFOValue = getLFOValue(decayLFO);
-        double accentLFOValue = getLFOValue(accentLFO);
-        double waveformLFOValue = getLFOValue(waveformLFO);
-        double subOscLFOValue = getLFOValue(subOscLFO);
-        double driveLFOValue = getLFOValue(driveLFO);
-        double volumeLFOValue = getLFOValue(volumeLFO);
-        // delayMixLFO is used in the processor's delay effect, not here
+        // Get all 10 LFO modulation values (-1 to +1), at control rate when the governor asks for it
+        if (--lfoSamplesUntilUpdate <= 0)
+        {
+            lfoSamplesUntilUpdate = lfoControlInterval;
+            heldLFOValues.cutoff = getLFOValue(cutoffLFO);
+            heldLFOValues.resonance = getLFOValue(resonanceLFO);
+            heldLFOValues.envMod = getLFOValue(envModLFO);
+            heldLFOValues.decay = getLFOValue(decayLFO);
+            heldLFOValues.accent = getLFOValue(accentLFO);
+            heldLFOValues.waveform = getLFOValue(waveformLFO);
+            heldLFOValues.subOsc = getLFOValue(subOscLFO);
+            heldLFOValues.drive = getLFOValue(driveLFO);
+            heldLFOValues.volume = getLFOValue(volumeLFO);
+            // delayMixLFO is used in the processor's delay effect, not here
+        }
+
+        double cutoffLFOValue = heldLFOValues.cutoff;
+        double resonanceLFOValue = heldLFOValues.resonance;
+        double envModLFOValue = heldLFOValues.envMod;
+        double decayLFOValue = heldLFOValues.decay;
+        double accentLFOValue = heldLFOValues.accent;
+        double waveformLFOValue = heldLFOValues.waveform;
+        double subOscLFOValue = heldLFOValues.subOsc;
+        double driveLFOValue = heldLFOValues.drive;
+        double volumeLFOValue = heldLFOValues.volume;
 
         // Drift: Apply slow random pitch modulation (per-oscillator)
         if (driftAmount > 0.01f)
@@ -189,14 +206,13 @@ void AcidVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
             pinkNoise *= 0.11; // Normalize
 
             // Generate filtered noise (bandpass ~500Hz-2kHz for percussive sound)
-            static double filteredB1 = 0.0, filteredB2 = 0.0;
             double f = 0.15; // Filter frequency coefficient
             double q = 0.5;  // Resonance
-            double lowpass = filteredB2 + f * filteredB1;
-            double highpass = whiteNoise - lowpass - q * filteredB1;
-            double bandpass = f * highpass + filteredB1;
-            filteredB1 = bandpass;
-            filteredB2 = lowpass;
+            double lowpass = filteredNoiseB2 + f * filteredNoiseB1;
+            double highpass = whiteNoise - lowpass - q * filteredNoiseB1;
+            double bandpass = f * highpass + filteredNoiseB1;
+            filteredNoiseB1 = bandpass;
+            filteredNoiseB2 = lowpass;
             double filteredNoise = bandpass * 3.0; // Amplify bandpass output
 
             // Morph between noise types
@@ -291,13 +307,12 @@ void AcidVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
             osc3.angle -= juce::MathConstants<double>::twoPi;
 
         // Advance unison voice angles with frequency detuning
-        if (unisonAmount > 0.01f)
+        if (unisonAmount > 0.01f && unisonVoiceLimit > 1)
         {
-            for (int v = 0; v < maxUnisonVoices; ++v)
+            for (int v = 0; v < unisonVoiceLimit; ++v)
             {
-                // Calculate detune ratio for this voice (±10 cents max)
-                float detuneCents = unisonDetuneAmounts[v] * unisonAmount * 10.0f;
-                double detunePitchRatio = std::pow(2.0, detuneCents / 1200.0);
+                // Detune ratio for this voice (±10 cents max), precomputed in updateUnisonDetune
+                double detunePitchRatio = unisonDetuneRatios[v];
 
                 // Advance each unison voice with its own detuned frequency
                 unisonAngles1[v] += osc1.angleDelta * driftPitchRatio1 * detunePitchRatio;
@@ -362,28 +377,19 @@ void AcidVoice::setAccent(float accent)
 
 void AcidVoice::setOscillator1(float wave, int coarse, float fine, float mix)
 {
-    osc1.wave = juce::jlimit(0.0f, 1.0f, wave);
-    osc1.coarseTune = juce::jlimit(-24, 24, coarse);
-    osc1.fineTune = juce::jlimit(-100.0f, 100.0f, fine);
-    osc1.mix = juce::jlimit(0.0f, 1.0f, mix);
+    assignOscillator(osc1, wave, coarse, fine, mix);
     updateAngleDelta(); // Recalculate frequencies
 }
 
 void AcidVoice::setOscillator2(float wave, int coarse, float fine, float mix)
 {
-    osc2.wave = juce::jlimit(0.0f, 1.0f, wave);
-    osc2.coarseTune = juce::jlimit(-24, 24, coarse);
-    osc2.fineTune = juce::jlimit(-100.0f, 100.0f, fine);
-    osc2.mix = juce::jlimit(0.0f, 1.0f, mix);
+    assignOscillator(osc2, wave, coarse, fine, mix);
     updateAngleDelta(); // Recalculate frequencies
 }
 
 void AcidVoice::setOscillator3(float wave, int coarse, float fine, float mix)
 {
-    osc3.wave = juce::jlimit(0.0f, 1.0f, wave);
-    osc3.coarseTune = juce::jlimit(-24, 24, coarse);
-    osc3.fineTune = juce::jlimit(-100.0f, 100.0f, fine);
-    osc3.mix = juce::jlimit(0.0f, 1.0f, mix);
+    assignOscillator(osc3, wave, coarse, fine, mix);
     updateAngleDelta(); // Recalculate frequencies
 }
 
@@ -473,6 +479,7 @@ void AcidVoice::setPhaseRandom(float amount)
 void AcidVoice::setUnison(float amount)
 {
     unisonAmount = juce::jlimit(0.0f, 1.0f, amount);
+    updateUnisonDetune();
 }
 
 // ADSR setters
@@ -497,84 +504,177 @@ void AcidVoice::setAmpADSR(float attack, float decay, float sustain, float relea
 // Dedicated LFO setters
 void AcidVoice::setCutoffLFO(int rate, int waveform, float depth)
 {
-    cutoffLFO.rate = juce::jlimit(0, 14, rate);
-    cutoffLFO.waveform = juce::jlimit(0, 5, waveform);
-    cutoffLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(cutoffLFO, rate, waveform, depth);
     updateLFOFrequency(cutoffLFO);
 }
 
 void AcidVoice::setResonanceLFO(int rate, int waveform, float depth)
 {
-    resonanceLFO.rate = juce::jlimit(0, 14, rate);
-    resonanceLFO.waveform = juce::jlimit(0, 5, waveform);
-    resonanceLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(resonanceLFO, rate, waveform, depth);
     updateLFOFrequency(resonanceLFO);
 }
 
 void AcidVoice::setEnvModLFO(int rate, int waveform, float depth)
 {
-    envModLFO.rate = juce::jlimit(0, 14, rate);
-    envModLFO.waveform = juce::jlimit(0, 5, waveform);
-    envModLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(envModLFO, rate, waveform, depth);
     updateLFOFrequency(envModLFO);
 }
 
 void AcidVoice::setDecayLFO(int rate, int waveform, float depth)
 {
-    decayLFO.rate = juce::jlimit(0, 14, rate);
-    decayLFO.waveform = juce::jlimit(0, 5, waveform);
-    decayLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(decayLFO, rate, waveform, depth);
     updateLFOFrequency(decayLFO);
 }
 
 void AcidVoice::setAccentLFO(int rate, int waveform, float depth)
 {
-    accentLFO.rate = juce::jlimit(0, 14, rate);
-    accentLFO.waveform = juce::jlimit(0, 5, waveform);
-    accentLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(accentLFO, rate, waveform, depth);
     updateLFOFrequency(accentLFO);
 }
 
 void AcidVoice::setWaveformLFO(int rate, int waveform, float depth)
 {
-    waveformLFO.rate = juce::jlimit(0, 14, rate);
-    waveformLFO.waveform = juce::jlimit(0, 5, waveform);
-    waveformLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(waveformLFO, rate, waveform, depth);
     updateLFOFrequency(waveformLFO);
 }
 
 void AcidVoice::setSubOscLFO(int rate, int waveform, float depth)
 {
-    subOscLFO.rate = juce::jlimit(0, 14, rate);
-    subOscLFO.waveform = juce::jlimit(0, 5, waveform);
-    subOscLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(subOscLFO, rate, waveform, depth);
     updateLFOFrequency(subOscLFO);
 }
 
 void AcidVoice::setDriveLFO(int rate, int waveform, float depth)
 {
-    driveLFO.rate = juce::jlimit(0, 14, rate);
-    driveLFO.waveform = juce::jlimit(0, 5, waveform);
-    driveLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(driveLFO, rate, waveform, depth);
     updateLFOFrequency(driveLFO);
 }
 
 void AcidVoice::setVolumeLFO(int rate, int waveform, float depth)
 {
-    volumeLFO.rate = juce::jlimit(0, 14, rate);
-    volumeLFO.waveform = juce::jlimit(0, 5, waveform);
-    volumeLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(volumeLFO, rate, waveform, depth);
     updateLFOFrequency(volumeLFO);
 }
 
 void AcidVoice::setDelayMixLFO(int rate, int waveform, float depth)
 {
-    delayMixLFO.rate = juce::jlimit(0, 14, rate);
-    delayMixLFO.waveform = juce::jlimit(0, 5, waveform);
-    delayMixLFO.depth = juce::jlimit(0.0f, 1.0f, depth);
+    assignLFO(delayMixLFO, rate, waveform, depth);
     updateLFOFrequency(delayMixLFO);
 }
 
+//==============================================================================
+void AcidVoice::applyParameters(const VoiceParams& params, uint32_t dirtyFlags)
+{
+    if (dirtyFlags & VoiceParams::filterDirty)
+    {
+        setCutoff(params.cutoff);
+        setResonance(params.resonance);
+        setEnvMod(params.envMod);
+        setAccent(params.accent);
+        setFilterFeedback(params.filterFeedback);
+    }
+
+    // Oscillator tuning and octave share one pitch recalculation
+    Oscillator* oscillators[] = { &osc1, &osc2, &osc3 };
+    bool pitchChanged = (dirtyFlags & VoiceParams::octaveDirty) != 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (dirtyFlags & (VoiceParams::osc1Dirty << i))
+        {
+            const auto& osc = params.osc[i];
+            assignOscillator(*oscillators[i], osc.wave, osc.coarse, osc.fine, osc.mix);
+            pitchChanged = true;
+        }
+    }
+
+    if (dirtyFlags & VoiceParams::octaveDirty)
+        globalOctaveShift = juce::jlimit(-2, 2, params.globalOctave);
+
+    if (pitchChanged)
+        updateAngleDelta();
+
+    if (dirtyFlags & VoiceParams::noiseDirty)
+    {
+        setNoiseMix(params.noiseMix);
+        setNoiseType(params.noiseType);
+    }
+
+    if (dirtyFlags & VoiceParams::noiseDecayDirty)
+        setNoiseDecay(params.noiseDecay);
+
+    if (dirtyFlags & VoiceParams::driveDirty)
+    {
+        setDrive(params.drive);
+        setSaturationType(params.saturationType);
+    }
+
+    if (dirtyFlags & VoiceParams::volumeDirty)
+        setVolume(params.volume);
+
+    if (dirtyFlags & VoiceParams::analogDirty)
+    {
+        setDrift(params.drift);
+        setPhaseRandom(params.phaseRandom);
+        setUnison(params.unison);
+    }
+
+    if (dirtyFlags & VoiceParams::filterEnvDirty)
+        setFilterADSR(params.filterEnv.attack, params.filterEnv.decay, params.filterEnv.sustain, params.filterEnv.release);
+
+    if (dirtyFlags & VoiceParams::ampEnvDirty)
+        setAmpADSR(params.ampEnv.attack, params.ampEnv.decay, params.ampEnv.sustain, params.ampEnv.release);
+
+    // LFOs: a tempo change retunes all of them, otherwise only the ones that changed
+    LFO* lfos[VoiceParams::numLFOs] = { &cutoffLFO, &resonanceLFO, &envModLFO, &decayLFO, &accentLFO,
+                                        &waveformLFO, &subOscLFO, &driveLFO, &volumeLFO, &delayMixLFO };
+
+    const bool bpmChanged = (dirtyFlags & VoiceParams::bpmDirty) != 0;
+    if (bpmChanged)
+        currentBPM = juce::jlimit(20.0, 999.0, params.bpm);
+
+    for (int i = 0; i < VoiceParams::numLFOs; ++i)
+    {
+        const bool lfoChanged = (dirtyFlags & VoiceParams::lfoDirtyBit(i)) != 0;
+
+        if (lfoChanged)
+            assignLFO(*lfos[i], params.lfo[i].rate, params.lfo[i].waveform, params.lfo[i].depth);
+
+        if (lfoChanged || bpmChanged)
+            updateLFOFrequency(*lfos[i]);
+    }
+}
+
+void AcidVoice::assignOscillator(Oscillator& osc, float wave, int coarse, float fine, float mix)
+{
+    osc.wave = juce::jlimit(0.0f, 1.0f, wave);
+    osc.coarseTune = juce::jlimit(-24, 24, coarse);
+    osc.fineTune = juce::jlimit(-100.0f, 100.0f, fine);
+    osc.mix = juce::jlimit(0.0f, 1.0f, mix);
+}
+
+void AcidVoice::assignLFO(LFO& lfo, int rate, int waveform, float depth)
+{
+    lfo.rate = juce::jlimit(0, 14, rate);
+    lfo.waveform = juce::jlimit(0, 5, waveform);
+    lfo.depth = juce::jlimit(0.0f, 1.0f, depth);
+}
+
+void AcidVoice::updateUnisonDetune()
+{
+    for (int v = 0; v < maxUnisonVoices; ++v)
+    {
+        float detuneCents = unisonDetuneAmounts[v] * unisonAmount * 10.0f;
+        unisonDetuneRatios[v] = std::pow(2.0, detuneCents / 1200.0);
+    }
+}
+
+void AcidVoice::setQuality(int maxUnisonVoicesToRender, int lfoControlIntervalSamples)
+{
+    unisonVoiceLimit = juce::jlimit(1, maxUnisonVoices, maxUnisonVoicesToRender);
+    lfoControlInterval = juce::jmax(1, lfoControlIntervalSamples);
+}
+
 double AcidVoice::generateSingleOscillator(Oscillator& osc)
 {
     // Generate three waveforms: sine, sawtooth, square
@@ -606,14 +706,14 @@ double AcidVoice::generateOscillator()
     double osc2Sample = 0.0;
     double osc3Sample = 0.0;
 
-    // Unison: Always render 3 voices, dial controls detune amount only
-    if (unisonAmount > 0.01f)
+    // Unison: Render 3 voices (unless the CPU governor lowered the limit), dial controls detune amount only
+    if (unisonAmount > 0.01f && unisonVoiceLimit > 1)
     {
-        // Always use 3 voices with level compensation
-        float levelCompensation = 1.0f / std::sqrt(3.0f);
+        // Level compensation for the number of stacked voices
+        float levelCompensation = 1.0f / std::sqrt(static_cast<float>(unisonVoiceLimit));
 
-        // Oscillator 1 unison (3 voices)
-        for (int v = 0; v < 3; ++v)
+        // Oscillator 1 unison
+        for (int v = 0; v < unisonVoiceLimit; ++v)
         {
             double originalAngle = osc1.angle;
             osc1.angle = unisonAngles1[v];
@@ -625,8 +725,8 @@ double AcidVoice::generateOscillator()
         }
         osc1Sample *= osc1.mix;
 
-        // Oscillator 2 unison (3 voices)
-        for (int v = 0; v < 3; ++v)
+        // Oscillator 2 unison
+        for (int v = 0; v < unisonVoiceLimit; ++v)
         {
             double originalAngle = osc2.angle;
             osc2.angle = unisonAngles2[v];
@@ -638,8 +738,8 @@ double AcidVoice::generateOscillator()
         }
         osc2Sample *= osc2.mix;
 
-        // Oscillator 3 unison (3 voices)
-        for (int v = 0; v < 3; ++v)
+        // Oscillator 3 unison
+        for (int v = 0; v < unisonVoiceLimit; ++v)
         {
             double originalAngle = osc3.angle;
             osc3.angle = unisonAngles3[v];
@@ -870,15 +970,8 @@ double AcidVoice::getLFOValue(LFO& lfo)
         case 4: // Square
             return lfo.phase < juce::MathConstants<double>::pi ? 1.0 : -1.0;
 
-        case 5: // Random (sample & hold)
-        {
-            // Update random value when phase wraps
-            if (lfo.phase < juce::MathConstants<double>::twoPi / sampleRate)
-            {
-                lfo.lastRandomValue = (static_cast<float>(std::rand()) / RAND_MAX) * 2.0f - 1.0f;
-            }
+        case 5: // Random (sample & hold) - new value picked in advanceLFO when the phase wraps
             return lfo.lastRandomValue;
-        }
 
         default:
             return std::sin(lfo.phase);
@@ -889,5 +982,11 @@ void AcidVoice::advanceLFO(LFO& lfo)
 {
     lfo.phase += juce::MathConstants<double>::twoPi * lfo.frequency / sampleRate;
     if (lfo.phase >= juce::MathConstants<double>::twoPi)
+    {
         lfo.phase -= juce::MathConstants<double>::twoPi;
+
+        // Sample & hold: pick a new value on every wrap (works at any LFO control rate)
+        if (lfo.waveform == 5)
+            lfo.lastRandomValue = lfoRandom.nextFloat() * 2.0f - 1.0f;
+    }
 }
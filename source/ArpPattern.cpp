@@ -0,0 +1,78 @@
+#include "ArpPattern.h"
+
+ArpPattern::ArpPattern()
+    : generator(juce::Time::currentTimeMillis()) // Seeded once per instance; steps never touch the system generator
+{
+}
+
+void ArpPattern::update(const HeldNotes& heldNotes, int mode, int octaves)
+{
+    octaves = juce::jlimit(1, maxOctaves, octaves);
+    mode = juce::jlimit(static_cast<int>(up), static_cast<int>(asPlayed), mode);
+
+    const bool sameNotes = heldNotes.size() == compiledNotes.size()
+                        && std::equal(heldNotes.begin(), heldNotes.end(), compiledNotes.begin());
+    if (sameNotes && mode == compiledMode && octaves == compiledOctaves)
+        return;
+
+    compiledNotes = heldNotes;
+    compiledMode = mode;
+    compiledOctaves = octaves;
+    compile(heldNotes);
+
+    if (length > 0)
+        position %= length;
+}
+
+void ArpPattern::compile(const HeldNotes& heldNotes)
+{
+    length = 0;
+    if (heldNotes.empty())
+        return;
+
+    // Notes of one octave, in the order the mode walks them
+    HeldNotes ordered = heldNotes;
+    if (compiledMode != asPlayed)
+        ordered.sort();
+
+    auto append = [this](int note)
+    {
+        cycle[static_cast<size_t>(length++)] = static_cast<uint8_t>(juce::jlimit(0, 127, note));
+    };
+
+    // Ascending run through every octave
+    for (int octave = 0; octave < compiledOctaves; ++octave)
+        for (auto note : ordered)
+            append(note + octave * 12);
+
+    const int runLength = length;
+
+    switch (compiledMode)
+    {
+        case down:
+            std::reverse(cycle.begin(), cycle.begin() + runLength);
+            break;
+
+        case upDown:
+            // Back down without repeating the top or bottom note
+            for (int i = runLength - 2; i > 0; --i)
+                append(cycle[static_cast<size_t>(i)]);
+            break;
+
+        default: // Up, Random (draws from the ascending run) and As Played
+            break;
+    }
+}
+
+int ArpPattern::next()
+{
+    if (length == 0)
+        return -1;
+
+    if (compiledMode == random)
+        return cycle[static_cast<size_t>(generator.nextInt(length))];
+
+    const int note = cycle[static_cast<size_t>(position)];
+    position = (position + 1) % length;
+    return note;
+}
@@ -0,0 +1,211 @@
+#include "CompiledPresetBank.h"
+#include <cmath>
+#include <limits>
+
+static_assert(sizeof(CompiledPresetBank::Header) == 64, "Preset bank header layout is fixed");
+
+namespace
+{
+    const juce::Array<juce::var>* presetArray(const juce::var& bank)
+    {
+        if (auto* obj = bank.getDynamicObject())
+            return obj->getProperty("presets").getArray();
+        return nullptr;
+    }
+}
+
+std::shared_ptr<const CompiledPresetBank> CompiledPresetBank::openOrCompile(const juce::File& binaryFile,
+                                                                            const juce::File& systemJSON,
+                                                                            const juce::File& userJSON,
+                                                                            SharedResourceCache& cache)
+{
+    const auto stamp = stampOf(systemJSON, userJSON);
+    std::shared_ptr<CompiledPresetBank> bank(new CompiledPresetBank());
+
+    // Up to date: map the existing file
+    if (binaryFile.existsAsFile())
+    {
+        auto mapped = std::make_unique<juce::MemoryMappedFile>(binaryFile, juce::MemoryMappedFile::readOnly);
+        if (mapped->getData() != nullptr && bank->attach(mapped->getData(), mapped->getSize(), stamp))
+        {
+            bank->mappedFile = std::move(mapped);
+            return bank;
+        }
+    }
+
+    // Stale or missing: compile from JSON and write it atomically
+    auto compiled = compile(cache.getJSON(systemJSON), cache.getJSON(userJSON), stamp);
+
+    juce::TemporaryFile temp(binaryFile);
+    if (temp.getFile().replaceWithData(compiled.getData(), compiled.getSize()) && temp.overwriteTargetFileWithTemporary())
+    {
+        auto mapped = std::make_unique<juce::MemoryMappedFile>(binaryFile, juce::MemoryMappedFile::readOnly);
+        if (mapped->getData() != nullptr && bank->attach(mapped->getData(), mapped->getSize(), stamp))
+        {
+            bank->mappedFile = std::move(mapped);
+            return bank;
+        }
+    }
+
+    bank->ownedData = std::move(compiled);
+    bank->attach(bank->ownedData.getData(), bank->ownedData.getSize(), stamp);
+    return bank;
+}
+
+juce::String CompiledPresetBank::getName(int index) const
+{
+    if (!juce::isPositiveAndBelow(index, getNumPresets()))
+        return {};
+
+    return juce::String::fromUTF8(strings + stringOffsets[index * 2]);
+}
+
+juce::String CompiledPresetBank::getDescription(int index) const
+{
+    if (!juce::isPositiveAndBelow(index, getNumPresets()))
+        return {};
+
+    return juce::String::fromUTF8(strings + stringOffsets[index * 2 + 1]);
+}
+
+const float* CompiledPresetBank::getValues(int index) const
+{
+    if (!juce::isPositiveAndBelow(index, getNumPresets()))
+        return nullptr;
+
+    return rows + static_cast<size_t>(index) * Param::numParams;
+}
+
+bool CompiledPresetBank::attach(const void* data, size_t size, const SourceStamp& expected)
+{
+    if (size < sizeof(Header))
+        return false;
+
+    const auto* h = static_cast<const Header*>(data);
+    if (h->magic != kMagic || h->version != kVersion || h->schemaHash != schemaHash()
+        || h->numParams != static_cast<uint32_t>(Param::numParams)
+        || h->systemModified != expected.systemModified || h->systemSize != expected.systemSize
+        || h->userModified != expected.userModified || h->userSize != expected.userSize)
+        return false;
+
+    const size_t rowsSize = static_cast<size_t>(h->numPresets) * Param::numParams * sizeof(float);
+    const size_t offsetsSize = static_cast<size_t>(h->numPresets) * 2 * sizeof(uint32_t);
+    const size_t stringTableEnd = static_cast<size_t>(h->stringTableOffset) + h->stringTableSize;
+
+    if (h->stringTableOffset != sizeof(Header) + rowsSize + offsetsSize || stringTableEnd > size
+        || h->stringTableSize == 0 || h->numSystemPresets > h->numPresets)
+        return false;
+
+    const auto* bytes = static_cast<const char*>(data);
+    if (bytes[stringTableEnd - 1] != 0)
+        return false; // Every string must be terminated inside the table
+
+    const auto* offsets = reinterpret_cast<const uint32_t*>(bytes + sizeof(Header) + rowsSize);
+    for (uint32_t i = 0; i < h->numPresets * 2; ++i)
+        if (offsets[i] >= h->stringTableSize)
+            return false;
+
+    header = h;
+    rows = reinterpret_cast<const float*>(bytes + sizeof(Header));
+    stringOffsets = offsets;
+    strings = bytes + h->stringTableOffset;
+    return true;
+}
+
+uint32_t CompiledPresetBank::schemaHash()
+{
+    // Reordering or renaming parameters invalidates old banks
+    return Param::schemaHash();
+}
+
+CompiledPresetBank::SourceStamp CompiledPresetBank::stampOf(const juce::File& systemJSON, const juce::File& userJSON)
+{
+    SourceStamp stamp;
+    if (systemJSON.existsAsFile())
+    {
+        stamp.systemModified = systemJSON.getLastModificationTime().toMilliseconds();
+        stamp.systemSize = systemJSON.getSize();
+    }
+    if (userJSON.existsAsFile())
+    {
+        stamp.userModified = userJSON.getLastModificationTime().toMilliseconds();
+        stamp.userSize = userJSON.getSize();
+    }
+    return stamp;
+}
+
+juce::MemoryBlock CompiledPresetBank::compile(const juce::var& systemPresets, const juce::var& userPresets, const SourceStamp& stamp)
+{
+    juce::Array<juce::var> presets;
+    int numSystem = 0;
+
+    if (auto* arr = presetArray(systemPresets))
+    {
+        presets.addArray(*arr);
+        numSystem = arr->size();
+    }
+    if (auto* arr = presetArray(userPresets))
+        presets.addArray(*arr);
+
+    juce::MemoryOutputStream rowData, offsetData, stringData;
+    stringData.writeByte(0); // Offset 0 is the empty string
+
+    auto addString = [&stringData](const juce::String& text) -> uint32_t
+    {
+        if (text.isEmpty())
+            return 0;
+
+        const auto offset = static_cast<uint32_t>(stringData.getDataSize());
+        stringData.write(text.toRawUTF8(), text.getNumBytesAsUTF8());
+        stringData.writeByte(0);
+        return offset;
+    };
+
+    for (const auto& preset : presets)
+    {
+        auto* presetObj = preset.getDynamicObject();
+
+        // Same rules as loading from JSON: legacy keys, then skip or fall back to the default
+        for (const auto& spec : Param::kSpecs)
+        {
+            float value = std::numeric_limits<float>::quiet_NaN();
+
+            if (presetObj != nullptr && spec.presetKey != nullptr)
+            {
+                juce::var stored = presetObj->getProperty(spec.presetKey);
+                if (stored.isVoid() && spec.legacyPresetKey != nullptr)
+                    stored = presetObj->getProperty(spec.legacyPresetKey);
+
+                if (!stored.isVoid())
+                    value = spec.isDiscrete() ? static_cast<float>(static_cast<int>(stored)) : static_cast<float>(stored);
+                else if (spec.missing == Param::Missing::UseDefault)
+                    value = spec.defaultValue;
+            }
+
+            rowData.writeFloat(value);
+        }
+
+        offsetData.writeInt(static_cast<int>(addString(presetObj != nullptr ? presetObj->getProperty("name").toString() : juce::String())));
+        offsetData.writeInt(static_cast<int>(addString(presetObj != nullptr ? presetObj->getProperty("description").toString() : juce::String())));
+    }
+
+    Header h {};
+    h.magic = kMagic;
+    h.version = kVersion;
+    h.schemaHash = schemaHash();
+    h.numParams = static_cast<uint32_t>(Param::numParams);
+    h.numPresets = static_cast<uint32_t>(presets.size());
+    h.numSystemPresets = static_cast<uint32_t>(numSystem);
+    h.stringTableOffset = static_cast<uint32_t>(sizeof(Header) + rowData.getDataSize() + offsetData.getDataSize());
+    h.stringTableSize = static_cast<uint32_t>(stringData.getDataSize());
+    h.systemModified = stamp.systemModified;
+    h.systemSize = stamp.systemSize;
+    h.userModified = stamp.userModified;
+    h.userSize = stamp.userSize;
+
+    juce::MemoryBlock block(&h, sizeof(Header));
+    block.append(rowData.getData(), rowData.getDataSize());
+    block.append(offsetData.getData(), offsetData.getDataSize());
+    block.append(stringData.getData(), stringData.getDataSize());
+    return block;
+}
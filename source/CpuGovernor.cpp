@@ -0,0 +1,115 @@
+#include "CpuGovernor.h"
+
+void CpuGovernor::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    load = 0.0f;
+    samplesSinceChange = 0.0;
+    samplesBelowThreshold = 0.0;
+    smoothedLoad.store(0.0f, std::memory_order_relaxed);
+}
+
+void CpuGovernor::setEnabled(bool shouldBeEnabled)
+{
+    if (enabled == shouldBeEnabled)
+        return;
+
+    enabled = shouldBeEnabled;
+
+    // Switching the governor off restores full quality straight away
+    if (!enabled && getQualityStep() != fullQuality)
+        setStep(fullQuality, load);
+}
+
+int CpuGovernor::update(double elapsedSeconds, int numSamples)
+{
+    if (numSamples <= 0)
+        return getQualityStep();
+
+    const double deadlineSeconds = numSamples / sampleRate;
+    const float blockLoad = static_cast<float>(elapsedSeconds / deadlineSeconds);
+
+    // React quickly to spikes, relax slowly
+    const float smoothing = blockLoad > load ? 0.5f : 0.05f;
+    load += (blockLoad - load) * smoothing;
+    smoothedLoad.store(load, std::memory_order_relaxed);
+
+    samplesSinceChange += numSamples;
+
+    if (!enabled)
+        return getQualityStep();
+
+    const int step = getQualityStep();
+
+    if (load > kStepDownLoad)
+    {
+        samplesBelowThreshold = 0.0;
+
+        // Give the previous drop a moment to take effect before dropping again
+        if (step < numQualitySteps - 1 && samplesSinceChange >= kMinSecondsBetweenDrops * sampleRate)
+            setStep(step + 1, load);
+    }
+    else if (load < kStepUpLoad)
+    {
+        samplesBelowThreshold += numSamples;
+
+        if (step > fullQuality && samplesBelowThreshold >= kRecoverySeconds * sampleRate)
+        {
+            setStep(step - 1, load);
+            samplesBelowThreshold = 0.0;
+        }
+    }
+    else
+    {
+        samplesBelowThreshold = 0.0;
+    }
+
+    return getQualityStep();
+}
+
+void CpuGovernor::setStep(int newStep, float triggerLoad)
+{
+    const int oldStep = getQualityStep();
+    qualityStep.store(newStep, std::memory_order_relaxed);
+    samplesSinceChange = 0.0;
+
+    // Pack: [timeMs:32][load permille:16][from:8][to:8]
+    const auto loadPermille = static_cast<uint64_t>(juce::jlimit(0, 0xffff, juce::roundToInt(triggerLoad * 1000.0f)));
+    const uint64_t entry = (static_cast<uint64_t>(juce::Time::getMillisecondCounter()) << 32)
+                           | (loadPermille << 16)
+                           | (static_cast<uint64_t>(oldStep & 0xff) << 8)
+                           | static_cast<uint64_t>(newStep & 0xff);
+
+    const int index = historyCount.load(std::memory_order_relaxed);
+    history[index % kHistorySize].store(entry, std::memory_order_relaxed);
+    historyCount.store(index + 1, std::memory_order_release);
+}
+
+int CpuGovernor::getHistory(Change* dest, int maxChanges) const
+{
+    const int count = historyCount.load(std::memory_order_acquire);
+    const int available = juce::jmin(count, kHistorySize, maxChanges);
+
+    for (int i = 0; i < available; ++i)
+    {
+        const uint64_t entry = history[(count - 1 - i) % kHistorySize].load(std::memory_order_relaxed);
+        dest[i].timeMs = static_cast<juce::uint32>(entry >> 32);
+        dest[i].load = static_cast<float>((entry >> 16) & 0xffff) / 1000.0f;
+        dest[i].fromStep = static_cast<int>((entry >> 8) & 0xff);
+        dest[i].toStep = static_cast<int>(entry & 0xff);
+    }
+
+    return available;
+}
+
+juce::String CpuGovernor::getStepName(int step)
+{
+    switch (step)
+    {
+        case fullQuality:    return "Full quality";
+        case reducedUnison:  return "Unison reduced";
+        case reducedLFORate: return "LFO control rate";
+        case reducedVoices:  return "Voices halved";
+        default:             return "Unknown";
+    }
+}
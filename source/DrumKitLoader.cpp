@@ -0,0 +1,147 @@
+#include "DrumKitLoader.h"
+
+namespace
+{
+    // File name prefix for each DrumSampler lane
+    const char* const lanePrefixes[DrumSampler::numLanes] = { "Kick", "Snare", "HatClosed", "HatOpen" };
+    const char* const audioFileWildcard = "*.wav;*.aif;*.aiff;*.flac;*.ogg";
+}
+
+DrumKitLoader::DrumKitLoader(DrumSampler& s, const juce::File& defaultDir, const juce::File& kitsDir)
+    : juce::Thread("Drum kit loader"),
+      sampler(s),
+      defaultKitDirectory(defaultDir),
+      kitsDirectory(kitsDir)
+{
+    startThread();
+}
+
+DrumKitLoader::~DrumKitLoader()
+{
+    signalThreadShouldExit();
+    wakeUp.signal();
+    stopThread(4000);
+}
+
+juce::StringArray DrumKitLoader::getKitNames() const
+{
+    const juce::ScopedLock sl(kitListLock);
+
+    juce::StringArray names;
+    for (const auto& kit : kitList)
+        names.add(kit.name);
+    return names;
+}
+
+void DrumKitLoader::selectKit(int index)
+{
+    selectedKit = juce::jmax(0, index);
+    wakeUp.signal();
+}
+
+void DrumKitLoader::rescan()
+{
+    scanRequested = true;
+    wakeUp.signal();
+}
+
+void DrumKitLoader::setSampleRate(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    wakeUp.signal();
+}
+
+void DrumKitLoader::run()
+{
+    while (!threadShouldExit())
+    {
+        sampler.collectRetiredKits();
+
+        if (scanRequested.exchange(false))
+        {
+            scanKits();
+            loadedKit = -1; // Indices may have moved
+        }
+
+        const double rate = sampleRate.load();
+        const int wanted = selectedKit.load();
+
+        if (rate > 0.0 && (wanted != loadedKit || rate != builtSampleRate))
+        {
+            KitLocation location;
+            bool found = false;
+            {
+                const juce::ScopedLock sl(kitListLock);
+                if (juce::isPositiveAndBelow(wanted, kitList.size()))
+                {
+                    location = kitList.getReference(wanted);
+                    found = true;
+                }
+            }
+
+            if (found)
+            {
+                // Find files only when the kit itself changed; a new rate just asks for other versions
+                if (wanted != loadedKit)
+                    findLaneFiles(location);
+
+                auto kit = std::make_unique<DrumSampler::Kit>();
+                kit->name = location.name;
+                kit->sampleRate = rate;
+                for (int lane = 0; lane < DrumSampler::numLanes; ++lane)
+                    if (laneFiles[lane] != juce::File())
+                        kit->lanes[lane] = sharedResources->getAudio(laneFiles[lane], rate);
+
+                sampler.postKit(std::move(kit));
+            }
+
+            // Don't retry until the selection, rate or kit list changes
+            loadedKit = wanted;
+            builtSampleRate = rate;
+        }
+
+        wakeUp.wait(kRetireCheckMs);
+    }
+
+    sampler.collectRetiredKits();
+}
+
+void DrumKitLoader::scanKits()
+{
+    juce::Array<KitLocation> found;
+
+    if (defaultKitDirectory.isDirectory())
+        found.add({ "Default", defaultKitDirectory });
+
+    if (kitsDirectory.isDirectory())
+    {
+        auto folders = kitsDirectory.findChildFiles(juce::File::findDirectories, false);
+        folders.sort();
+
+        for (const auto& folder : folders)
+            found.add({ folder.getFileName(), folder });
+    }
+
+    const juce::ScopedLock sl(kitListLock);
+    kitList.swapWith(found);
+}
+
+void DrumKitLoader::findLaneFiles(const KitLocation& location)
+{
+    auto files = location.directory.findChildFiles(juce::File::findFiles, false, audioFileWildcard);
+    files.sort();
+
+    for (int lane = 0; lane < DrumSampler::numLanes; ++lane)
+    {
+        laneFiles[lane] = juce::File();
+
+        for (const auto& file : files)
+        {
+            if (file.getFileName().startsWithIgnoreCase(lanePrefixes[lane]))
+            {
+                laneFiles[lane] = file;
+                break;
+            }
+        }
+    }
+}
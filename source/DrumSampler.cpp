@@ -0,0 +1,178 @@
+#include "DrumSampler.h"
+
+DrumSampler::~DrumSampler()
+{
+    collectRetiredKits();
+    delete pendingKit.exchange(nullptr);
+    delete previousKit;
+    delete currentKit;
+}
+
+void DrumSampler::reset()
+{
+    for (auto& lane : voices)
+        for (auto& voice : lane)
+            voice = Voice();
+
+    triggerCounter = 0;
+}
+
+void DrumSampler::postKit(std::unique_ptr<Kit> kit)
+{
+    // A kit that was never picked up was never seen by the audio thread, so it can go now
+    delete pendingKit.exchange(kit.release());
+}
+
+void DrumSampler::collectRetiredKits()
+{
+    int start1, size1, start2, size2;
+    retireFifo.prepareToRead(retireFifo.getNumReady(), start1, size1, start2, size2);
+
+    for (int i = 0; i < size1; ++i)
+        delete std::exchange(retiredKits[start1 + i], nullptr);
+    for (int i = 0; i < size2; ++i)
+        delete std::exchange(retiredKits[start2 + i], nullptr);
+
+    retireFifo.finishedRead(size1 + size2);
+}
+
+bool DrumSampler::retireKit(Kit* kit)
+{
+    int start1, size1, start2, size2;
+    retireFifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 == 0)
+        return false; // Loader hasn't caught up yet; try again next block
+
+    retiredKits[start1] = kit;
+    retireFifo.finishedWrite(1);
+    return true;
+}
+
+bool DrumSampler::isKitPlaying(const Kit* kit) const
+{
+    for (const auto& lane : voices)
+        for (const auto& voice : lane)
+            if (voice.active && voice.kit == kit)
+                return true;
+
+    return false;
+}
+
+void DrumSampler::applyPendingKit()
+{
+    if (previousKit != nullptr)
+    {
+        if (isKitPlaying(previousKit) || !retireKit(previousKit))
+            return;
+
+        previousKit = nullptr;
+    }
+
+    Kit* incoming = pendingKit.exchange(nullptr);
+    if (incoming == nullptr)
+        return;
+
+    previousKit = currentKit;
+    currentKit = incoming;
+
+    // Hits from the old kit fade out while still reading from it
+    for (auto& lane : voices)
+        for (auto& voice : lane)
+            if (voice.active)
+                choke(voice);
+}
+
+void DrumSampler::trigger(int lane, int sampleOffset)
+{
+    if (lane < 0 || lane >= numLanes || !hasSample(lane))
+        return;
+
+    if (lane == closedHat)
+        for (auto& voice : voices[openHat])
+            if (voice.active)
+                choke(voice);
+
+    // Take a free voice, or steal the oldest one in this lane
+    Voice* target = &voices[lane][0];
+    for (auto& voice : voices[lane])
+    {
+        if (!voice.active)
+        {
+            target = &voice;
+            break;
+        }
+
+        if (voice.age < target->age)
+            target = &voice;
+    }
+
+    target->kit = currentKit;
+    target->active = true;
+    target->position = 0;
+    target->startDelay = juce::jmax(0, sampleOffset);
+    target->fadeRemaining = -1;
+    target->age = ++triggerCounter;
+}
+
+void DrumSampler::choke(Voice& voice)
+{
+    // A hit that hasn't started yet is simply dropped
+    if (voice.startDelay > 0)
+        voice.active = false;
+    else if (voice.fadeRemaining < 0)
+        voice.fadeRemaining = kChokeFadeSamples;
+}
+
+void DrumSampler::render(juce::AudioBuffer<float>& output, int startSample, int numSamples, const float* laneGains)
+{
+    for (int lane = 0; lane < numLanes; ++lane)
+        for (auto& voice : voices[lane])
+            if (voice.active)
+                renderVoice(voice, lane, output, startSample, numSamples, laneGains[lane]);
+
+    // Swap after rendering so hits triggered for this block play from the kit they started with
+    applyPendingKit();
+}
+
+void DrumSampler::renderVoice(Voice& voice, int lane, juce::AudioBuffer<float>& output,
+                              int startSample, int numSamples, float gain)
+{
+    const auto& sample = voice.kit->lanes[lane]->buffer;
+
+    // Wait out the trigger offset
+    const int delay = juce::jmin(voice.startDelay, numSamples);
+    voice.startDelay -= delay;
+    startSample += delay;
+    numSamples -= delay;
+
+    int samplesToAdd = juce::jmin(numSamples, sample.getNumSamples() - voice.position);
+    if (voice.fadeRemaining >= 0)
+        samplesToAdd = juce::jmin(samplesToAdd, voice.fadeRemaining);
+
+    if (samplesToAdd > 0)
+    {
+        for (int channel = 0; channel < output.getNumChannels(); ++channel)
+        {
+            const int sampleChannel = juce::jmin(channel, sample.getNumChannels() - 1);
+            const float* source = sample.getReadPointer(sampleChannel, voice.position);
+
+            if (voice.fadeRemaining >= 0)
+            {
+                const float startGain = gain * static_cast<float>(voice.fadeRemaining) / kChokeFadeSamples;
+                const float endGain = gain * static_cast<float>(voice.fadeRemaining - samplesToAdd) / kChokeFadeSamples;
+                output.addFromWithRamp(channel, startSample, source, samplesToAdd, startGain, endGain);
+            }
+            else
+            {
+                output.addFrom(channel, startSample, source, samplesToAdd, gain);
+            }
+        }
+
+        voice.position += samplesToAdd;
+        if (voice.fadeRemaining >= 0)
+            voice.fadeRemaining -= samplesToAdd;
+    }
+
+    if (voice.position >= sample.getNumSamples() || voice.fadeRemaining == 0)
+        voice.active = false;
+}
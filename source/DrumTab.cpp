@@ -12,6 +12,33 @@ DrumTab::DrumTab(SnorkelSynthAudioProcessor& p)
     enableAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         audioProcessor.getValueTreeState(), "drumenable", enableToggle);
 
+    // Step count (the pattern loops, and the chain advances, after this many steps)
+    stepsSlider.setSliderStyle(juce::Slider::IncDecButtons);
+    stepsSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 40, 20);
+    stepsSlider.setIncDecButtonsMode(juce::Slider::incDecButtonsDraggable_Vertical);
+    addAndMakeVisible(stepsSlider);
+    stepsLabel.setText("Steps", juce::dontSendNotification);
+    stepsLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(stepsLabel);
+    stepsAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        audioProcessor.getValueTreeState(), "drumsteps", stepsSlider);
+
+    // Page shown in the grid
+    pageSlider.setSliderStyle(juce::Slider::IncDecButtons);
+    pageSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 20);
+    pageSlider.setRange(1, 1, 1);
+    pageSlider.setIncDecButtonsMode(juce::Slider::incDecButtonsDraggable_Vertical);
+    pageSlider.onValueChange = [this]()
+    {
+        page = static_cast<int>(pageSlider.getValue()) - 1;
+        updateButtonStates();
+        repaint();
+    };
+    addAndMakeVisible(pageSlider);
+    pageLabel.setText("Page", juce::dontSendNotification);
+    pageLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(pageLabel);
+
     // Create step button grid
     for (int lane = 0; lane < NUM_LANES; ++lane)
     {
@@ -95,13 +122,64 @@ DrumTab::DrumTab(SnorkelSynthAudioProcessor& p)
     sidechainLengthAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         audioProcessor.getValueTreeState(), "drumsidechainlen", sidechainLengthSlider);
 
-    // Pattern selection buttons (1-8)
+    // Sidechain Attack slider (ms)
+    sidechainAttackSlider.setSliderStyle(juce::Slider::RotaryVerticalDrag);
+    sidechainAttackSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    addAndMakeVisible(sidechainAttackSlider);
+
+    sidechainAttackLabel.setText("SC Atk", juce::dontSendNotification);
+    sidechainAttackLabel.setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(sidechainAttackLabel);
+
+    sidechainAttackAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        audioProcessor.getValueTreeState(), "drumsidechainatk", sidechainAttackSlider);
+
+    // Sidechain Hold slider (ms)
+    sidechainHoldSlider.setSliderStyle(juce::Slider::RotaryVerticalDrag);
+    sidechainHoldSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    addAndMakeVisible(sidechainHoldSlider);
+
+    sidechainHoldLabel.setText("SC Hold", juce::dontSendNotification);
+    sidechainHoldLabel.setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(sidechainHoldLabel);
+
+    sidechainHoldAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        audioProcessor.getValueTreeState(), "drumsidechainhold", sidechainHoldSlider);
+
+    // Kit selector
+    kitLabel.setText("Kit", juce::dontSendNotification);
+    kitLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(kitLabel);
+
+    kitSelector.onChange = [this]()
+    {
+        if (kitSelector.getSelectedItemIndex() >= 0)
+            audioProcessor.selectDrumKit(kitSelector.getSelectedItemIndex());
+    };
+    addAndMakeVisible(kitSelector);
+    updateKitSelector();
+
+    // Pattern bank selector (each bank is the next 8 patterns)
+    for (int i = 0; i < NUM_BANKS; ++i)
+        bankSelector.addItem(juce::String::charToString(static_cast<juce::juce_wchar>('A' + i)), i + 1);
+    bank = audioProcessor.currentDrumPatternIndex / NUM_PATTERNS;
+    bankSelector.setSelectedId(bank + 1, juce::dontSendNotification);
+    bankSelector.onChange = [this]()
+    {
+        bank = bankSelector.getSelectedItemIndex();
+        for (int i = 0; i < NUM_PATTERNS; ++i)
+            patternButtons[i].setButtonText(juce::String(bank * NUM_PATTERNS + i + 1));
+        updatePatternButtonStates();
+    };
+    addAndMakeVisible(bankSelector);
+
+    // Pattern selection buttons (8 of the selected bank)
     for (int i = 0; i < NUM_PATTERNS; ++i)
     {
-        patternButtons[i].setButtonText(juce::String(i + 1));
+        patternButtons[i].setButtonText(juce::String(bank * NUM_PATTERNS + i + 1));
         patternButtons[i].setColour(juce::TextButton::buttonColourId, juce::Colour(0xff404040));
         patternButtons[i].setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xff0088ff));
-        patternButtons[i].onClick = [this, i]() { onPatternButtonClicked(i); };
+        patternButtons[i].onClick = [this, i]() { onPatternButtonClicked(bank * NUM_PATTERNS + i); };
         addAndMakeVisible(patternButtons[i]);
     }
     updatePatternButtonStates();
@@ -128,6 +206,21 @@ DrumTab::DrumTab(SnorkelSynthAudioProcessor& p)
         audioProcessor.getValueTreeState(), "drumchainsteps", chainStepsSlider);
     chainStepsSlider.onValueChange = [this]() { resized(); };
 
+    // Chain bank (stored with the patterns, so the chain step parameters keep their 1-8 range)
+    for (int i = 0; i < NUM_BANKS; ++i)
+        chainBankSelector.addItem(juce::String::charToString(static_cast<juce::juce_wchar>('A' + i)), i + 1);
+    chainBankSelector.setSelectedId(audioProcessor.patternStore.getCurrent().drumChainBank + 1, juce::dontSendNotification);
+    chainBankSelector.onChange = [this]()
+    {
+        const int chainBank = chainBankSelector.getSelectedItemIndex();
+        if (chainBank >= 0)
+            audioProcessor.patternStore.edit([chainBank](PatternData& patterns) { patterns.drumChainBank = chainBank; });
+    };
+    addAndMakeVisible(chainBankSelector);
+    chainBankLabel.setText("Bank", juce::dontSendNotification);
+    chainBankLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(chainBankLabel);
+
     const char* chainStepParamIds[] = {
         "drumchainstep1", "drumchainstep2", "drumchainstep3", "drumchainstep4",
         "drumchainstep5", "drumchainstep6", "drumchainstep7", "drumchainstep8"
@@ -136,7 +229,7 @@ DrumTab::DrumTab(SnorkelSynthAudioProcessor& p)
     {
         chainStepSliders[i].setSliderStyle(juce::Slider::IncDecButtons);
         chainStepSliders[i].setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 30);
-        chainStepSliders[i].setRange(1, 8, 1);
+        chainStepSliders[i].setRange(1, NUM_PATTERNS, 1);
         chainStepSliders[i].setValue(1);
         chainStepSliders[i].setIncDecButtonsMode(juce::Slider::incDecButtonsDraggable_Vertical);
         chainStepSliders[i].setColour(juce::Slider::textBoxBackgroundColourId, juce::Colour(0xff404040));
@@ -151,6 +244,7 @@ DrumTab::DrumTab(SnorkelSynthAudioProcessor& p)
     }
 
     // Load initial button states
+    updatePageRange();
     updateButtonStates();
 
     // Start timer to update current step visualization
@@ -182,11 +276,11 @@ void DrumTab::paint(juce::Graphics& g)
         g.drawText(laneNames[lane], 10, y, 50, buttonSize, juce::Justification::centredRight);
     }
 
-    // Highlight current drum step in grid
-    if (currentStep >= 0 && currentStep < NUM_STEPS)
+    // Highlight current drum step in grid when it's on the shown page
+    if (currentStep >= 0 && currentStep / NUM_STEPS == page)
     {
         g.setColour(juce::Colours::orange.withAlpha(0.3f));
-        int x = 70 + currentStep * 50;
+        int x = 70 + (currentStep % NUM_STEPS) * 50;
         int height = NUM_LANES * verticalSpacing;
         g.fillRect(x, startY, buttonSize, height);
     }
@@ -234,6 +328,14 @@ void DrumTab::resized()
     enableToggle.setBounds(20, controlY, 25, controlHeight);
     enableLabel.setBounds(50, controlY, 60, controlHeight);
 
+    stepsLabel.setBounds(120, controlY, 45, controlHeight);
+    stepsSlider.setBounds(170, controlY, 80, controlHeight);
+    pageLabel.setBounds(260, controlY, 40, controlHeight);
+    pageSlider.setBounds(305, controlY, 75, controlHeight);
+
+    kitLabel.setBounds(getWidth() - 250, controlY, 40, controlHeight);
+    kitSelector.setBounds(getWidth() - 205, controlY, 180, controlHeight);
+
     // Step button grid
     const int startX = 70;
     const int startY = 60;
@@ -283,6 +385,12 @@ void DrumTab::resized()
     sidechainLengthSlider.setBounds(sidechainX + dialSpacing, dialY, knobSize, knobSize);
     sidechainLengthLabel.setBounds(sidechainX + dialSpacing, dialY + knobSize, knobSize, labelHeight);
 
+    sidechainAttackSlider.setBounds(sidechainX + 2 * dialSpacing, dialY, knobSize, knobSize);
+    sidechainAttackLabel.setBounds(sidechainX + 2 * dialSpacing, dialY + knobSize, knobSize, labelHeight);
+
+    sidechainHoldSlider.setBounds(sidechainX + 3 * dialSpacing, dialY, knobSize, knobSize);
+    sidechainHoldLabel.setBounds(sidechainX + 3 * dialSpacing, dialY + knobSize, knobSize, labelHeight);
+
     // Pattern selection buttons (centered below dials)
     const int patternButtonWidth = 40;
     const int patternButtonHeight = 30;
@@ -291,6 +399,7 @@ void DrumTab::resized()
     const int patternY = dialY + knobSize + labelHeight + 15;
     const int patternStartX = (getWidth() - totalPatternWidth) / 2;
 
+    bankSelector.setBounds(patternStartX - 70, patternY, 55, patternButtonHeight);
     for (int i = 0; i < NUM_PATTERNS; ++i)
     {
         patternButtons[i].setBounds(patternStartX + i * patternButtonSpacing, patternY, patternButtonWidth, patternButtonHeight);
@@ -312,13 +421,15 @@ void DrumTab::resized()
     const int chainStepsY = chainControlY + 55;
 
     // Center controls above chain steps
-    const int controlsWidth = 200;
+    const int controlsWidth = 320;
     const int controlsStartX = (getWidth() - controlsWidth) / 2;
 
     chainEnableToggle.setBounds(controlsStartX, chainControlY, 25, 25);
     chainEnableLabel.setBounds(controlsStartX + 28, chainControlY, 50, 25);
     chainStepsLabel.setBounds(controlsStartX + 90, chainControlY, 45, 25);
     chainStepsSlider.setBounds(controlsStartX + 140, chainControlY, 75, 25);
+    chainBankLabel.setBounds(controlsStartX + 220, chainControlY, 40, 25);
+    chainBankSelector.setBounds(controlsStartX + 265, chainControlY, 55, 25);
 
     for (int i = 0; i < NUM_CHAIN_STEPS; ++i)
     {
@@ -363,26 +474,52 @@ void DrumTab::timerCallback()
     if (needsRepaint)
         repaint();
 
+    updatePageRange();
+
+    // Follow chain bank changes from a state load
+    const int chainBank = audioProcessor.patternStore.getCurrent().drumChainBank;
+    if (chainBank != chainBankSelector.getSelectedItemIndex())
+        chainBankSelector.setSelectedId(chainBank + 1, juce::dontSendNotification);
+
     // Always update pattern buttons to show pending state
     updatePatternButtonStates();
+
+    updateKitSelector();
 }
 
-void DrumTab::onStepButtonClicked(int lane, int step)
+void DrumTab::onStepButtonClicked(int lane, int column)
 {
-    bool isOn = stepButtons[lane][step].getToggleState();
+    bool isOn = stepButtons[lane][column].getToggleState();
     int patternIdx = audioProcessor.currentDrumPatternIndex;
-    audioProcessor.drumPatterns[patternIdx][lane][step] = isOn ? 1 : 0;
+    const int step = stepForColumn(column);
+    audioProcessor.patternStore.edit([=](PatternData& patterns) { patterns.drums[patternIdx].set(lane, step, isOn); });
+}
+
+void DrumTab::updatePageRange()
+{
+    // One page per 16 steps played
+    const int numSteps = static_cast<int>(audioProcessor.getValueTreeState().getRawParameterValue("drumsteps")->load());
+    if (numSteps == lastNumSteps)
+        return;
+
+    lastNumSteps = numSteps;
+    const int numPages = juce::jmax(1, (numSteps + NUM_STEPS - 1) / NUM_STEPS);
+    pageSlider.setRange(1, numPages, 1);
+    pageSlider.setValue(juce::jmin(page + 1, numPages)); // Notifies if the shown page no longer plays
+    updateButtonStates();
 }
 
 void DrumTab::updateButtonStates()
 {
-    int patternIdx = audioProcessor.currentDrumPatternIndex;
+    // Steps past the step count are dimmed
+    const auto& pattern = audioProcessor.patternStore.getCurrent().drums[audioProcessor.currentDrumPatternIndex];
     for (int lane = 0; lane < NUM_LANES; ++lane)
     {
-        for (int step = 0; step < NUM_STEPS; ++step)
+        for (int column = 0; column < NUM_STEPS; ++column)
         {
-            bool isOn = audioProcessor.drumPatterns[patternIdx][lane][step] != 0;
-            stepButtons[lane][step].setToggleState(isOn, juce::dontSendNotification);
+            const int step = stepForColumn(column);
+            stepButtons[lane][column].setToggleState(pattern.isOn(lane, step), juce::dontSendNotification);
+            stepButtons[lane][column].setAlpha(step < lastNumSteps ? 1.0f : 0.4f);
         }
     }
 }
@@ -400,8 +537,9 @@ void DrumTab::updatePatternButtonStates()
 
     for (int i = 0; i < NUM_PATTERNS; ++i)
     {
-        bool isActive = (i == currentIdx);
-        bool isPending = (i == pendingIdx);
+        const int index = bank * NUM_PATTERNS + i;
+        bool isActive = (index == currentIdx);
+        bool isPending = (index == pendingIdx);
 
         patternButtons[i].setToggleState(isActive, juce::dontSendNotification);
 
@@ -412,3 +550,18 @@ void DrumTab::updatePatternButtonStates()
             patternButtons[i].setColour(juce::TextButton::buttonColourId, juce::Colour(0xff404040));
     }
 }
+
+void DrumTab::updateKitSelector()
+{
+    auto names = audioProcessor.getDrumKitNames();
+    if (names != lastKitNames)
+    {
+        lastKitNames = names;
+        kitSelector.clear(juce::dontSendNotification);
+        kitSelector.addItemList(names, 1);
+    }
+
+    const int selected = audioProcessor.getSelectedDrumKit();
+    if (kitSelector.getSelectedItemIndex() != selected && selected < names.size())
+        kitSelector.setSelectedItemIndex(selected, juce::dontSendNotification);
+}
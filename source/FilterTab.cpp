@@ -5,13 +5,9 @@
 FilterTab::FilterTab(SnorkelSynthAudioProcessor& p)
     : audioProcessor(p)
 {
-    // Configure preset selector - load from JSON
-    juce::StringArray presetNames = audioProcessor.getSynthPresetNames();
-    for (int i = 0; i < presetNames.size(); ++i)
-        presetSelector.addItem(presetNames[i], i + 1);
-
-    if (presetNames.size() > 0)
-        presetSelector.setSelectedId(1); // Select first preset by default
+    // Configure preset selector - filled from the preset banks once they have loaded
+    refreshPresetSelector();
+    audioProcessor.presetBanksChanged.addChangeListener(this);
 
     presetSelector.onChange = [this]
     {
@@ -203,6 +199,29 @@ FilterTab::FilterTab(SnorkelSynthAudioProcessor& p)
 
 FilterTab::~FilterTab()
 {
+    audioProcessor.presetBanksChanged.removeChangeListener(this);
+}
+
+void FilterTab::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    refreshPresetSelector();
+}
+
+void FilterTab::refreshPresetSelector()
+{
+    const bool wasEmpty = presetSelector.getNumItems() == 0;
+    const int selectedIndex = presetSelector.getSelectedItemIndex();
+
+    presetSelector.clear(juce::dontSendNotification);
+    juce::StringArray presetNames = audioProcessor.getSynthPresetNames();
+    for (int i = 0; i < presetNames.size(); ++i)
+        presetSelector.addItem(presetNames[i], i + 1);
+
+    // Select first preset by default (the processor loads it when the banks arrive)
+    if (wasEmpty || selectedIndex < 0)
+        presetSelector.setSelectedItemIndex(0, juce::dontSendNotification);
+    else
+        presetSelector.setSelectedItemIndex(selectedIndex, juce::dontSendNotification);
 }
 
 //==============================================================================
@@ -6,16 +6,9 @@
 MelodySequencerTab::MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSynthAudioProcessorEditor& e)
     : audioProcessor(p), editor(e)
 {
-    // Configure preset selector - load from JSON
-    juce::StringArray presetNames = audioProcessor.getSequencerPresetNames();
-    for (int i = 0; i < presetNames.size(); ++i)
-        presetSelector.addItem(presetNames[i], i + 1);
-
-    if (presetNames.size() > 0)
-    {
-        presetSelector.setSelectedId(1); // Select first preset by default
-        loadPreset(0); // Load the first preset
-    }
+    // Configure preset selector - filled from the preset banks once they have loaded
+    refreshPresetSelector();
+    audioProcessor.presetBanksChanged.addChangeListener(this);
 
     presetSelector.onChange = [this]
     {
@@ -125,12 +118,46 @@ MelodySequencerTab::MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSyn
     // Configure Steps slider (same style as Progression)
     stepsSlider.setSliderStyle(juce::Slider::IncDecButtons);
     stepsSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 40, 20);
-    stepsSlider.setRange(1, 16, 1);
+    stepsSlider.setRange(1, PatternData::maxSteps, 1);
     stepsSlider.setValue(16);
     stepsSlider.setIncDecButtonsMode(juce::Slider::incDecButtonsDraggable_Vertical);
-    stepsSlider.onValueChange = [this]() { editor.showMessage("Steps: " + juce::String((int)stepsSlider.getValue())); };
+    stepsSlider.onValueChange = [this]()
+    {
+        setStepCount(static_cast<int>(stepsSlider.getValue()));
+        editor.showMessage("Steps: " + juce::String((int)stepsSlider.getValue()));
+    };
     addAndMakeVisible(stepsSlider);
 
+    // Configure Pattern selector (switches when the playing pattern next loops)
+    for (int i = 0; i < PatternData::numMelodyPatterns; ++i)
+        patternSelector.addItem(juce::String(i + 1), i + 1);
+    patternSelector.setSelectedId(audioProcessor.currentMelodyPatternIndex + 1, juce::dontSendNotification);
+    patternSelector.onChange = [this]()
+    {
+        audioProcessor.selectMelodyPattern(patternSelector.getSelectedItemIndex());
+        editor.showMessage("Pattern: " + patternSelector.getText());
+    };
+    addAndMakeVisible(patternSelector);
+    patternLabel.setText("Pattern", juce::dontSendNotification);
+    patternLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(patternLabel);
+
+    // Configure Page slider (which 16 steps the grid shows)
+    pageSlider.setSliderStyle(juce::Slider::IncDecButtons);
+    pageSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 20);
+    pageSlider.setRange(1, 1, 1);
+    pageSlider.setIncDecButtonsMode(juce::Slider::incDecButtonsDraggable_Vertical);
+    pageSlider.onValueChange = [this]()
+    {
+        page = static_cast<int>(pageSlider.getValue()) - 1;
+        updateButtonStates();
+        repaint();
+    };
+    addAndMakeVisible(pageSlider);
+    pageLabel.setText("Page", juce::dontSendNotification);
+    pageLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(pageLabel);
+
     // Configure Rate selector
     rateSelector.addItem("1/32", 1);
     rateSelector.addItem("1/32.", 2);
@@ -156,14 +183,14 @@ MelodySequencerTab::MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSyn
     addAndMakeVisible(gateSlider);
 
     // Create 16x8 button grid
-    for (int step = 0; step < NUM_STEPS; ++step)
+    for (int column = 0; column < NUM_STEPS; ++column)
     {
         for (int degree = 0; degree < NUM_SCALE_DEGREES; ++degree)
         {
-            auto& button = stepButtons[step][degree];
+            auto& button = stepButtons[column][degree];
 
-            // Set step and degree for this button
-            button.step = step;
+            // Set column and degree for this button
+            button.step = column;
             button.degree = degree;
 
             // Button text will be set to octave value (updated in updateOctaveDisplay)
@@ -179,9 +206,9 @@ MelodySequencerTab::MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSyn
             button.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
 
             // Add click handler for normal clicks
-            button.onClick = [this, step, degree]()
+            button.onClick = [this, column, degree]()
             {
-                onStepButtonClicked(step, degree);
+                onStepButtonClicked(column, degree);
             };
 
             // Add octave adjust handler for clicks on already-active buttons
@@ -194,12 +221,16 @@ MelodySequencerTab::MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSyn
             };
 
             // Add deactivate handler for middle-third clicks
-            button.onDeactivate = [this, step, degree](int s)
+            button.onDeactivate = [this, degree](int c)
             {
                 // Deactivate this note (clear the bit)
-                stepButtons[s][degree].setToggleState(false, juce::dontSendNotification);
-                audioProcessor.sequencerPattern[s] &= static_cast<uint8_t>(~(1 << degree));
-                updateOctaveDisplayForStep(s);
+                stepButtons[c][degree].setToggleState(false, juce::dontSendNotification);
+                const int step = stepForColumn(c);
+                editMelody([step, degree](PatternData::MelodyPattern& melody)
+                {
+                    melody.noteMask[step] &= static_cast<uint8_t>(~(1 << degree));
+                });
+                updateOctaveDisplayForColumn(c);
             };
 
             addAndMakeVisible(button);
@@ -286,8 +317,6 @@ MelodySequencerTab::MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSyn
     // Attach to parameters
     enableAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         audioProcessor.getValueTreeState(), "seqenabled", enableToggle);
-    stepsAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
-        audioProcessor.getValueTreeState(), "seqsteps", stepsSlider);
     rateAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         audioProcessor.getValueTreeState(), "seqrate", rateSelector);
     gateAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
@@ -295,6 +324,7 @@ MelodySequencerTab::MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSyn
     gateSlider.onValueChange = [this]() { editor.showMessage("Gate: " + juce::String((int)(gateSlider.getValue() * 100)) + "%"); };
 
     // Load initial button states from processor
+    updatePageRange();
     updateButtonStates();
     updateOctaveDisplay();
 
@@ -305,6 +335,7 @@ MelodySequencerTab::MelodySequencerTab(SnorkelSynthAudioProcessor& p, SnorkelSyn
 MelodySequencerTab::~MelodySequencerTab()
 {
     stopTimer();
+    audioProcessor.presetBanksChanged.removeChangeListener(this);
 
     // Clean up custom LookAndFeel from all accent sliders
     for (int step = 0; step < NUM_STEPS; ++step)
@@ -329,11 +360,11 @@ void MelodySequencerTab::paint(juce::Graphics& g)
         g.drawText(degreeLabels[i], 30, y, 30, 40, juce::Justification::centredRight);
     }
 
-    // Highlight current step (extends to cover grid and accent row)
-    if (currentStep >= 0 && currentStep < NUM_STEPS)
+    // Highlight current step when it's on the shown page (extends to cover grid and accent row)
+    if (currentStep >= 0 && currentStep / NUM_STEPS == page)
     {
         g.setColour(juce::Colours::orange.withAlpha(0.3f));
-        int x = 70 + currentStep * 50;
+        int x = 70 + (currentStep % NUM_STEPS) * 50;
         // Extend height to cover: grid (400) + accent fill bar row (55) = 455
         g.fillRect(x, 80, 40, 455);
     }
@@ -442,37 +473,93 @@ void MelodySequencerTab::resized()
 
     accentDriveSlider.setBounds(controlStartX + controlSpacing * 4, controlRowY, knobSize, knobSize);
     accentDriveLabel.setBounds(controlStartX + controlSpacing * 4, controlRowY + knobSize, knobSize, labelHeight);
+
+    // Pattern and page selection (right of the accent dials)
+    const int selectionY = controlRowY + 12;
+    int selectionX = controlStartX + controlSpacing * 5 + 30;
+    patternLabel.setBounds(selectionX, selectionY, 55, elementHeight);
+    selectionX += 55 + gap;
+    patternSelector.setBounds(selectionX, selectionY, 65, elementHeight);
+    selectionX += 65 + gap + 10;
+    pageLabel.setBounds(selectionX, selectionY, 40, elementHeight);
+    selectionX += 40 + gap;
+    pageSlider.setBounds(selectionX, selectionY, 75, elementHeight);
+}
+
+const PatternData::MelodyPattern& MelodySequencerTab::getMelody() const
+{
+    return audioProcessor.patternStore.getCurrent().melody[audioProcessor.currentMelodyPatternIndex];
 }
 
-void MelodySequencerTab::onStepButtonClicked(int step, int degree)
+void MelodySequencerTab::onStepButtonClicked(int column, int degree)
 {
     // Update the sequencer pattern bitmask
-    bool isOn = stepButtons[step][degree].getToggleState();
-    if (isOn)
+    bool isOn = stepButtons[column][degree].getToggleState();
+    const int step = stepForColumn(column);
+    editMelody([=](PatternData::MelodyPattern& melody)
     {
-        // Set the bit for this degree
-        audioProcessor.sequencerPattern[step] |= static_cast<uint8_t>(1 << degree);
-    }
-    else
+        if (isOn)
+        {
+            // Set the bit for this degree
+            melody.noteMask[step] |= static_cast<uint8_t>(1 << degree);
+        }
+        else
+        {
+            // Clear the bit for this degree
+            melody.noteMask[step] &= static_cast<uint8_t>(~(1 << degree));
+        }
+    });
+
+    // Update octave display for this step
+    updateOctaveDisplayForColumn(column);
+}
+
+void MelodySequencerTab::updatePageRange()
+{
+    // One page per 16 steps played
+    const int lastPageSteps = static_cast<int>(audioProcessor.getValueTreeState().getRawParameterValue("seqsteps")->load());
+    const int numSteps = audioProcessor.patternStore.getCurrent().getMelodyLength(lastPageSteps);
+    if (numSteps == lastNumSteps)
+        return;
+
+    lastNumSteps = numSteps;
+    stepsSlider.setValue(numSteps, juce::dontSendNotification);
+    const int numPages = juce::jmax(1, (numSteps + NUM_STEPS - 1) / NUM_STEPS);
+    pageSlider.setRange(1, numPages, 1);
+    pageSlider.setValue(juce::jmin(page + 1, numPages)); // Notifies if the shown page no longer plays
+    updateButtonStates();
+}
+
+void MelodySequencerTab::setStepCount(int numSteps)
+{
+    const int numPages = (numSteps - 1) / NUM_STEPS + 1;
+    if (numPages != audioProcessor.patternStore.getCurrent().melodyPages)
+        audioProcessor.patternStore.edit([numPages](PatternData& patterns) { patterns.melodyPages = numPages; });
+
+    // The host sees only the steps on the last page, as it did when patterns had 16 steps
+    if (auto* stepsParam = audioProcessor.getValueTreeState().getParameter("seqsteps"))
     {
-        // Clear the bit for this degree
-        audioProcessor.sequencerPattern[step] &= static_cast<uint8_t>(~(1 << degree));
+        stepsParam->beginChangeGesture();
+        stepsParam->setValueNotifyingHost(stepsParam->convertTo0to1(static_cast<float>(numSteps - (numPages - 1) * NUM_STEPS)));
+        stepsParam->endChangeGesture();
     }
 
-    // Update octave display for this step
-    updateOctaveDisplayForStep(step);
+    updatePageRange();
 }
 
 void MelodySequencerTab::updateButtonStates()
 {
-    // Update button states from processor (bitmask)
-    for (int step = 0; step < NUM_STEPS; ++step)
+    // Update button states from processor (bitmask); steps past the step count are dimmed
+    const auto& melody = getMelody();
+    for (int column = 0; column < NUM_STEPS; ++column)
     {
-        uint8_t pattern = audioProcessor.sequencerPattern[step];
+        const int step = stepForColumn(column);
+        uint8_t pattern = melody.noteMask[step];
         for (int d = 0; d < NUM_SCALE_DEGREES; ++d)
         {
             bool isActive = (pattern & (1 << d)) != 0;
-            stepButtons[step][d].setToggleState(isActive, juce::dontSendNotification);
+            stepButtons[column][d].setToggleState(isActive, juce::dontSendNotification);
+            stepButtons[column][d].setAlpha(step < lastNumSteps ? 1.0f : 0.4f);
         }
     }
 
@@ -490,10 +577,50 @@ void MelodySequencerTab::timerCallback()
         repaint();
     }
 
+    // Follow pattern switches and step count changes
+    int newPattern = audioProcessor.currentMelodyPatternIndex;
+    if (newPattern != lastMelodyPattern)
+    {
+        lastMelodyPattern = newPattern;
+        if (audioProcessor.pendingMelodyPatternIndex < 0)
+            patternSelector.setSelectedId(newPattern + 1, juce::dontSendNotification);
+        updateButtonStates();
+    }
+    updatePageRange();
+
     // Update octave display periodically
     updateOctaveDisplay();
 }
 
+void MelodySequencerTab::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    refreshPresetSelector();
+}
+
+void MelodySequencerTab::refreshPresetSelector()
+{
+    const bool wasEmpty = presetSelector.getNumItems() == 0;
+    const int selectedIndex = presetSelector.getSelectedItemIndex();
+
+    presetSelector.clear(juce::dontSendNotification);
+    juce::StringArray presetNames = audioProcessor.getSequencerPresetNames();
+    for (int i = 0; i < presetNames.size(); ++i)
+        presetSelector.addItem(presetNames[i], i + 1);
+
+    if (presetNames.isEmpty())
+        return;
+
+    if (wasEmpty)
+    {
+        presetSelector.setSelectedId(1, juce::dontSendNotification); // Select first preset by default
+        loadPreset(0); // Load the first preset
+    }
+    else
+    {
+        presetSelector.setSelectedItemIndex(juce::jmax(0, selectedIndex), juce::dontSendNotification);
+    }
+}
+
 void MelodySequencerTab::loadPreset(int presetIndex)
 {
     // Load preset from JSON via processor
@@ -540,28 +667,42 @@ void MelodySequencerTab::loadPreset(int presetIndex)
 
     if (version >= 2)
     {
-        // New format: pattern is already bitmask, octave is 2D array
-        for (int step = 0; step < NUM_STEPS && step < patternArray->size(); ++step)
+        // New format: pattern is already bitmask, octave is 2D array (published together)
+        editMelody([&](PatternData::MelodyPattern& melody)
         {
-            audioProcessor.sequencerPattern[step] = static_cast<uint8_t>(static_cast<int>((*patternArray)[step]));
-        }
+            // Steps past the preset's length are cleared
+            melody = PatternData::MelodyPattern();
 
-        // Load 2D octave array
-        const juce::Array<juce::var>* octaveArray = presetObj->getProperty("octave").getArray();
-        if (octaveArray != nullptr)
-        {
-            for (int step = 0; step < NUM_STEPS && step < octaveArray->size(); ++step)
+            for (int step = 0; step < PatternData::maxSteps && step < patternArray->size(); ++step)
+            {
+                melody.noteMask[step] = static_cast<uint8_t>(static_cast<int>((*patternArray)[step]));
+            }
+
+            // Load 2D octave array
+            const juce::Array<juce::var>* octaveArray = presetObj->getProperty("octave").getArray();
+            if (octaveArray != nullptr)
             {
-                const juce::Array<juce::var>* stepOctaves = (*octaveArray)[step].getArray();
-                if (stepOctaves != nullptr)
+                for (int step = 0; step < PatternData::maxSteps && step < octaveArray->size(); ++step)
                 {
-                    for (int degree = 0; degree < NUM_SCALE_DEGREES && degree < stepOctaves->size(); ++degree)
+                    const juce::Array<juce::var>* stepOctaves = (*octaveArray)[step].getArray();
+                    if (stepOctaves != nullptr)
                     {
-                        audioProcessor.sequencerOctave[step][degree] = static_cast<int8_t>(static_cast<int>((*stepOctaves)[degree]));
+                        for (int degree = 0; degree < NUM_SCALE_DEGREES && degree < stepOctaves->size(); ++degree)
+                        {
+                            melody.setOctave(step, degree, static_cast<int>((*stepOctaves)[degree]));
+                        }
                     }
                 }
             }
-        }
+
+            // Load step probabilities (older presets have none: every step plays)
+            const juce::Array<juce::var>* probabilityArray = presetObj->getProperty("probability").getArray();
+            if (probabilityArray != nullptr)
+            {
+                for (int step = 0; step < PatternData::maxSteps && step < probabilityArray->size(); ++step)
+                    melody.probability[step] = static_cast<uint8_t>(juce::jlimit(0, 100, static_cast<int>((*probabilityArray)[step])));
+            }
+        });
 
         // Load accent values per step
         const juce::Array<juce::var>* accentsArray = presetObj->getProperty("accents").getArray();
@@ -573,7 +714,7 @@ void MelodySequencerTab::loadPreset(int presetIndex)
                 "seqcutoff9", "seqcutoff10", "seqcutoff11", "seqcutoff12",
                 "seqcutoff13", "seqcutoff14", "seqcutoff15", "seqcutoff16"
             };
-            for (int step = 0; step < NUM_STEPS && step < accentsArray->size(); ++step)
+            for (int step = 0; step < NUM_STEPS && step < accentsArray->size(); ++step) // One per accent parameter
             {
                 auto* param = audioProcessor.getValueTreeState().getParameter(accentParamIds[step]);
                 if (param != nullptr)
@@ -604,32 +745,32 @@ void MelodySequencerTab::loadPreset(int presetIndex)
     }
     else
     {
-        // Old format: pattern is single degree per step, octave is 1D array
-        for (int step = 0; step < NUM_STEPS && step < patternArray->size(); ++step)
+        // Old format: pattern is single degree per step, octave is 1D array (published together)
+        editMelody([&](PatternData::MelodyPattern& melody)
         {
-            int degree = static_cast<int>((*patternArray)[step]);
-            if (degree >= 0 && degree < 8)
-                audioProcessor.sequencerPattern[step] = static_cast<uint8_t>(1 << degree);
-            else
-                audioProcessor.sequencerPattern[step] = 0;
+            // Octave values start at 0 for old format; steps past the preset's length are cleared
+            melody = PatternData::MelodyPattern();
 
-            // Reset octave values to 0 for old format
-            for (int d = 0; d < NUM_SCALE_DEGREES; ++d)
-                audioProcessor.sequencerOctave[step][d] = 0;
-        }
+            for (int step = 0; step < PatternData::maxSteps && step < patternArray->size(); ++step)
+            {
+                int degree = static_cast<int>((*patternArray)[step]);
+                if (degree >= 0 && degree < 8)
+                    melody.noteMask[step] = static_cast<uint8_t>(1 << degree);
+            }
 
-        // Load 1D octave array (apply to all degrees in step)
-        const juce::Array<juce::var>* octaveArray = presetObj->getProperty("octave").getArray();
-        if (octaveArray != nullptr)
-        {
-            for (int step = 0; step < NUM_STEPS && step < octaveArray->size(); ++step)
+            // Load 1D octave array (apply to all degrees in step)
+            const juce::Array<juce::var>* octaveArray = presetObj->getProperty("octave").getArray();
+            if (octaveArray != nullptr)
             {
-                int octaveValue = static_cast<int>((*octaveArray)[step]);
-                // Apply octave to all degrees in this step
-                for (int d = 0; d < NUM_SCALE_DEGREES; ++d)
-                    audioProcessor.sequencerOctave[step][d] = static_cast<int8_t>(octaveValue);
+                for (int step = 0; step < PatternData::maxSteps && step < octaveArray->size(); ++step)
+                {
+                    int octaveValue = static_cast<int>((*octaveArray)[step]);
+                    // Apply octave to all degrees in this step
+                    for (int d = 0; d < NUM_SCALE_DEGREES; ++d)
+                        melody.setOctave(step, d, octaveValue);
+                }
             }
-        }
+        });
     }
 
     // Update button states to reflect loaded pattern
@@ -639,24 +780,25 @@ void MelodySequencerTab::loadPreset(int presetIndex)
 
 void MelodySequencerTab::updateOctaveDisplay()
 {
-    for (int step = 0; step < NUM_STEPS; ++step)
+    for (int column = 0; column < NUM_STEPS; ++column)
     {
-        updateOctaveDisplayForStep(step);
+        updateOctaveDisplayForColumn(column);
     }
 }
 
-void MelodySequencerTab::updateOctaveDisplayForStep(int step)
+void MelodySequencerTab::updateOctaveDisplayForColumn(int column)
 {
-    if (step < 0 || step >= NUM_STEPS)
+    if (column < 0 || column >= NUM_STEPS)
         return;
 
     // Update all buttons in this step column with their individual octave values
+    const auto& melody = getMelody();
     for (int degree = 0; degree < NUM_SCALE_DEGREES; ++degree)
     {
-        if (stepButtons[step][degree].getToggleState())
+        if (stepButtons[column][degree].getToggleState())
         {
             // Get per-note octave value
-            int octaveValue = audioProcessor.sequencerOctave[step][degree];
+            int octaveValue = melody.getOctave(stepForColumn(column), degree);
 
             // Format octave value for display
             juce::String octaveText;
@@ -667,75 +809,85 @@ void MelodySequencerTab::updateOctaveDisplayForStep(int step)
             else
                 octaveText = ""; // Don't show 0
 
-            stepButtons[step][degree].setButtonText(octaveText);
+            stepButtons[column][degree].setButtonText(octaveText);
         }
         else
         {
-            stepButtons[step][degree].setButtonText("");
+            stepButtons[column][degree].setButtonText("");
         }
     }
 }
 
-void MelodySequencerTab::onOctaveUpClicked(int step, int degree)
+void MelodySequencerTab::onOctaveUpClicked(int column, int degree)
 {
-    if (step < 0 || step >= NUM_STEPS || degree < 0 || degree >= NUM_SCALE_DEGREES)
+    if (column < 0 || column >= NUM_STEPS || degree < 0 || degree >= NUM_SCALE_DEGREES)
         return;
 
-    // Increment per-note octave (max +2)
-    int8_t& octave = audioProcessor.sequencerOctave[step][degree];
-    if (octave < 2)
-        octave++;
+    // Increment per-note octave (setOctave stops at +2)
+    const int step = stepForColumn(column);
+    editMelody([step, degree](PatternData::MelodyPattern& melody)
+    {
+        melody.setOctave(step, degree, melody.getOctave(step, degree) + 1);
+    });
 
-    updateOctaveDisplayForStep(step);
+    updateOctaveDisplayForColumn(column);
 }
 
-void MelodySequencerTab::onOctaveDownClicked(int step, int degree)
+void MelodySequencerTab::onOctaveDownClicked(int column, int degree)
 {
-    if (step < 0 || step >= NUM_STEPS || degree < 0 || degree >= NUM_SCALE_DEGREES)
+    if (column < 0 || column >= NUM_STEPS || degree < 0 || degree >= NUM_SCALE_DEGREES)
         return;
 
-    // Decrement per-note octave (min -2)
-    int8_t& octave = audioProcessor.sequencerOctave[step][degree];
-    if (octave > -2)
-        octave--;
+    // Decrement per-note octave (setOctave stops at -2)
+    const int step = stepForColumn(column);
+    editMelody([step, degree](PatternData::MelodyPattern& melody)
+    {
+        melody.setOctave(step, degree, melody.getOctave(step, degree) - 1);
+    });
 
-    updateOctaveDisplayForStep(step);
+    updateOctaveDisplayForColumn(column);
 }
 
 void MelodySequencerTab::onRandomClicked()
 {
     int selectedAlgo = algoSelector.getSelectedId();
+    const int firstStep = stepForColumn(0);
 
-    if (selectedAlgo == 1) // True Rand
-    {
-        generateTrueRandom();
-    }
-    else if (selectedAlgo == 2) // Weighted (random)
+    // The whole new page is published at once
+    editMelody([this, selectedAlgo, firstStep](PatternData::MelodyPattern& melody)
     {
-        generateWeightedRandom(-1); // -1 = random config
-    }
-    else if (selectedAlgo >= 3) // Specific configs (dynamically loaded)
-    {
-        int configIndex = selectedAlgo - 3; // 3->0, 4->1, 5->2, etc.
-        generateWeightedRandom(configIndex);
-    }
-    else
-    {
-        // Fallback to true random
-        generateTrueRandom();
-    }
+        if (selectedAlgo == 1) // True Rand
+        {
+            generateTrueRandom(melody, firstStep);
+        }
+        else if (selectedAlgo == 2) // Weighted (random)
+        {
+            generateWeightedRandom(melody, firstStep, -1); // -1 = random config
+        }
+        else if (selectedAlgo >= 3) // Specific configs (dynamically loaded)
+        {
+            int configIndex = selectedAlgo - 3; // 3->0, 4->1, 5->2, etc.
+            generateWeightedRandom(melody, firstStep, configIndex);
+        }
+        else
+        {
+            // Fallback to true random
+            generateTrueRandom(melody, firstStep);
+        }
+    });
 
     updateButtonStates();
 }
 
-void MelodySequencerTab::generateTrueRandom()
+void MelodySequencerTab::generateTrueRandom(PatternData::MelodyPattern& melody, int firstStep)
 {
     juce::Random random;
+    uint8_t* pattern = melody.noteMask + firstStep;
 
     // Clear all steps first
     for (int step = 0; step < NUM_STEPS; ++step)
     {
-        audioProcessor.sequencerPattern[step] = 0;
+        pattern[step] = 0;
     }
 
     // Randomly decide how many steps to fill (between 4 and 16)
@@ -746,18 +898,19 @@ void MelodySequencerTab::generateTrueRandom()
     {
         int step = random.nextInt(NUM_STEPS);
         int degree = random.nextInt(NUM_SCALE_DEGREES); // Random scale degree 0-7
-        audioProcessor.sequencerPattern[step] = static_cast<uint8_t>(1 << degree);
+        pattern[step] = static_cast<uint8_t>(1 << degree);
     }
 }
 
-void MelodySequencerTab::generateWeightedRandom(int specificConfigIndex)
+void MelodySequencerTab::generateWeightedRandom(PatternData::MelodyPattern& melody, int firstStep, int specificConfigIndex)
 {
     juce::Random random;
+    uint8_t* pattern = melody.noteMask + firstStep;
 
     // Clear all steps first
     for (int step = 0; step < NUM_STEPS; ++step)
     {
-        audioProcessor.sequencerPattern[step] = 0;
+        pattern[step] = 0;
     }
 
     // Load weights from JSON config
@@ -765,7 +918,7 @@ void MelodySequencerTab::generateWeightedRandom(int specificConfigIndex)
     if (configObj == nullptr)
     {
         // Fallback to true random if config not loaded
-        generateTrueRandom();
+        generateTrueRandom(melody, firstStep);
         return;
     }
 
@@ -773,7 +926,7 @@ void MelodySequencerTab::generateWeightedRandom(int specificConfigIndex)
     auto* configsArray = configObj->getProperty("weightedConfigs").getArray();
     if (configsArray == nullptr || configsArray->size() == 0)
     {
-        generateTrueRandom();
+        generateTrueRandom(melody, firstStep);
         return;
     }
 
@@ -792,7 +945,7 @@ void MelodySequencerTab::generateWeightedRandom(int specificConfigIndex)
 
     if (weightedObj == nullptr)
     {
-        generateTrueRandom();
+        generateTrueRandom(melody, firstStep);
         return;
     }
 
@@ -865,7 +1018,7 @@ void MelodySequencerTab::generateWeightedRandom(int specificConfigIndex)
     if (random.nextFloat() < firstStepRootProbability)
     {
         // Force step 0 to be root (bit 0 = degree 0)
-        audioProcessor.sequencerPattern[0] = 1;
+        pattern[0] = 1;
         step0IsRoot = true;
 
         // For root on step 1: octave is always 0 or -1 (50/50)
@@ -881,7 +1034,7 @@ void MelodySequencerTab::generateWeightedRandom(int specificConfigIndex)
         }
     }
 
-    // Generate weighted pattern for all 16 steps
+    // Generate weighted pattern for the page's 16 steps
     for (int step = 0; step < NUM_STEPS; ++step)
     {
         // Skip step 0 if it was already set as root
@@ -911,7 +1064,7 @@ void MelodySequencerTab::generateWeightedRandom(int specificConfigIndex)
 
             if (selectedDegree != -1)
             {
-                audioProcessor.sequencerPattern[step] = static_cast<uint8_t>(1 << selectedDegree);
+                pattern[step] = static_cast<uint8_t>(1 << selectedDegree);
 
                 // Select octave based on degree
                 int selectedOctave = 0;
@@ -958,36 +1111,39 @@ void MelodySequencerTab::onMutateClicked()
 {
     juce::Random random;
 
-    // Pick a random step to mutate
-    int stepToMutate = random.nextInt(NUM_STEPS);
+    // Pick a random step of the shown page to mutate
+    int stepToMutate = stepForColumn(random.nextInt(NUM_STEPS));
 
-    // 50% chance to either change the degree or toggle on/off
-    if (random.nextBool())
-    {
-        // Change to a random degree (or empty)
-        if (random.nextFloat() < 0.2f) // 20% chance to make it empty
-        {
-            audioProcessor.sequencerPattern[stepToMutate] = 0;
-        }
-        else
-        {
-            int degree = random.nextInt(NUM_SCALE_DEGREES);
-            audioProcessor.sequencerPattern[stepToMutate] = static_cast<uint8_t>(1 << degree);
-        }
-    }
-    else
+    editMelody([&](PatternData::MelodyPattern& melody)
     {
-        // Toggle: if empty make it random, if has value make it empty
-        if (audioProcessor.sequencerPattern[stepToMutate] == 0)
+        // 50% chance to either change the degree or toggle on/off
+        if (random.nextBool())
         {
-            int degree = random.nextInt(NUM_SCALE_DEGREES);
-            audioProcessor.sequencerPattern[stepToMutate] = static_cast<uint8_t>(1 << degree);
+            // Change to a random degree (or empty)
+            if (random.nextFloat() < 0.2f) // 20% chance to make it empty
+            {
+                melody.noteMask[stepToMutate] = 0;
+            }
+            else
+            {
+                int degree = random.nextInt(NUM_SCALE_DEGREES);
+                melody.noteMask[stepToMutate] = static_cast<uint8_t>(1 << degree);
+            }
         }
         else
         {
-            audioProcessor.sequencerPattern[stepToMutate] = 0;
+            // Toggle: if empty make it random, if has value make it empty
+            if (melody.noteMask[stepToMutate] == 0)
+            {
+                int degree = random.nextInt(NUM_SCALE_DEGREES);
+                melody.noteMask[stepToMutate] = static_cast<uint8_t>(1 << degree);
+            }
+            else
+            {
+                melody.noteMask[stepToMutate] = 0;
+            }
         }
-    }
+    });
 
     // Update UI to reflect the mutated pattern
     updateButtonStates();
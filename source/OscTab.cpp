@@ -6,13 +6,9 @@
 OscTab::OscTab(SnorkelSynthAudioProcessor& p, SnorkelSynthAudioProcessorEditor& e)
     : audioProcessor(p), editor(e), oscTabs(juce::TabbedButtonBar::TabsAtTop)
 {
-    // Configure preset selector - load from JSON
-    juce::StringArray presetNames = audioProcessor.getSynthPresetNames();
-    for (int i = 0; i < presetNames.size(); ++i)
-        presetSelector.addItem(presetNames[i], i + 1);
-
-    if (presetNames.size() > 0)
-        presetSelector.setSelectedId(1); // Select first preset by default
+    // Configure preset selector - filled from the preset banks once they have loaded
+    refreshPresetSelector();
+    audioProcessor.presetBanksChanged.addChangeListener(this);
 
     presetSelector.onChange = [this]
     {
@@ -347,6 +343,29 @@ OscTab::OscTab(SnorkelSynthAudioProcessor& p, SnorkelSynthAudioProcessorEditor&
 
 OscTab::~OscTab()
 {
+    audioProcessor.presetBanksChanged.removeChangeListener(this);
+}
+
+void OscTab::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    refreshPresetSelector();
+}
+
+void OscTab::refreshPresetSelector()
+{
+    const bool wasEmpty = presetSelector.getNumItems() == 0;
+    const int selectedIndex = presetSelector.getSelectedItemIndex();
+
+    presetSelector.clear(juce::dontSendNotification);
+    juce::StringArray presetNames = audioProcessor.getSynthPresetNames();
+    for (int i = 0; i < presetNames.size(); ++i)
+        presetSelector.addItem(presetNames[i], i + 1);
+
+    // Select first preset by default (the processor loads it when the banks arrive)
+    if (wasEmpty || selectedIndex < 0)
+        presetSelector.setSelectedItemIndex(0, juce::dontSendNotification);
+    else
+        presetSelector.setSelectedItemIndex(selectedIndex, juce::dontSendNotification);
 }
 
 void OscTab::updateFeedback(const juce::String& paramName, float value, const juce::String& unit)
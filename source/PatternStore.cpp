@@ -0,0 +1,72 @@
+#include "PatternStore.h"
+
+PatternStore::PatternStore()
+    : latest(std::make_unique<PatternData>())
+{
+    retired.reserve(8);
+    current.store(latest.get());
+}
+
+PatternStore::~PatternStore()
+{
+    // The processor releases its pin at the end of every block, so nothing is pinned here
+    jassert(hazard.load() == nullptr && copyHazard.load() == nullptr);
+}
+
+const PatternData* PatternStore::pin(std::atomic<const PatternData*>& slot, const std::atomic<const PatternData*>& source)
+{
+    // Re-check after publishing the hazard: if the version is still current, the
+    // writer will see the hazard before it considers deleting that version
+    const PatternData* pinned = source.load();
+    for (;;)
+    {
+        slot.store(pinned);
+        const PatternData* latestNow = source.load();
+        if (latestNow == pinned)
+            return pinned;
+
+        pinned = latestNow;
+    }
+}
+
+const PatternData* PatternStore::acquire()
+{
+    return pin(hazard, current);
+}
+
+void PatternStore::copyLatest(PatternData& destination)
+{
+    const std::lock_guard<std::mutex> lock(copyLock);
+    destination = *pin(copyHazard, current);
+    copyHazard.store(nullptr);
+}
+
+void PatternStore::publish(std::unique_ptr<PatternData> next)
+{
+    next->version = latest->version + 1;
+    retired.push_back(std::move(latest));
+    latest = std::move(next);
+    current.store(latest.get());
+
+    // A version pinned right now is freed by the timer, not left until the next edit
+    reclaim();
+    if (!retired.empty())
+        startTimer(kReclaimIntervalMs);
+}
+
+void PatternStore::reclaim()
+{
+    const PatternData* pinned = hazard.load();
+    const PatternData* copying = copyHazard.load();
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [pinned, copying](const std::unique_ptr<PatternData>& version)
+                                 { return version.get() != pinned && version.get() != copying; }),
+                  retired.end());
+}
+
+void PatternStore::timerCallback()
+{
+    reclaim();
+    if (retired.empty())
+        stopTimer();
+}
@@ -19,6 +19,7 @@ SnorkelSynthAudioProcessorEditor::SnorkelSynthAudioProcessorEditor(SnorkelSynthA
     modulationTab = std::make_unique<ModulationTab>(audioProcessor);
     melodySequencerTab = std::make_unique<MelodySequencerTab>(audioProcessor, *this);
     progressionTab = std::make_unique<ProgressionTab>(audioProcessor);
+    songTab = std::make_unique<SongTab>(audioProcessor);
     drumTab = std::make_unique<DrumTab>(audioProcessor);
 
     // Add tabs to tabbed component
@@ -26,6 +27,7 @@ SnorkelSynthAudioProcessorEditor::SnorkelSynthAudioProcessorEditor(SnorkelSynthA
     tabbedComponent.addTab("Filter", juce::Colour(0xff2a2a2a), filterTab.get(), false);
     tabbedComponent.addTab("Modulation", juce::Colour(0xff2a2a2a), modulationTab.get(), false);
     tabbedComponent.addTab("Sequencer", juce::Colour(0xff2a2a2a), melodySequencerTab.get(), false);
+    tabbedComponent.addTab("Song", juce::Colour(0xff2a2a2a), songTab.get(), false);
     tabbedComponent.addTab("Arpeggiator", juce::Colour(0xff2a2a2a), sequencerTab.get(), false);
     tabbedComponent.addTab("Progression", juce::Colour(0xff2a2a2a), progressionTab.get(), false);
     tabbedComponent.addTab("Drums", juce::Colour(0xff2a2a2a), drumTab.get(), false);
@@ -100,6 +102,14 @@ SnorkelSynthAudioProcessorEditor::SnorkelSynthAudioProcessorEditor(SnorkelSynthA
     messageLabel.setFont(juce::Font(14.0f, juce::Font::bold));
     addAndMakeVisible(messageLabel);
 
+    // Configure CPU load button
+    cpuButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xff2a2a2a));
+    cpuButton.setColour(juce::TextButton::textColourOffId, juce::Colours::lightgreen);
+    cpuButton.setTooltip("CPU load and quality step - click for governor options and history");
+    cpuButton.onClick = [this] { showCpuMenu(); };
+    addAndMakeVisible(cpuButton);
+    updateCpuButton();
+
     // Configure Root Note selector
     rootNoteSelector.addItem("C", 1);
     rootNoteSelector.addItem("C#", 2);
@@ -154,6 +164,9 @@ SnorkelSynthAudioProcessorEditor::SnorkelSynthAudioProcessorEditor(SnorkelSynthA
         audioProcessor.getValueTreeState(), "seqroot", rootNoteSelector);
     scaleAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         audioProcessor.getValueTreeState(), "seqscale", scaleSelector);
+
+    // Refresh CPU display and expire messages
+    startTimerHz(4);
 }
 
 SnorkelSynthAudioProcessorEditor::~SnorkelSynthAudioProcessorEditor()
@@ -166,13 +179,76 @@ SnorkelSynthAudioProcessorEditor::~SnorkelSynthAudioProcessorEditor()
 void SnorkelSynthAudioProcessorEditor::showMessage(const juce::String& message)
 {
     messageLabel.setText(message, juce::dontSendNotification);
-    startTimer(2000); // Clear message after 2 seconds
+    messageClearTime = juce::Time::getMillisecondCounter() + 2000; // Clear message after 2 seconds
 }
 
 void SnorkelSynthAudioProcessorEditor::timerCallback()
 {
-    messageLabel.setText("", juce::dontSendNotification);
-    stopTimer();
+    if (messageClearTime != 0 && juce::Time::getMillisecondCounter() >= messageClearTime)
+    {
+        messageLabel.setText("", juce::dontSendNotification);
+        messageClearTime = 0;
+    }
+
+    updateCpuButton();
+}
+
+void SnorkelSynthAudioProcessorEditor::updateCpuButton()
+{
+    const auto& governor = audioProcessor.getCpuGovernor();
+    const int step = governor.getQualityStep();
+    const int loadPercent = juce::roundToInt(governor.getLoad() * 100.0f);
+
+    cpuButton.setButtonText("CPU " + juce::String(loadPercent) + "%" + (step > 0 ? " Q-" + juce::String(step) : juce::String()));
+    cpuButton.setColour(juce::TextButton::textColourOffId,
+                        step > 0 ? juce::Colours::orange : juce::Colours::lightgreen);
+}
+
+void SnorkelSynthAudioProcessorEditor::showCpuMenu()
+{
+    auto& apvts = audioProcessor.getValueTreeState();
+    auto isOn = [&apvts](const char* paramID) { return apvts.getRawParameterValue(paramID)->load() > 0.5f; };
+
+    const auto& governor = audioProcessor.getCpuGovernor();
+
+    juce::PopupMenu menu;
+    menu.addItem(1, "Parallel voice rendering", true, isOn("parallelrender"));
+    menu.addItem(2, "CPU governor", true, isOn("cpugovernor"));
+
+    menu.addSectionHeader("Quality: " + CpuGovernor::getStepName(governor.getQualityStep()));
+
+    CpuGovernor::Change changes[CpuGovernor::kHistorySize];
+    const int numChanges = governor.getHistory(changes, CpuGovernor::kHistorySize);
+    const auto now = juce::Time::getMillisecondCounter();
+
+    if (numChanges == 0)
+        menu.addItem(3, "No quality changes", false, false);
+
+    for (int i = 0; i < numChanges; ++i)
+    {
+        const auto secondsAgo = static_cast<int>((now - changes[i].timeMs) / 1000);
+        menu.addItem(100 + i,
+                     juce::String(secondsAgo) + "s ago: " + CpuGovernor::getStepName(changes[i].fromStep)
+                         + " -> " + CpuGovernor::getStepName(changes[i].toStep)
+                         + " (load " + juce::String(juce::roundToInt(changes[i].load * 100.0f)) + "%)",
+                     false, false);
+    }
+
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(&cpuButton),
+                       [this](int result)
+                       {
+                           const char* paramID = result == 1 ? "parallelrender"
+                                               : result == 2 ? "cpugovernor" : nullptr;
+                           if (paramID == nullptr)
+                               return;
+
+                           if (auto* param = audioProcessor.getValueTreeState().getParameter(paramID))
+                           {
+                               param->beginChangeGesture();
+                               param->setValueNotifyingHost(param->getValue() > 0.5f ? 0.0f : 1.0f);
+                               param->endChangeGesture();
+                           }
+                       });
 }
 
 //==============================================================================
@@ -184,7 +260,7 @@ void SnorkelSynthAudioProcessorEditor::paint(juce::Graphics& g)
 
 void SnorkelSynthAudioProcessorEditor::resized()
 {
-    // Top bar layout from left to right: Play/Stop | Root | Scale | Swing | Message | BPM | Volume
+    // Top bar layout from left to right: Play/Stop | Root | Scale | Swing | Message | CPU | BPM | Volume
     const int topY = 15;
     const int topHeight = 30;
     int x = 20;
@@ -221,8 +297,13 @@ void SnorkelSynthAudioProcessorEditor::resized()
     bpmLabel.setBounds(bpmStartX, topY, 40, topHeight);
     bpmSlider.setBounds(bpmStartX + 45, topY, 60, topHeight);
 
+    // CPU display before BPM
+    const int cpuWidth = 85;
+    const int cpuX = bpmStartX - cpuWidth - 5;
+    cpuButton.setBounds(cpuX, topY, cpuWidth, topHeight);
+
     // Message label (takes remaining space)
-    messageLabel.setBounds(x, topY, bpmStartX - x - 10, topHeight);
+    messageLabel.setBounds(x, topY, cpuX - x - 10, topHeight);
 
     // Position the tabbed component below the top bar
     tabbedComponent.setBounds(0, 50, getWidth(), getHeight() - 50);
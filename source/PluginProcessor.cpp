@@ -12,530 +12,28 @@ static constexpr const char* kManufacturerName = "SnorkelLab";
 
 // Audio Configuration
 static constexpr int kNumVoices = 8;  // Number of simultaneous notes (polyphony)
+static constexpr int kProcessingQuantum = 32; // Max samples per internal control-rate sub-block
+static constexpr double kPresetFadeSeconds = 0.005; // Each half of a preset switch's crossfade
 
-// Default Parameter Values
-namespace Defaults
-{
-    static constexpr float kCutoff = 1000.0f;
-    static constexpr float kResonance = 0.7f;
-    static constexpr float kEnvMod = 0.5f;
-    static constexpr float kDecay = 0.3f;
-    static constexpr float kAccent = 0.5f;
-    static constexpr float kWaveform = 0.0f;  // 0.0=saw, 1.0=square, morph in between
-    static constexpr float kSubOsc = 0.5f;
-    static constexpr float kDrive = 0.0f;
-    static constexpr float kVolume = 0.5f;
-    static constexpr int   kDelayTime = 1;  // 1/8 note (index 1)
-    static constexpr float kDelayFeedback = 0.3f;
-    static constexpr float kDelayMix = 0.0f; // Off by default
-
-    // Dedicated LFO defaults (each parameter has its own LFO)
-    static constexpr int   kLFORate = 6;     // Default: 1/1 (whole note)
-    static constexpr int   kLFOWaveform = 0; // Default: Sine wave
-    static constexpr float kLFODepth = 0.0f; // Default: Off
-}
-
-//==============================================================================
-// LFO Rate and Waveform Options
-static const juce::StringArray getLFORateOptions()
-{
-    return juce::StringArray{"1/16", "1/8", "1/4", "1/3", "1/2", "3/4", "1/1", "3/2", "2/1", "3/1", "4/1", "6/1", "8/1", "12/1", "16/1"};
-}
-
-static const juce::StringArray getLFOWaveformOptions()
-{
-    return juce::StringArray{"Sine", "Triangle", "Saw Up", "Saw Down", "Square", "Random"};
-}
+// Reduced-quality settings used by the CPU governor
+static constexpr int kGovernorUnisonVoices = 1;       // Unison voices per oscillator once unison is reduced
+static constexpr int kGovernorLFOControlInterval = 32; // Samples between LFO evaluations at control rate
+static constexpr int kGovernorNumVoices = kNumVoices / 2;
 
 //==============================================================================
 SnorkelSynthAudioProcessor::SnorkelSynthAudioProcessor()
     : AudioProcessor(BusesProperties()
                          .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      parameters(*this, nullptr, "PARAMETERS",
-                {
-                    // Main Parameters
-                    std::make_unique<juce::AudioParameterFloat>(
-                        CUTOFF_ID, "Cutoff",
-                        juce::NormalisableRange<float>(20.0f, 5000.0f, 1.0f, 0.3f),
-                        Defaults::kCutoff),
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        RESONANCE_ID, "Resonance",
-                        juce::NormalisableRange<float>(0.0f, 1.5f, 0.01f),
-                        Defaults::kResonance),
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        ENV_MOD_ID, "Env Mod",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        Defaults::kEnvMod),
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        ACCENT_ID, "Accent",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        Defaults::kAccent),
-
-                    // Filter ADSR Parameters
-                    std::make_unique<juce::AudioParameterFloat>(
-                        FILTER_ATTACK_ID, "Filter Attack",
-                        juce::NormalisableRange<float>(0.0f, 2.0f, 0.001f, 0.5f),
-                        0.003f), // Default: 3ms fast attack
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        FILTER_DECAY_ID, "Filter Decay",
-                        juce::NormalisableRange<float>(0.001f, 5.0f, 0.001f, 0.5f),
-                        0.3f), // Default: 300ms
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        FILTER_SUSTAIN_ID, "Filter Sustain",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: no sustain (classic 303 behavior)
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        FILTER_RELEASE_ID, "Filter Release",
-                        juce::NormalisableRange<float>(0.0f, 5.0f, 0.001f, 0.5f),
-                        0.1f), // Default: 100ms
-
-                    // Amplitude ADSR Parameters
-                    std::make_unique<juce::AudioParameterFloat>(
-                        AMP_ATTACK_ID, "Amp Attack",
-                        juce::NormalisableRange<float>(0.0f, 2.0f, 0.001f, 0.5f),
-                        0.003f), // Default: 3ms fast attack
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        AMP_DECAY_ID, "Amp Decay",
-                        juce::NormalisableRange<float>(0.001f, 5.0f, 0.001f, 0.5f),
-                        0.3f), // Default: 300ms
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        AMP_SUSTAIN_ID, "Amp Sustain",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: no sustain (classic 303 behavior)
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        AMP_RELEASE_ID, "Amp Release",
-                        juce::NormalisableRange<float>(0.0f, 5.0f, 0.001f, 0.5f),
-                        0.1f), // Default: 100ms
-
-                    // Oscillator 1
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC1_WAVE_ID, "Osc 1 Wave",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.5f), // Default: Sawtooth (middle)
-
-                    std::make_unique<juce::AudioParameterInt>(
-                        OSC1_COARSE_ID, "Osc 1 Coarse",
-                        -24, 24, 0), // Range: -24 to +24 semitones, default: 0
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC1_FINE_ID, "Osc 1 Fine",
-                        juce::NormalisableRange<float>(-100.0f, 100.0f, 1.0f),
-                        0.0f), // Range: -100 to +100 cents, default: 0
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC1_MIX_ID, "Osc 1 Mix",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.7f), // Default: 0.7
-
-                    // Oscillator 2
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC2_WAVE_ID, "Osc 2 Wave",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.5f), // Default: Sawtooth (middle)
-
-                    std::make_unique<juce::AudioParameterInt>(
-                        OSC2_COARSE_ID, "Osc 2 Coarse",
-                        -24, 24, 0), // Range: -24 to +24 semitones, default: 0
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC2_FINE_ID, "Osc 2 Fine",
-                        juce::NormalisableRange<float>(-100.0f, 100.0f, 1.0f),
-                        0.0f), // Range: -100 to +100 cents, default: 0
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC2_MIX_ID, "Osc 2 Mix",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: 0 (off for old presets)
-
-                    // Oscillator 3 (sub osc by default)
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC3_WAVE_ID, "Osc 3 Wave",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: Sine (left)
-
-                    std::make_unique<juce::AudioParameterInt>(
-                        OSC3_COARSE_ID, "Osc 3 Coarse",
-                        -24, 24, -12), // Range: -24 to +24 semitones, default: -12 (one octave down)
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC3_FINE_ID, "Osc 3 Fine",
-                        juce::NormalisableRange<float>(-100.0f, 100.0f, 1.0f),
-                        0.0f), // Range: -100 to +100 cents, default: 0
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        OSC3_MIX_ID, "Osc 3 Mix",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.5f), // Default: 0.5 (matches old subosc default)
-
-                    // Noise oscillator
-                    std::make_unique<juce::AudioParameterFloat>(
-                        NOISE_TYPE_ID, "Noise Type",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: 0 (white noise)
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        NOISE_DECAY_ID, "Noise Decay",
-                        juce::NormalisableRange<float>(0.0f, 2.0f, 0.01f),
-                        2.0f), // Default: 2.0 (right = no decay, sustained noise)
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        NOISE_MIX_ID, "Noise Mix",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: 0 (off)
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        DRIVE_ID, "Drive",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        Defaults::kDrive),
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        VOLUME_ID, "Volume",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        Defaults::kVolume),
-
-                    std::make_unique<juce::AudioParameterInt>(
-                        GLOBAL_OCTAVE_ID, "Global Octave",
-                        -2, 2, 0), // Range: -2 to +2, default: 0
-
-                    // Analog character parameters
-                    std::make_unique<juce::AudioParameterFloat>(
-                        DRIFT_ID, "Drift",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: 0 (off)
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        PHASE_RANDOM_ID, "Phase Random",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: 0 (off)
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        UNISON_ID, "Unison",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: 0 (off)
-
-                    // Filter & Saturation Enhancement Parameters
-                    std::make_unique<juce::AudioParameterFloat>(
-                        FILTER_FEEDBACK_ID, "Filter Feedback",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default: no feedback
-
-                    std::make_unique<juce::AudioParameterChoice>(
-                        SATURATION_TYPE_ID, "Saturation Type",
-                        juce::StringArray{"Clean", "Warm", "Tube", "Hard", "Acid"},
-                        0), // Default: Clean
-
-                    // Delay Parameters
-                    std::make_unique<juce::AudioParameterChoice>(
-                        DELAY_TIME_ID, "Delay Time",
-                        juce::StringArray{"1/16", "1/16.", "1/16T", "1/8", "1/8.", "1/8T", "1/4", "1/4.", "1/4T", "1/2", "1/2.", "1/1"},
-                        Defaults::kDelayTime),
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        DELAY_FEEDBACK_ID, "Delay Feedback",
-                        juce::NormalisableRange<float>(0.0f, 0.95f, 0.01f),
-                        Defaults::kDelayFeedback),
-
-                    std::make_unique<juce::AudioParameterFloat>(
-                        DELAY_MIX_ID, "Delay Mix",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        Defaults::kDelayMix),
-
-                    // Cutoff LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        CUTOFF_LFO_RATE_ID, "Cutoff LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        CUTOFF_LFO_WAVE_ID, "Cutoff LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        CUTOFF_LFO_DEPTH_ID, "Cutoff LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // Resonance LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        RESONANCE_LFO_RATE_ID, "Resonance LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        RESONANCE_LFO_WAVE_ID, "Resonance LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        RESONANCE_LFO_DEPTH_ID, "Resonance LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // EnvMod LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        ENVMOD_LFO_RATE_ID, "EnvMod LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        ENVMOD_LFO_WAVE_ID, "EnvMod LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        ENVMOD_LFO_DEPTH_ID, "EnvMod LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // Decay LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        DECAY_LFO_RATE_ID, "Decay LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        DECAY_LFO_WAVE_ID, "Decay LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        DECAY_LFO_DEPTH_ID, "Decay LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // Accent LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        ACCENT_LFO_RATE_ID, "Accent LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        ACCENT_LFO_WAVE_ID, "Accent LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        ACCENT_LFO_DEPTH_ID, "Accent LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // Waveform LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        WAVEFORM_LFO_RATE_ID, "Waveform LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        WAVEFORM_LFO_WAVE_ID, "Waveform LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        WAVEFORM_LFO_DEPTH_ID, "Waveform LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // SubOsc LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        SUBOSC_LFO_RATE_ID, "SubOsc LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        SUBOSC_LFO_WAVE_ID, "SubOsc LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        SUBOSC_LFO_DEPTH_ID, "SubOsc LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // Drive LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        DRIVE_LFO_RATE_ID, "Drive LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        DRIVE_LFO_WAVE_ID, "Drive LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        DRIVE_LFO_DEPTH_ID, "Drive LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // Volume LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        VOLUME_LFO_RATE_ID, "Volume LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        VOLUME_LFO_WAVE_ID, "Volume LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        VOLUME_LFO_DEPTH_ID, "Volume LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // DelayMix LFO
-                    std::make_unique<juce::AudioParameterChoice>(
-                        DELAYMIX_LFO_RATE_ID, "DelayMix LFO Rate",
-                        getLFORateOptions(), Defaults::kLFORate),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        DELAYMIX_LFO_WAVE_ID, "DelayMix LFO Wave",
-                        getLFOWaveformOptions(), Defaults::kLFOWaveform),
-                    std::make_unique<juce::AudioParameterFloat>(
-                        DELAYMIX_LFO_DEPTH_ID, "DelayMix LFO Depth",
-                        juce::NormalisableRange<float>(0.0f, 0.5f, 0.01f),
-                        Defaults::kLFODepth),
-
-                    // Arpeggiator parameters
-                    std::make_unique<juce::AudioParameterBool>(
-                        ARP_ONOFF_ID, "Arp On/Off", true), // Default: enabled
-                    std::make_unique<juce::AudioParameterChoice>(
-                        ARP_MODE_ID, "Arp Mode",
-                        juce::StringArray{"Up", "Down", "Up-Down", "Random", "As Played"}, 0),
-                    std::make_unique<juce::AudioParameterChoice>(
-                        ARP_RATE_ID, "Arp Rate",
-                        juce::StringArray{"1/32", "1/32.", "1/16", "1/16.", "1/16T", "1/8", "1/8.", "1/8T", "1/4", "1/4.", "1/4T", "1/2", "1/2.", "1/1"}, 5), // Default to 1/8
-                    std::make_unique<juce::AudioParameterInt>(
-                        ARP_OCTAVES_ID, "Arp Octaves",
-                        1, 4, 2), // 1-4 octaves, default 2
-                    std::make_unique<juce::AudioParameterFloat>(
-                        ARP_GATE_ID, "Arp Gate",
-                        juce::NormalisableRange<float>(0.1f, 1.0f, 0.01f),
-                        0.8f), // Default 80% gate
-                    std::make_unique<juce::AudioParameterInt>(
-                        ARP_OCTAVE_SHIFT_ID, "Arp Octave Shift",
-                        -2, 2, 0), // -2 to +2 octaves, default 0
-                    std::make_unique<juce::AudioParameterFloat>(
-                        ARP_SWING_ID, "Arp Swing",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.0f), // Default 0% swing (straight timing)
-
-                    // Sequencer parameters
-                    std::make_unique<juce::AudioParameterBool>(
-                        SEQ_ENABLED_ID, "Seq Enabled", true), // Default: enabled
-                    std::make_unique<juce::AudioParameterChoice>(
-                        SEQ_ROOT_ID, "Seq Root",
-                        juce::StringArray{"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"}, 0), // Default to C
-                    std::make_unique<juce::AudioParameterChoice>(
-                        SEQ_SCALE_ID, "Seq Scale",
-                        juce::StringArray{"Major", "Minor", "Dorian", "Phrygian", "Lydian", "Mixolydian", "Aeolian", "Locrian", "Harmonic Minor", "Melodic Minor", "Pentatonic Major", "Pentatonic Minor", "Blues"}, 1), // Default to Minor
-                    std::make_unique<juce::AudioParameterInt>(
-                        SEQ_STEPS_ID, "Seq Steps",
-                        1, 16, 16), // Range 1-16, default 16
-                    std::make_unique<juce::AudioParameterChoice>(
-                        SEQ_RATE_ID, "Seq Rate",
-                        juce::StringArray{"1/32", "1/32.", "1/16", "1/16.", "1/16T", "1/8", "1/8.", "1/8T", "1/4", "1/4.", "1/4T", "1/2", "1/2.", "1/1"}, 2), // Default to 1/16
-                    std::make_unique<juce::AudioParameterFloat>(
-                        SEQ_GATE_ID, "Seq Gate",
-                        juce::NormalisableRange<float>(0.1f, 1.0f, 0.01f), 0.8f), // Default 80%
-
-                    // Sequencer per-step octave (16 steps, range -2 to +2, default 0)
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE1_ID, "Seq Octave 1", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE2_ID, "Seq Octave 2", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE3_ID, "Seq Octave 3", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE4_ID, "Seq Octave 4", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE5_ID, "Seq Octave 5", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE6_ID, "Seq Octave 6", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE7_ID, "Seq Octave 7", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE8_ID, "Seq Octave 8", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE9_ID, "Seq Octave 9", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE10_ID, "Seq Octave 10", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE11_ID, "Seq Octave 11", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE12_ID, "Seq Octave 12", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE13_ID, "Seq Octave 13", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE14_ID, "Seq Octave 14", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE15_ID, "Seq Octave 15", -2, 2, 0),
-                    std::make_unique<juce::AudioParameterInt>(SEQ_OCTAVE16_ID, "Seq Octave 16", -2, 2, 0),
-
-                    // Sequencer per-step cutoff modulation (16 steps, range -1.0 to +1.0, default 0.0)
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF1_ID, "Seq Cutoff 1", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF2_ID, "Seq Cutoff 2", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF3_ID, "Seq Cutoff 3", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF4_ID, "Seq Cutoff 4", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF5_ID, "Seq Cutoff 5", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF6_ID, "Seq Cutoff 6", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF7_ID, "Seq Cutoff 7", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF8_ID, "Seq Cutoff 8", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF9_ID, "Seq Cutoff 9", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF10_ID, "Seq Cutoff 10", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF11_ID, "Seq Cutoff 11", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF12_ID, "Seq Cutoff 12", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF13_ID, "Seq Cutoff 13", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF14_ID, "Seq Cutoff 14", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF15_ID, "Seq Cutoff 15", -1.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_CUTOFF16_ID, "Seq Cutoff 16", -1.0f, 1.0f, 0.0f),
-
-                    // Sequencer accent control amounts
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_ACCENT_VOL_ID, "Seq Accent Volume", 0.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_ACCENT_CUTOFF_ID, "Seq Accent Cutoff", 0.0f, 1.0f, 0.5f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_ACCENT_RES_ID, "Seq Accent Resonance", 0.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_ACCENT_DECAY_ID, "Seq Accent Decay", 0.0f, 1.0f, 0.0f),
-                    std::make_unique<juce::AudioParameterFloat>(SEQ_ACCENT_DRIVE_ID, "Seq Accent Drive", 0.0f, 1.0f, 0.0f),
-
-                    // Progression parameters
-                    std::make_unique<juce::AudioParameterBool>(
-                        PROG_ENABLED_ID, "Progression Enabled", true), // Default: enabled
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEPS_ID, "Progression Steps", 1, 16, 4), // Default: 4 steps, max: 16
-                    std::make_unique<juce::AudioParameterChoice>(
-                        PROG_LENGTH_ID, "Progression Length",
-                        juce::StringArray{"1/2", "1", "2", "3", "4"}, 1), // Default: 1 bar
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP1_ID, "Progression Step 1", 1, 8, 1), // Default to scale degree 1
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP2_ID, "Progression Step 2", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP3_ID, "Progression Step 3", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP4_ID, "Progression Step 4", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP5_ID, "Progression Step 5", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP6_ID, "Progression Step 6", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP7_ID, "Progression Step 7", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP8_ID, "Progression Step 8", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP9_ID, "Progression Step 9", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP10_ID, "Progression Step 10", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP11_ID, "Progression Step 11", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP12_ID, "Progression Step 12", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP13_ID, "Progression Step 13", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP14_ID, "Progression Step 14", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP15_ID, "Progression Step 15", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>(
-                        PROG_STEP16_ID, "Progression Step 16", 1, 8, 1),
-
-                    // Global parameters
-                    std::make_unique<juce::AudioParameterFloat>(
-                        GLOBAL_BPM_ID, "BPM",
-                        juce::NormalisableRange<float>(60.0f, 200.0f, 1.0f),
-                        120.0f), // Default 120 BPM
-                    std::make_unique<juce::AudioParameterFloat>(
-                        MASTER_VOLUME_ID, "Master Volume",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-                        0.5f), // Default 50% (12 o'clock)
-
-                    // Drum machine parameters
-                    std::make_unique<juce::AudioParameterBool>("drumenable", "Drum Enable", true),
-                    std::make_unique<juce::AudioParameterFloat>("drumkickvol", "Kick Volume",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.8f),
-                    std::make_unique<juce::AudioParameterFloat>("drumsnarevol", "Snare Volume",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.8f),
-                    std::make_unique<juce::AudioParameterFloat>("drumchatvol", "Closed Hat Volume",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.8f),
-                    std::make_unique<juce::AudioParameterFloat>("drumohatvol", "Open Hat Volume",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.8f),
-                    std::make_unique<juce::AudioParameterFloat>("drummastervol", "Drum Master Volume",
-                        juce::NormalisableRange<float>(0.0f, 2.0f, 0.01f), 1.0f),
-                    std::make_unique<juce::AudioParameterFloat>("drumsidechainmag", "Sidechain Magnitude",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f),
-                    std::make_unique<juce::AudioParameterFloat>("drumsidechainlen", "Sidechain Length",
-                        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f),
-
-                    // Drum chain parameters
-                    std::make_unique<juce::AudioParameterBool>("drumchainenabled", "Drum Chain Enabled", false),
-                    std::make_unique<juce::AudioParameterInt>("drumchainsteps", "Drum Chain Steps", 1, 8, 4),
-                    std::make_unique<juce::AudioParameterInt>("drumchainstep1", "Drum Chain Step 1", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>("drumchainstep2", "Drum Chain Step 2", 1, 8, 2),
-                    std::make_unique<juce::AudioParameterInt>("drumchainstep3", "Drum Chain Step 3", 1, 8, 3),
-                    std::make_unique<juce::AudioParameterInt>("drumchainstep4", "Drum Chain Step 4", 1, 8, 4),
-                    std::make_unique<juce::AudioParameterInt>("drumchainstep5", "Drum Chain Step 5", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>("drumchainstep6", "Drum Chain Step 6", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>("drumchainstep7", "Drum Chain Step 7", 1, 8, 1),
-                    std::make_unique<juce::AudioParameterInt>("drumchainstep8", "Drum Chain Step 8", 1, 8, 1)
-                })
+      parameters(*this, nullptr, "PARAMETERS", createParameterLayout())
 {
+    // Resolve every parameter once so the audio thread can index by Param::Id
+    for (const auto& spec : Param::kSpecs)
+    {
+        paramValues[static_cast<size_t>(spec.index)] = parameters.getRawParameterValue(spec.id);
+        paramObjects[static_cast<size_t>(spec.index)] = parameters.getParameter(spec.id);
+        jassert(paramValues[static_cast<size_t>(spec.index)] != nullptr);
+    }
+
     // Add voices to the synthesizer
     for (int i = 0; i < kNumVoices; ++i)
         synth.addVoice(new AcidVoice());
@@ -543,37 +41,91 @@ SnorkelSynthAudioProcessor::SnorkelSynthAudioProcessor()
     // Add sound
     synth.addSound(new AcidSound());
 
-    // Initialize sequencer pattern with a default melody (C major scale pattern)
-    // Pattern: 1-3-5-7-5-3-1-1 (repeated twice) - stored as bitmasks (bit N = degree N active)
-    const int defaultDegrees[] = {0, 2, 4, 6, 4, 2, 0, 0, 0, 2, 4, 6, 4, 2, 0, 0};
-    for (int i = 0; i < NUM_SEQ_STEPS; ++i)
-        sequencerPattern[i] = static_cast<uint8_t>(1 << defaultDegrees[i]);
+    patternStore.edit([](PatternData& patterns)
+    {
+        // Initialize sequencer pattern with a default melody (C major scale pattern)
+        // Pattern: 1-3-5-7-5-3-1-1 (repeated twice) - stored as bitmasks (bit N = degree N active)
+        // Per-note octave offsets start at 0
+        const int defaultDegrees[] = {0, 2, 4, 6, 4, 2, 0, 0, 0, 2, 4, 6, 4, 2, 0, 0};
+        for (int i = 0; i < 16; ++i)
+            patterns.melody[0].noteMask[i] = static_cast<uint8_t>(1 << defaultDegrees[i]);
+
+        // Initialize default drum patterns (four-to-the-floor kick in patterns 1-4)
+        for (int p = 0; p < 4; ++p)
+        {
+            patterns.drums[p].set(0, 0, true);  // Kick on 1
+            patterns.drums[p].set(0, 4, true);  // Kick on 5
+            patterns.drums[p].set(0, 8, true);  // Kick on 9
+            patterns.drums[p].set(0, 12, true); // Kick on 13
+        }
+    });
+
+    // Preset banks and drum kits load on background threads so construction doesn't
+    // wait on disk; until then the synth runs on the schema's factory defaults
+    juce::File dataDir = getDataDirectory();
+    presetBankLoader = std::make_unique<PresetBankLoader>(dataDir);
+    presetBankLoader->onLoaded = [this](PresetBankLoader::Banks& banks) { applyPresetBanks(banks); };
+    presetBankLoader->load();
+
+    presetJournal->open(dataDir);
+    presetJournal->addListener(this);
+
+    drumKitLoader = std::make_unique<DrumKitLoader>(drumSampler, dataDir.getChildFile("samples"), dataDir.getChildFile("kits"));
+}
 
-    // Initialize per-note octave offsets to 0
-    for (int step = 0; step < NUM_SEQ_STEPS; ++step)
-        for (int degree = 0; degree < NUM_SCALE_DEGREES; ++degree)
-            sequencerOctave[step][degree] = 0;
+SnorkelSynthAudioProcessor::~SnorkelSynthAudioProcessor()
+{
+    presetJournal->removeListener(this);
+}
 
-    // Load presets from JSON files
-    loadPresetsFromJSON();
-    loadDrumSamples();
+//==============================================================================
+juce::AudioProcessorValueTreeState::ParameterLayout SnorkelSynthAudioProcessor::createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
 
-    // Initialize default drum patterns (four-to-the-floor kick in patterns 1-4)
-    for (int p = 0; p < 4; ++p)
+    for (const auto& spec : Param::kSpecs)
     {
-        drumPatterns[p][0][0] = 1;  // Kick on 1
-        drumPatterns[p][0][4] = 1;  // Kick on 5
-        drumPatterns[p][0][8] = 1;  // Kick on 9
-        drumPatterns[p][0][12] = 1; // Kick on 13
+        switch (spec.type)
+        {
+            case Param::Type::Float:
+                layout.add(std::make_unique<juce::AudioParameterFloat>(
+                    spec.id, spec.name,
+                    juce::NormalisableRange<float>(spec.minValue, spec.maxValue, spec.interval, spec.skew),
+                    spec.defaultValue));
+                break;
+
+            case Param::Type::Int:
+                layout.add(std::make_unique<juce::AudioParameterInt>(
+                    spec.id, spec.name,
+                    static_cast<int>(spec.minValue), static_cast<int>(spec.maxValue),
+                    static_cast<int>(spec.defaultValue)));
+                break;
+
+            case Param::Type::Choice:
+            {
+                juce::StringArray choices;
+                for (int i = 0; i < spec.numChoices; ++i)
+                    choices.add(spec.choices[i]);
+
+                layout.add(std::make_unique<juce::AudioParameterChoice>(
+                    spec.id, spec.name, choices, static_cast<int>(spec.defaultValue)));
+                break;
+            }
+
+            case Param::Type::Bool:
+                layout.add(std::make_unique<juce::AudioParameterBool>(
+                    spec.id, spec.name, spec.defaultValue > 0.5f));
+                break;
+        }
     }
 
-    // Load the first synth preset by default
-    if (getSynthPresetNames().size() > 0)
-        loadPresetFromJSON(0);
+    return layout;
 }
 
-SnorkelSynthAudioProcessor::~SnorkelSynthAudioProcessor()
+void SnorkelSynthAudioProcessor::setParamNotifyingHost(Param::Id id, float plainValue)
 {
+    if (auto* p = paramObjects[static_cast<size_t>(id)])
+        p->setValueNotifyingHost(p->convertTo0to1(plainValue));
 }
 
 //==============================================================================
@@ -604,16 +156,20 @@ double SnorkelSynthAudioProcessor::getTailLengthSeconds() const
 
 int SnorkelSynthAudioProcessor::getNumPrograms()
 {
-    return getSynthPresetNames().size();
+    const juce::ScopedLock sl(programLock);
+    return juce::jmax(1, programNames.size()); // Hosts expect at least one program
 }
 
 int SnorkelSynthAudioProcessor::getCurrentProgram()
 {
-    return 0; // Could track current preset if needed
+    const juce::ScopedLock sl(programLock);
+    return currentProgram;
 }
 
 void SnorkelSynthAudioProcessor::setCurrentProgram(int index)
 {
+    initialPresetPending = false;
+
     // Account for the "** User presets **" divider in the preset list
     // The divider appears at position numSystemSynthPresets in the names list
     int actualPresetIndex = index;
@@ -633,15 +189,19 @@ void SnorkelSynthAudioProcessor::setCurrentProgram(int index)
         }
     }
 
+    {
+        const juce::ScopedLock sl(programLock);
+        if (juce::isPositiveAndBelow(index, programNames.size()))
+            currentProgram = index;
+    }
+
     loadPresetFromJSON(actualPresetIndex);
 }
 
 const juce::String SnorkelSynthAudioProcessor::getProgramName(int index)
 {
-    juce::StringArray names = getSynthPresetNames();
-    if (index >= 0 && index < names.size())
-        return names[index];
-    return {};
+    const juce::ScopedLock sl(programLock);
+    return programNames[index]; // Empty string when out of range
 }
 
 void SnorkelSynthAudioProcessor::changeProgramName(int index, const juce::String& newName)
@@ -653,19 +213,31 @@ void SnorkelSynthAudioProcessor::changeProgramName(int index, const juce::String
 void SnorkelSynthAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     synth.setCurrentPlaybackSampleRate(sampleRate);
+    synth.prepare(samplesPerBlock, getTotalNumOutputChannels());
     currentSampleRate = sampleRate;
-
-    // Prepare delay line (max 4 seconds delay)
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = 2;
-
-    delayLine.prepare(spec);
-    delayLine.reset();
-
-    // Allocate delay buffer
-    delayBuffer.resize(samplesPerBlock * 2, 0.0f);
+    preparedBlockSize = juce::jmax(1, samplesPerBlock);
+    transportClock.prepare(sampleRate);
+    cpuGovernor.prepare(sampleRate);
+    presetFadeSamples = juce::jmax(1, juce::roundToInt(sampleRate * kPresetFadeSeconds));
+    voiceParamsValid = false; // Push a full snapshot on the next block
+
+    // Prepare delay (max 4 seconds, the longest division at the slowest tempo)
+    stereoDelay.prepare(sampleRate, samplesPerBlock, 4.0);
+    delayMixCurve.assign(static_cast<size_t>(juce::jmax(1, samplesPerBlock)), 0.0f);
+    delayMixLFO.segmentPosition = -1;
+
+    // Sub-block MIDI, arp/sequencer scratch buffers and dry drum bus, sized up front so processBlock doesn't allocate
+    subBlockMidi.ensureSize(kMidiBufferBytes);
+    arpMidi.ensureSize(kMidiBufferBytes);
+    seqMidi.ensureSize(kMidiBufferBytes);
+    chunkMidi.ensureSize(kMidiBufferBytes);
+    drumBuffer.setSize(juce::jmax(2, getTotalNumOutputChannels(), getTotalNumInputChannels()), samplesPerBlock);
+    sidechainGain.assign(static_cast<size_t>(juce::jmax(1, samplesPerBlock)), 1.0f);
+    sidechainEnvelope.reset();
+
+    // Stop drum voices and have the loader resample the kit to the session rate
+    drumSampler.reset();
+    drumKitLoader->setSampleRate(sampleRate);
 }
 
 void SnorkelSynthAudioProcessor::releaseResources()
@@ -685,9 +257,27 @@ void SnorkelSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                            juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    SNORKEL_RT_SCOPE; // Reports allocations and blocking calls from here on (SNORKEL_RT_SANITIZER builds only)
 
-    // Get BPM from host, or use default for standalone mode
+    if (preparedBlockSize <= 0)
+    {
+        buffer.clear(); // Not prepared yet
+        return;
+    }
+
+    // Time this block against its deadline for the CPU governor. Offline renders have
+    // no deadline: they always run at full quality, so a bounce renders the same every time.
+    const bool offline = isNonRealtime();
+    const auto blockStartTicks = juce::Time::getHighResolutionTicks();
+
+    cpuGovernor.setEnabled(!offline && param(Param::cpuGovernor) > 0.5f);
+    if (cpuGovernor.getQualityStep() != appliedQualityStep)
+        applyQualityStep(cpuGovernor.getQualityStep());
+
+    // Get BPM, time signature and position from host, or use defaults for standalone mode
     bool bpmFromHost = false;
+    bool hostPlaying = false;
+    juce::Optional<double> hostPpq;
     if (auto* playHead = getPlayHead())
     {
         if (auto positionInfo = playHead->getPosition())
@@ -697,193 +287,227 @@ void SnorkelSynthAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                 currentBPM = *positionInfo->getBpm();
                 bpmFromHost = true;
             }
-            // Enable playback when host transport is playing
-            if (positionInfo->getIsPlaying())
-            {
-                isPlaybackActive = true;
-            }
+            if (auto timeSignature = positionInfo->getTimeSignature())
+                transportClock.setTimeSignature(timeSignature->numerator, timeSignature->denominator);
+            if (auto barStart = positionInfo->getPpqPositionOfLastBarStart())
+                transportClock.setBarStart(*barStart);
+
+            hostPlaying = positionInfo->getIsPlaying();
+            hostPpq = positionInfo->getPpqPosition();
         }
     }
 
     // Use global BPM parameter if no host BPM available
     if (!bpmFromHost)
     {
-        currentBPM = parameters.getRawParameterValue(GLOBAL_BPM_ID)->load();
+        currentBPM = param(Param::globalBpm);
     }
 
-    // Clear output buffer
-    buffer.clear();
+    // Pin this block's patterns; editor changes land at the next block's steps
+    // (before chasing the host, which locates the song position in them)
+    activePatterns = patternStore.acquire();
+
+    transportClock.setTempo(currentBPM);
+    followHostTimeline(hostPlaying, hostPpq);
 
-    // Track total playback time for bar synchronization
-    if (isPlaybackActive)
+    // Hosts may send more samples than prepareToPlay announced. Rather than grow
+    // the work buffers here, render such a block in prepared-size pieces.
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= preparedBlockSize)
+    {
+        renderBlock(buffer, midiMessages);
+    }
+    else
     {
-        totalPlaybackTime += buffer.getNumSamples();
+        for (int start = 0; start < numSamples; start += preparedBlockSize)
+        {
+            const int chunkSize = juce::jmin(preparedBlockSize, numSamples - start);
+            juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, chunkSize);
+
+            chunkMidi.clear();
+            chunkMidi.addEvents(midiMessages, start, chunkSize, -start);
+            renderBlock(chunk, chunkMidi);
+        }
     }
 
-    // Update progression step (must be before arp/sequencer)
-    updateProgressionStep(buffer.getNumSamples());
+    patternStore.release();
+    activePatterns = nullptr;
 
-    // Process arpeggiator (modifies MIDI messages)
-    processArpeggiator(midiMessages, buffer.getNumSamples());
+    if (!offline)
+    {
+        const auto elapsedTicks = juce::Time::getHighResolutionTicks() - blockStartTicks;
+        cpuGovernor.update(juce::Time::highResolutionTicksToSeconds(elapsedTicks), buffer.getNumSamples());
+    }
+}
 
-    // Process sequencer (modifies MIDI messages)
-    processSequencer(midiMessages, buffer.getNumSamples());
+void SnorkelSynthAudioProcessor::renderBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // Clear output buffer
+    buffer.clear();
 
-    // Process drum machine (step tracking and sidechain envelope)
-    processDrums(buffer.getNumSamples());
+    const int numSamples = buffer.getNumSamples();
+    jassert(numSamples <= preparedBlockSize);
 
-    // Update voice parameters (after sequencer to get correct currentSeqStep for cutoff modulation)
-    updateVoiceParameters();
+    // Drums render into their own buffer so they can be added after the delay (kept dry)
+    drumBuffer.clear(0, numSamples);
 
-    // Render synthesizer
-    synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    const bool drumEnabled = param(Param::drumEnable) > 0.5f;
+    synth.setParallelRenderingEnabled(param(Param::parallelRender) > 0.5f);
 
-    // Apply sidechain ducking from drum kick
-    if (sidechainEnvelope > 0.001f)
+    // Control-rate work runs once per fixed-size sub-block, and sub-blocks are
+    // also cut at incoming MIDI and at every arp/sequencer/drum/progression
+    // step and gate boundary on the transport clock, so each step starts a
+    // sub-block at its exact sample and nothing depends on the host block size
+    for (int startSample = 0; startSample < numSamples;)
     {
-        float duckAmount = std::max(0.0f, 1.0f - sidechainEnvelope); // 0 = full duck, 1 = no duck
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-        {
-            float* channelData = buffer.getWritePointer(channel);
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-            {
-                channelData[sample] *= duckAmount;
-            }
-        }
-    }
+        int subBlockSize = juce::jmin(kProcessingQuantum, numSamples - startSample);
 
-    // Apply delay effect (before drums, so drums stay dry)
-    float delayMix = parameters.getRawParameterValue(DELAY_MIX_ID)->load();
+        // End the sub-block where the next incoming MIDI event starts
+        auto nextEvent = midiMessages.findNextSamplePosition(startSample + 1);
+        if (nextEvent != midiMessages.cend())
+            subBlockSize = juce::jmin(subBlockSize, (*nextEvent).samplePosition - startSample);
 
-    // Update delay mix LFO settings
-    updateDelayMixLFO();
+        subBlockSize = getSamplesUntilNextStepEvent(subBlockSize);
 
-    if (delayMix > 0.001f || delayMixLFO.depth > 0.001f)
-    {
-        int delayTime = static_cast<int>(parameters.getRawParameterValue(DELAY_TIME_ID)->load());
-        float delayFeedback = parameters.getRawParameterValue(DELAY_FEEDBACK_ID)->load();
-
-        // Calculate delay time in samples based on tempo
-        // Index: 0=1/16, 1=1/16., 2=1/16T, 3=1/8, 4=1/8., 5=1/8T, 6=1/4, 7=1/4., 8=1/4T, 9=1/2, 10=1/2., 11=1/1
-        const double divisions[] = {
-            4.0,        // 1/16
-            4.0/1.5,    // 1/16. (dotted)
-            6.0,        // 1/16T (triplet)
-            2.0,        // 1/8
-            2.0/1.5,    // 1/8. (dotted)
-            3.0,        // 1/8T (triplet)
-            1.0,        // 1/4
-            1.0/1.5,    // 1/4. (dotted)
-            1.5,        // 1/4T (triplet)
-            0.5,        // 1/2
-            0.5/1.5,    // 1/2. (dotted)
-            0.25        // 1/1 (whole note)
-        };
-        double beatsPerSecond = currentBPM / 60.0;
-        double notesPerBeat = divisions[delayTime];
-        double delayTimeSeconds = 1.0 / (beatsPerSecond * notesPerBeat);
-        int delaySamples = static_cast<int>(delayTimeSeconds * currentSampleRate);
-        delaySamples = juce::jlimit(1, static_cast<int>(currentSampleRate * 4), delaySamples);
-
-        delayLine.setDelay(static_cast<float>(delaySamples));
-
-        // Process delay for each channel
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-        {
-            auto* channelData = buffer.getWritePointer(channel);
+        // This sub-block's incoming MIDI (positions stay relative to the host block)
+        subBlockMidi.clear();
+        subBlockMidi.addEvents(midiMessages, startSample, subBlockSize, 0);
 
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-            {
-                // Get delay mix LFO value and apply modulation
-                double lfoValue = getDelayMixLFOValue();
-                float modulatedDelayMix = delayMix + static_cast<float>(lfoValue) * delayMixLFO.depth;
-                modulatedDelayMix = juce::jlimit(0.0f, 1.0f, modulatedDelayMix);
+        // Pick up a published preset (everything below reads the same values)
+        beginPresetSwitchSubBlock();
 
-                // Read delayed sample
-                float delayedSample = delayLine.popSample(channel);
+        // Update progression step (must be before arp/sequencer)
+        updateProgressionStep();
 
-                // Mix input with feedback
-                float inputSample = channelData[sample];
-                float feedbackSample = inputSample + delayedSample * delayFeedback;
+        // Arpeggiator and sequencer replace/extend this sub-block's MIDI
+        processArpeggiator(subBlockMidi, startSample, subBlockSize);
+        processSequencer(subBlockMidi, startSample, subBlockSize);
 
-                // Push to delay line
-                delayLine.pushSample(channel, feedbackSample);
+        // Drum step tracking and sidechain envelope
+        processDrums();
 
-                // Mix dry and wet with LFO-modulated mix
-                channelData[sample] = inputSample * (1.0f - modulatedDelayMix) + delayedSample * modulatedDelayMix;
+        // Update voice parameters (after sequencer to get correct currentSeqStep for cutoff modulation)
+        updateVoiceParameters();
 
-                // Advance LFO phase (only on channel 0 to avoid double-advancing)
-                if (channel == 0)
-                    advanceDelayMixLFO();
-            }
+        // Render synthesizer (voices are spread over the shared worker pool when enabled)
+        synth.renderNextBlock(buffer, subBlockMidi, startSample, subBlockSize);
+        endPresetSwitchSubBlock(buffer, startSample, subBlockSize);
+
+        // Sidechain ducking for this sub-block (kicks trigger at its start)
+        if (sidechainEnvelope.isActive())
+        {
+            sidechainEnvelope.render(sidechainGain.data() + startSample, subBlockSize);
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel, startSample),
+                                                      sidechainGain.data() + startSample, subBlockSize);
         }
-    }
 
-    // Mix drum samples into output (after delay, so drums stay dry)
-    bool drumEnabled = parameters.getRawParameterValue("drumenable")->load() > 0.5f;
-    if (drumEnabled)
-    {
-        float drumMasterVol = parameters.getRawParameterValue("drummastervol")->load();
-        const char* laneVolIds[NUM_DRUM_LANES] = { "drumkickvol", "drumsnarevol", "drumchatvol", "drumohatvol" };
+        // Delay after the ducking; drums are added after it, so they stay dry
+        renderDelay(buffer, startSample, subBlockSize);
 
-        for (int lane = 0; lane < NUM_DRUM_LANES; ++lane)
+        if (drumEnabled)
         {
-            if (drumSamplePlaying[lane] && drumSamples[lane].getNumSamples() > 0)
-            {
-                float laneVol = parameters.getRawParameterValue(laneVolIds[lane])->load();
-                float vol = drumMasterVol * laneVol;
+            renderDrumSamples(startSample, subBlockSize);
+            for (int channel = 0; channel < juce::jmin(buffer.getNumChannels(), drumBuffer.getNumChannels()); ++channel)
+                buffer.addFrom(channel, startSample, drumBuffer, channel, startSample, subBlockSize);
+        }
 
-                int samplesRemaining = drumSamples[lane].getNumSamples() - drumSamplePositions[lane];
-                int samplesToAdd = juce::jmin(buffer.getNumSamples(), samplesRemaining);
+        buffer.applyGain(startSample, subBlockSize, param(Param::masterVolume));
 
-                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-                {
-                    int sampleChannel = juce::jmin(channel, drumSamples[lane].getNumChannels() - 1);
-                    const float* sampleData = drumSamples[lane].getReadPointer(sampleChannel, drumSamplePositions[lane]);
-                    float* outputData = buffer.getWritePointer(channel);
+        if (isPlaybackActive)
+            transportClock.advance(subBlockSize);
 
-                    for (int i = 0; i < samplesToAdd; ++i)
-                    {
-                        outputData[i] += sampleData[i] * vol;
-                    }
-                }
+        startSample += subBlockSize;
+    }
+}
 
-                drumSamplePositions[lane] += samplesToAdd;
-                if (drumSamplePositions[lane] >= drumSamples[lane].getNumSamples())
-                {
-                    drumSamplePlaying[lane] = false;
-                }
-            }
+void SnorkelSynthAudioProcessor::renderDelay(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const float delayMix = param(Param::delayMix);
+    updateDelayMixLFO();
+
+    if (delayMix <= 0.001f && delayMixLFO.depth <= 0.001f)
+        return;
+
+    int delayTime = static_cast<int>(param(Param::delayTime));
+    float delayFeedback = param(Param::delayFeedback);
+
+    // Calculate delay time in samples based on tempo
+    // Index: 0=1/16, 1=1/16., 2=1/16T, 3=1/8, 4=1/8., 5=1/8T, 6=1/4, 7=1/4., 8=1/4T, 9=1/2, 10=1/2., 11=1/1
+    const double divisions[] = {
+        4.0,        // 1/16
+        4.0/1.5,    // 1/16. (dotted)
+        6.0,        // 1/16T (triplet)
+        2.0,        // 1/8
+        2.0/1.5,    // 1/8. (dotted)
+        3.0,        // 1/8T (triplet)
+        1.0,        // 1/4
+        1.0/1.5,    // 1/4. (dotted)
+        1.5,        // 1/4T (triplet)
+        0.5,        // 1/2
+        0.5/1.5,    // 1/2. (dotted)
+        0.25        // 1/1 (whole note)
+    };
+    double beatsPerSecond = currentBPM / 60.0;
+    double notesPerBeat = divisions[delayTime];
+    double delayTimeSeconds = 1.0 / (beatsPerSecond * notesPerBeat);
+    double delaySamples = juce::jlimit(1.0, currentSampleRate * 4.0, delayTimeSeconds * currentSampleRate);
+
+    stereoDelay.setDelaySamples(static_cast<float>(delaySamples));
+    stereoDelay.setFeedback(delayFeedback);
+
+    // One mix curve for both channels
+    fillDelayMixCurve(delayMix, startSample, numSamples);
+
+    float* channels[2] = {};
+    const int numChannels = juce::jmin(2, buffer.getNumChannels());
+    for (int channel = 0; channel < numChannels; ++channel)
+        channels[channel] = buffer.getWritePointer(channel, startSample);
+
+    stereoDelay.process(channels, numChannels, numSamples, delayMixCurve.data() + startSample);
+}
+
+void SnorkelSynthAudioProcessor::applyQualityStep(int step)
+{
+    // Steps are cumulative: each one keeps the reductions of the steps before it
+    const int unisonVoices = step >= CpuGovernor::reducedUnison ? kGovernorUnisonVoices : AcidVoice::maxUnisonVoices;
+    const int lfoInterval = step >= CpuGovernor::reducedLFORate ? kGovernorLFOControlInterval : 1;
+    const int enabledVoices = step >= CpuGovernor::reducedVoices ? kGovernorNumVoices : kNumVoices;
+
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+    {
+        if (auto* voice = dynamic_cast<AcidVoice*>(synth.getVoice(i)))
+        {
+            voice->setQuality(unisonVoices, lfoInterval);
+            voice->setVoiceEnabled(i < enabledVoices); // Playing notes finish, no new ones start
         }
     }
 
-    // Apply master volume to final output
-    float masterVolume = parameters.getRawParameterValue(MASTER_VOLUME_ID)->load();
-    buffer.applyGain(masterVolume);
+    appliedQualityStep = step;
 }
 
 void SnorkelSynthAudioProcessor::updateVoiceParameters()
 {
     // Main parameters
-    float cutoff = parameters.getRawParameterValue(CUTOFF_ID)->load();
+    float cutoff = param(Param::cutoff);
 
     // Get base resonance first (needed before accent modulation)
-    float resonance = parameters.getRawParameterValue(RESONANCE_ID)->load();
-    float drive = parameters.getRawParameterValue(DRIVE_ID)->load();
-    float volume = parameters.getRawParameterValue(VOLUME_ID)->load();
+    float resonance = param(Param::resonance);
+    float drive = param(Param::drive);
+    float volume = param(Param::volume);
 
     // Apply sequencer accent modulation if sequencer is enabled and playing
-    bool seqEnabled = parameters.getRawParameterValue(SEQ_ENABLED_ID)->load() > 0.5f;
+    bool seqEnabled = param(Param::seqEnabled) > 0.5f;
     if (seqEnabled && isPlaybackActive)
     {
         float accentValue = getCurrentSeqCutoffMod(); // Range: -1.0 to +1.0
 
         // Get accent control amounts
-        float accentVol = parameters.getRawParameterValue(SEQ_ACCENT_VOL_ID)->load();
-        float accentCutoff = parameters.getRawParameterValue(SEQ_ACCENT_CUTOFF_ID)->load();
-        float accentRes = parameters.getRawParameterValue(SEQ_ACCENT_RES_ID)->load();
-        float accentDecay = parameters.getRawParameterValue(SEQ_ACCENT_DECAY_ID)->load();
-        float accentDrive = parameters.getRawParameterValue(SEQ_ACCENT_DRIVE_ID)->load();
+        float accentVol = param(Param::seqAccentVol);
+        float accentCutoff = param(Param::seqAccentCutoff);
+        float accentRes = param(Param::seqAccentRes);
+        float accentDecay = param(Param::seqAccentDecay);
+        float accentDrive = param(Param::seqAccentDrive);
 
         // Apply cutoff modulation (logarithmic scaling)
         float cutoffMod = accentValue * accentCutoff;
@@ -919,41 +543,41 @@ void SnorkelSynthAudioProcessor::updateVoiceParameters()
     {
         seqAccentDecayMod = 0.0f;
     }
-    float envMod = parameters.getRawParameterValue(ENV_MOD_ID)->load();
-    float accent = parameters.getRawParameterValue(ACCENT_ID)->load();
+    float envMod = param(Param::envMod);
+    float accent = param(Param::accent);
 
     // Three oscillators
-    float osc1Wave = parameters.getRawParameterValue(OSC1_WAVE_ID)->load();
-    int osc1Coarse = static_cast<int>(parameters.getRawParameterValue(OSC1_COARSE_ID)->load());
-    float osc1Fine = parameters.getRawParameterValue(OSC1_FINE_ID)->load();
-    float osc1Mix = parameters.getRawParameterValue(OSC1_MIX_ID)->load();
+    float osc1Wave = param(Param::osc1Wave);
+    int osc1Coarse = static_cast<int>(param(Param::osc1Coarse));
+    float osc1Fine = param(Param::osc1Fine);
+    float osc1Mix = param(Param::osc1Mix);
 
-    float osc2Wave = parameters.getRawParameterValue(OSC2_WAVE_ID)->load();
-    int osc2Coarse = static_cast<int>(parameters.getRawParameterValue(OSC2_COARSE_ID)->load());
-    float osc2Fine = parameters.getRawParameterValue(OSC2_FINE_ID)->load();
-    float osc2Mix = parameters.getRawParameterValue(OSC2_MIX_ID)->load();
+    float osc2Wave = param(Param::osc2Wave);
+    int osc2Coarse = static_cast<int>(param(Param::osc2Coarse));
+    float osc2Fine = param(Param::osc2Fine);
+    float osc2Mix = param(Param::osc2Mix);
 
-    float osc3Wave = parameters.getRawParameterValue(OSC3_WAVE_ID)->load();
-    int osc3Coarse = static_cast<int>(parameters.getRawParameterValue(OSC3_COARSE_ID)->load());
-    float osc3Fine = parameters.getRawParameterValue(OSC3_FINE_ID)->load();
-    float osc3Mix = parameters.getRawParameterValue(OSC3_MIX_ID)->load();
+    float osc3Wave = param(Param::osc3Wave);
+    int osc3Coarse = static_cast<int>(param(Param::osc3Coarse));
+    float osc3Fine = param(Param::osc3Fine);
+    float osc3Mix = param(Param::osc3Mix);
 
-    float noiseMix = parameters.getRawParameterValue(NOISE_MIX_ID)->load();
-    float noiseType = parameters.getRawParameterValue(NOISE_TYPE_ID)->load();
-    float noiseDecay = parameters.getRawParameterValue(NOISE_DECAY_ID)->load();
+    float noiseMix = param(Param::noiseMix);
+    float noiseType = param(Param::noiseType);
+    float noiseDecay = param(Param::noiseDecay);
 
-    float filterFeedback = parameters.getRawParameterValue(FILTER_FEEDBACK_ID)->load();
-    int saturationType = static_cast<int>(parameters.getRawParameterValue(SATURATION_TYPE_ID)->load());
+    float filterFeedback = param(Param::filterFeedback);
+    int saturationType = static_cast<int>(param(Param::saturationType));
 
     // Filter ADSR parameters
-    float filterAttack = parameters.getRawParameterValue(FILTER_ATTACK_ID)->load();
-    float filterDecay = parameters.getRawParameterValue(FILTER_DECAY_ID)->load();
-    float filterSustain = parameters.getRawParameterValue(FILTER_SUSTAIN_ID)->load();
-    float filterRelease = parameters.getRawParameterValue(FILTER_RELEASE_ID)->load();
+    float filterAttack = param(Param::filterAttack);
+    float filterDecay = param(Param::filterDecay);
+    float filterSustain = param(Param::filterSustain);
+    float filterRelease = param(Param::filterRelease);
 
     // Amplitude ADSR parameters
-    float ampAttack = parameters.getRawParameterValue(AMP_ATTACK_ID)->load();
-    float ampDecay = parameters.getRawParameterValue(AMP_DECAY_ID)->load();
+    float ampAttack = param(Param::ampAttack);
+    float ampDecay = param(Param::ampDecay);
     // Apply accent decay modulation (positive accent = shorter decay for punchier sound)
     if (seqAccentDecayMod != 0.0f)
     {
@@ -961,350 +585,203 @@ void SnorkelSynthAudioProcessor::updateVoiceParameters()
         ampDecay = ampDecay * (1.0f - juce::jmax(0.0f, decayMod));
         ampDecay = juce::jmax(0.01f, ampDecay); // Minimum 10ms
     }
-    float ampSustain = parameters.getRawParameterValue(AMP_SUSTAIN_ID)->load();
-    float ampRelease = parameters.getRawParameterValue(AMP_RELEASE_ID)->load();
-
-    // Dedicated LFO parameters (3 per parameter: rate, waveform, depth)
-    int cutoffLFORate = static_cast<int>(parameters.getRawParameterValue(CUTOFF_LFO_RATE_ID)->load());
-    int cutoffLFOWave = static_cast<int>(parameters.getRawParameterValue(CUTOFF_LFO_WAVE_ID)->load());
-    float cutoffLFODepth = parameters.getRawParameterValue(CUTOFF_LFO_DEPTH_ID)->load();
-
-    int resonanceLFORate = static_cast<int>(parameters.getRawParameterValue(RESONANCE_LFO_RATE_ID)->load());
-    int resonanceLFOWave = static_cast<int>(parameters.getRawParameterValue(RESONANCE_LFO_WAVE_ID)->load());
-    float resonanceLFODepth = parameters.getRawParameterValue(RESONANCE_LFO_DEPTH_ID)->load();
-
-    int envModLFORate = static_cast<int>(parameters.getRawParameterValue(ENVMOD_LFO_RATE_ID)->load());
-    int envModLFOWave = static_cast<int>(parameters.getRawParameterValue(ENVMOD_LFO_WAVE_ID)->load());
-    float envModLFODepth = parameters.getRawParameterValue(ENVMOD_LFO_DEPTH_ID)->load();
-
-    int decayLFORate = static_cast<int>(parameters.getRawParameterValue(DECAY_LFO_RATE_ID)->load());
-    int decayLFOWave = static_cast<int>(parameters.getRawParameterValue(DECAY_LFO_WAVE_ID)->load());
-    float decayLFODepth = parameters.getRawParameterValue(DECAY_LFO_DEPTH_ID)->load();
-
-    int accentLFORate = static_cast<int>(parameters.getRawParameterValue(ACCENT_LFO_RATE_ID)->load());
-    int accentLFOWave = static_cast<int>(parameters.getRawParameterValue(ACCENT_LFO_WAVE_ID)->load());
-    float accentLFODepth = parameters.getRawParameterValue(ACCENT_LFO_DEPTH_ID)->load();
-
-    int waveformLFORate = static_cast<int>(parameters.getRawParameterValue(WAVEFORM_LFO_RATE_ID)->load());
-    int waveformLFOWave = static_cast<int>(parameters.getRawParameterValue(WAVEFORM_LFO_WAVE_ID)->load());
-    float waveformLFODepth = parameters.getRawParameterValue(WAVEFORM_LFO_DEPTH_ID)->load();
-
-    int subOscLFORate = static_cast<int>(parameters.getRawParameterValue(SUBOSC_LFO_RATE_ID)->load());
-    int subOscLFOWave = static_cast<int>(parameters.getRawParameterValue(SUBOSC_LFO_WAVE_ID)->load());
-    float subOscLFODepth = parameters.getRawParameterValue(SUBOSC_LFO_DEPTH_ID)->load();
-
-    int driveLFORate = static_cast<int>(parameters.getRawParameterValue(DRIVE_LFO_RATE_ID)->load());
-    int driveLFOWave = static_cast<int>(parameters.getRawParameterValue(DRIVE_LFO_WAVE_ID)->load());
-    float driveLFODepth = parameters.getRawParameterValue(DRIVE_LFO_DEPTH_ID)->load();
-
-    int volumeLFORate = static_cast<int>(parameters.getRawParameterValue(VOLUME_LFO_RATE_ID)->load());
-    int volumeLFOWave = static_cast<int>(parameters.getRawParameterValue(VOLUME_LFO_WAVE_ID)->load());
-    float volumeLFODepth = parameters.getRawParameterValue(VOLUME_LFO_DEPTH_ID)->load();
-
-    int delayMixLFORate = static_cast<int>(parameters.getRawParameterValue(DELAYMIX_LFO_RATE_ID)->load());
-    int delayMixLFOWave = static_cast<int>(parameters.getRawParameterValue(DELAYMIX_LFO_WAVE_ID)->load());
-    float delayMixLFODepth = parameters.getRawParameterValue(DELAYMIX_LFO_DEPTH_ID)->load();
+    float ampSustain = param(Param::ampSustain);
+    float ampRelease = param(Param::ampRelease);
 
-    int globalOctave = static_cast<int>(parameters.getRawParameterValue(GLOBAL_OCTAVE_ID)->load());
+    int globalOctave = static_cast<int>(param(Param::globalOctave));
 
     // Analog character parameters
-    float drift = parameters.getRawParameterValue(DRIFT_ID)->load();
-    float phaseRandom = parameters.getRawParameterValue(PHASE_RANDOM_ID)->load();
-    float unison = parameters.getRawParameterValue(UNISON_ID)->load();
+    float drift = param(Param::drift);
+    float phaseRandom = param(Param::phaseRandom);
+    float unison = param(Param::unison);
+
+    // Build this block's snapshot
+    VoiceParams params {};
+    params.cutoff = cutoff;
+    params.resonance = resonance;
+    params.envMod = envMod;
+    params.accent = accent;
+    params.filterFeedback = filterFeedback;
+
+    params.osc[0] = { osc1Wave, osc1Coarse, osc1Fine, osc1Mix };
+    params.osc[1] = { osc2Wave, osc2Coarse, osc2Fine, osc2Mix };
+    params.osc[2] = { osc3Wave, osc3Coarse, osc3Fine, osc3Mix };
+    params.noiseMix = noiseMix;
+    params.noiseType = noiseType;
+    params.noiseDecay = noiseDecay;
+
+    params.drive = drive;
+    params.saturationType = saturationType;
+    params.volume = volume;
+    params.globalOctave = globalOctave;
+    params.bpm = currentBPM;
+
+    params.drift = drift;
+    params.phaseRandom = phaseRandom;
+    params.unison = unison;
+
+    params.filterEnv = { filterAttack, filterDecay, filterSustain, filterRelease };
+    params.ampEnv = { ampAttack, ampDecay, ampSustain, ampRelease };
+
+    // Dedicated LFOs: the schema keeps rate, waveform and depth in VoiceParams::LFOIndex order
+    for (int i = 0; i < VoiceParams::numLFOs; ++i)
+        params.lfo[i] = { static_cast<int>(param(Param::lfoRate(i))),
+                          static_cast<int>(param(Param::lfoWave(i))),
+                          param(Param::lfoDepth(i)) };
+
+    // Only push what changed since the last block
+    const uint32_t dirtyFlags = voiceParamsValid ? VoiceParams::diff(lastVoiceParams, params)
+                                                 : static_cast<uint32_t>(VoiceParams::allDirty);
+    if (dirtyFlags == 0)
+        return;
+
+    lastVoiceParams = params;
+    voiceParamsValid = true;
 
-    // Update all voices
     for (int i = 0; i < synth.getNumVoices(); ++i)
-    {
         if (auto* voice = dynamic_cast<AcidVoice*>(synth.getVoice(i)))
-        {
-            // Set main parameters
-            voice->setCutoff(cutoff);
-            voice->setResonance(resonance);
-            voice->setEnvMod(envMod);
-            voice->setAccent(accent);
-
-            // Set three oscillators
-            voice->setOscillator1(osc1Wave, osc1Coarse, osc1Fine, osc1Mix);
-            voice->setOscillator2(osc2Wave, osc2Coarse, osc2Fine, osc2Mix);
-            voice->setOscillator3(osc3Wave, osc3Coarse, osc3Fine, osc3Mix);
-            voice->setNoiseMix(noiseMix);
-            voice->setNoiseType(noiseType);
-            voice->setNoiseDecay(noiseDecay);
-
-            voice->setDrive(drive);
-            voice->setVolume(volume);
-            voice->setGlobalOctave(globalOctave);
-            voice->setBPM(currentBPM);
-            voice->setFilterFeedback(filterFeedback);
-            voice->setSaturationType(saturationType);
-
-            // Set analog character parameters
-            voice->setDrift(drift);
-            voice->setPhaseRandom(phaseRandom);
-            voice->setUnison(unison);
-
-            // Set ADSR parameters
-            voice->setFilterADSR(filterAttack, filterDecay, filterSustain, filterRelease);
-            voice->setAmpADSR(ampAttack, ampDecay, ampSustain, ampRelease);
-
-            // Set all 10 dedicated LFOs
-            voice->setCutoffLFO(cutoffLFORate, cutoffLFOWave, cutoffLFODepth);
-            voice->setResonanceLFO(resonanceLFORate, resonanceLFOWave, resonanceLFODepth);
-            voice->setEnvModLFO(envModLFORate, envModLFOWave, envModLFODepth);
-            voice->setDecayLFO(decayLFORate, decayLFOWave, decayLFODepth);
-            voice->setAccentLFO(accentLFORate, accentLFOWave, accentLFODepth);
-            voice->setWaveformLFO(waveformLFORate, waveformLFOWave, waveformLFODepth);
-            voice->setSubOscLFO(subOscLFORate, subOscLFOWave, subOscLFODepth);
-            voice->setDriveLFO(driveLFORate, driveLFOWave, driveLFODepth);
-            voice->setVolumeLFO(volumeLFORate, volumeLFOWave, volumeLFODepth);
-            voice->setDelayMixLFO(delayMixLFORate, delayMixLFOWave, delayMixLFODepth);
-        }
-    }
+            voice->applyParameters(params, dirtyFlags);
 }
 
-void SnorkelSynthAudioProcessor::loadPresetFromJSON(int presetIndex)
+void SnorkelSynthAudioProcessor::loadPresetFromJSON(int presetIndex, bool crossfade)
 {
-    if (!synthPresetsJSON.isObject())
-        return;
-
-    auto* obj = synthPresetsJSON.getDynamicObject();
-    if (obj == nullptr)
-        return;
-
-    const juce::Array<juce::var>* presetsArray = obj->getProperty("presets").getArray();
-    if (presetsArray == nullptr || presetIndex < 0 || presetIndex >= presetsArray->size())
+    if (synthPresetBank == nullptr)
         return;
 
-    auto* presetObj = (*presetsArray)[presetIndex].getDynamicObject();
-    if (presetObj == nullptr)
-        return;
-
-    // Set all parameters from JSON preset
-    parameters.getParameter(CUTOFF_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(CUTOFF_ID).convertTo0to1(static_cast<float>(presetObj->getProperty("cutoff"))));
-
-    parameters.getParameter(RESONANCE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(RESONANCE_ID).convertTo0to1(static_cast<float>(presetObj->getProperty("resonance"))));
-
-    parameters.getParameter(ENV_MOD_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(ENV_MOD_ID).convertTo0to1(static_cast<float>(presetObj->getProperty("envMod"))));
-
-    parameters.getParameter(ACCENT_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(ACCENT_ID).convertTo0to1(static_cast<float>(presetObj->getProperty("accent"))));
-
-    // Load oscillator parameters - support both new and old preset formats
-    // New presets have "osc1Wave", "osc1Coarse", etc.
-    // Old presets have "waveform" (maps to osc1Wave) and "subOsc" (maps to osc3Mix)
-
-    // Oscillator 1
-    float osc1Wave = presetObj->hasProperty("osc1Wave") ?
-        static_cast<float>(presetObj->getProperty("osc1Wave")) :
-        (presetObj->hasProperty("waveform") ?
-            static_cast<float>(presetObj->getProperty("waveform")) : 0.5f);
-    parameters.getParameter(OSC1_WAVE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC1_WAVE_ID).convertTo0to1(osc1Wave));
-
-    int osc1Coarse = presetObj->hasProperty("osc1Coarse") ?
-        static_cast<int>(presetObj->getProperty("osc1Coarse")) : 0;
-    parameters.getParameter(OSC1_COARSE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC1_COARSE_ID).convertTo0to1(osc1Coarse));
-
-    float osc1Fine = presetObj->hasProperty("osc1Fine") ?
-        static_cast<float>(presetObj->getProperty("osc1Fine")) : 0.0f;
-    parameters.getParameter(OSC1_FINE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC1_FINE_ID).convertTo0to1(osc1Fine));
-
-    float osc1Mix = presetObj->hasProperty("osc1Mix") ?
-        static_cast<float>(presetObj->getProperty("osc1Mix")) : 0.7f;
-    parameters.getParameter(OSC1_MIX_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC1_MIX_ID).convertTo0to1(osc1Mix));
-
-    // Oscillator 2
-    float osc2Wave = presetObj->hasProperty("osc2Wave") ?
-        static_cast<float>(presetObj->getProperty("osc2Wave")) : 0.5f;
-    parameters.getParameter(OSC2_WAVE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC2_WAVE_ID).convertTo0to1(osc2Wave));
-
-    int osc2Coarse = presetObj->hasProperty("osc2Coarse") ?
-        static_cast<int>(presetObj->getProperty("osc2Coarse")) : 0;
-    parameters.getParameter(OSC2_COARSE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC2_COARSE_ID).convertTo0to1(osc2Coarse));
-
-    float osc2Fine = presetObj->hasProperty("osc2Fine") ?
-        static_cast<float>(presetObj->getProperty("osc2Fine")) : 0.0f;
-    parameters.getParameter(OSC2_FINE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC2_FINE_ID).convertTo0to1(osc2Fine));
-
-    float osc2Mix = presetObj->hasProperty("osc2Mix") ?
-        static_cast<float>(presetObj->getProperty("osc2Mix")) : 0.0f;
-    parameters.getParameter(OSC2_MIX_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC2_MIX_ID).convertTo0to1(osc2Mix));
-
-    // Oscillator 3
-    float osc3Wave = presetObj->hasProperty("osc3Wave") ?
-        static_cast<float>(presetObj->getProperty("osc3Wave")) : 0.0f;
-    parameters.getParameter(OSC3_WAVE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC3_WAVE_ID).convertTo0to1(osc3Wave));
+    // Rows are compiled from the JSON with the schema's legacy-key and missing-value rules;
+    // NaN marks parameters the preset leaves alone. Presets saved since the last
+    // reload follow the bank's own.
+    const float* values = synthPresetBank->getValues(presetIndex);
+    if (values == nullptr)
+    {
+        const auto* pending = getPendingSynthPreset(presetIndex - synthPresetBank->getNumPresets());
+        if (pending == nullptr)
+            return;
 
-    int osc3Coarse = presetObj->hasProperty("osc3Coarse") ?
-        static_cast<int>(presetObj->getProperty("osc3Coarse")) : -12;
-    parameters.getParameter(OSC3_COARSE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC3_COARSE_ID).convertTo0to1(osc3Coarse));
+        values = pending->values.data();
+    }
 
-    float osc3Fine = presetObj->hasProperty("osc3Fine") ?
-        static_cast<float>(presetObj->getProperty("osc3Fine")) : 0.0f;
-    parameters.getParameter(OSC3_FINE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC3_FINE_ID).convertTo0to1(osc3Fine));
+    applyParameterValues(values, crossfade);
+}
 
-    float osc3Mix = presetObj->hasProperty("osc3Mix") ?
-        static_cast<float>(presetObj->getProperty("osc3Mix")) :
-        (presetObj->hasProperty("subOsc") ?
-            static_cast<float>(presetObj->getProperty("subOsc")) : 0.5f);
-    parameters.getParameter(OSC3_MIX_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(OSC3_MIX_ID).convertTo0to1(osc3Mix));
+void SnorkelSynthAudioProcessor::applyParameterValues(const float* values, bool crossfade, bool asGesture)
+{
+    // Build the complete target vector first. Values go through the parameter's
+    // range so the audio thread switches to exactly what the host will report.
+    PresetSnapshot::Values current {}, target {};
+    std::array<bool, Param::numParams> changed {};
+    bool anyChanged = false;
 
-    // Noise oscillator
-    if (presetObj->hasProperty("noiseType"))
+    for (const auto& spec : Param::kSpecs)
     {
-        float noiseType = static_cast<float>(presetObj->getProperty("noiseType"));
-        parameters.getParameter(NOISE_TYPE_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(NOISE_TYPE_ID).convertTo0to1(noiseType));
-    }
+        const auto i = static_cast<size_t>(spec.index);
+        auto* p = paramObjects[i];
+        current[i] = paramValues[i]->load();
+        target[i] = current[i];
 
-    if (presetObj->hasProperty("noiseDecay"))
-    {
-        float noiseDecay = static_cast<float>(presetObj->getProperty("noiseDecay"));
-        parameters.getParameter(NOISE_DECAY_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(NOISE_DECAY_ID).convertTo0to1(noiseDecay));
-    }
+        if (p == nullptr || std::isnan(values[i]))
+            continue;
 
-    if (presetObj->hasProperty("noiseMix"))
-    {
-        float noiseMix = static_cast<float>(presetObj->getProperty("noiseMix"));
-        parameters.getParameter(NOISE_MIX_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(NOISE_MIX_ID).convertTo0to1(noiseMix));
+        target[i] = p->convertFrom0to1(p->convertTo0to1(values[i]));
+        changed[i] = target[i] != current[i];
+        anyChanged = anyChanged || changed[i];
     }
 
-    parameters.getParameter(DRIVE_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(DRIVE_ID).convertTo0to1(static_cast<float>(presetObj->getProperty("drive"))));
+    if (!anyChanged)
+        return;
 
-    parameters.getParameter(VOLUME_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(VOLUME_ID).convertTo0to1(static_cast<float>(presetObj->getProperty("volume"))));
+    // The audio thread picks the whole preset up at once; then tell the host, in one
+    // gesture for a preset change. A restored state is not a user edit: hosts record
+    // gestures as automation, so it sets the values the way APVTS::replaceState does.
+    const uint32_t sequence = presetSnapshot.publish(current, target, crossfade);
 
-    // Global octave
-    if (presetObj->hasProperty("globalOctave"))
-    {
-        int globalOctave = static_cast<int>(presetObj->getProperty("globalOctave"));
-        parameters.getParameter(GLOBAL_OCTAVE_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(GLOBAL_OCTAVE_ID).convertTo0to1(static_cast<float>(globalOctave)));
-    }
+    if (asGesture)
+        for (size_t i = 0; i < changed.size(); ++i)
+            if (changed[i])
+                paramObjects[i]->beginChangeGesture();
 
-    // Analog character parameters
-    if (presetObj->hasProperty("drift"))
-    {
-        float drift = static_cast<float>(presetObj->getProperty("drift"));
-        parameters.getParameter(DRIFT_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(DRIFT_ID).convertTo0to1(drift));
-    }
+    for (size_t i = 0; i < changed.size(); ++i)
+        if (changed[i])
+            paramObjects[i]->setValueNotifyingHost(paramObjects[i]->convertTo0to1(target[i]));
 
-    if (presetObj->hasProperty("phaseRandom"))
+    if (asGesture)
     {
-        float phaseRandom = static_cast<float>(presetObj->getProperty("phaseRandom"));
-        parameters.getParameter(PHASE_RANDOM_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(PHASE_RANDOM_ID).convertTo0to1(phaseRandom));
+        for (size_t i = 0; i < changed.size(); ++i)
+            if (changed[i])
+                paramObjects[i]->endChangeGesture();
     }
-
-    if (presetObj->hasProperty("unison"))
+    else
     {
-        float unison = static_cast<float>(presetObj->getProperty("unison"));
-        parameters.getParameter(UNISON_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(UNISON_ID).convertTo0to1(unison));
+        updateHostDisplay(juce::AudioProcessorListener::ChangeDetails().withParameterInfoChanged(true));
     }
 
-    // Amplitude ADSR
-    if (presetObj->hasProperty("ampAttack"))
-    {
-        float ampAttack = static_cast<float>(presetObj->getProperty("ampAttack"));
-        parameters.getParameter(AMP_ATTACK_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(AMP_ATTACK_ID).convertTo0to1(ampAttack));
-    }
+    presetSnapshot.markApplied(sequence);
+}
 
-    if (presetObj->hasProperty("ampDecay"))
-    {
-        float ampDecay = static_cast<float>(presetObj->getProperty("ampDecay"));
-        parameters.getParameter(AMP_DECAY_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(AMP_DECAY_ID).convertTo0to1(ampDecay));
-    }
+void SnorkelSynthAudioProcessor::setPresetOverride(const PresetSnapshot::Values& values)
+{
+    for (size_t i = 0; i < values.size(); ++i)
+        presetOverride[i].store(values[i], std::memory_order_relaxed);
+    presetOverrideActive.store(true, std::memory_order_relaxed);
+}
 
-    if (presetObj->hasProperty("ampSustain"))
+void SnorkelSynthAudioProcessor::beginPresetSwitchSubBlock()
+{
+    // The host parameters have caught up with the snapshot; read them directly again
+    if (presetFade == PresetFade::holding && presetSnapshot.isApplied(presetSnapshotSeen))
     {
-        float ampSustain = static_cast<float>(presetObj->getProperty("ampSustain"));
-        parameters.getParameter(AMP_SUSTAIN_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(AMP_SUSTAIN_ID).convertTo0to1(ampSustain));
+        presetOverrideActive.store(false, std::memory_order_relaxed);
+        presetFade = PresetFade::idle;
     }
 
-    if (presetObj->hasProperty("ampRelease"))
+    if (presetFade == PresetFade::switchPending)
     {
-        float ampRelease = static_cast<float>(presetObj->getProperty("ampRelease"));
-        parameters.getParameter(AMP_RELEASE_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(AMP_RELEASE_ID).convertTo0to1(ampRelease));
+        // Output is silent at this point: switch every parameter together
+        setPresetOverride(incomingPreset);
+        presetFade = PresetFade::fadingIn;
+        presetFadePosition = 0;
+        return;
     }
 
-    // Filter feedback
-    if (presetObj->hasProperty("filterFeedback"))
+    bool crossfade = false;
+    if (presetFade == PresetFade::idle
+        && presetSnapshot.readIfNewer(outgoingPreset, incomingPreset, presetSnapshotSeen, crossfade))
     {
-        float filterFeedback = static_cast<float>(presetObj->getProperty("filterFeedback"));
-        parameters.getParameter(FILTER_FEEDBACK_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(FILTER_FEEDBACK_ID).convertTo0to1(filterFeedback));
+        // Hold the old values while fading out, or switch straight away
+        setPresetOverride(crossfade ? outgoingPreset : incomingPreset);
+        presetFade = crossfade ? PresetFade::fadingOut : PresetFade::holding;
+        presetFadePosition = 0;
     }
+}
 
-    // Saturation type (Choice parameter)
-    if (presetObj->hasProperty("saturationType"))
-    {
-        int saturationType = static_cast<int>(presetObj->getProperty("saturationType"));
-        parameters.getParameter(SATURATION_TYPE_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(SATURATION_TYPE_ID).convertTo0to1(static_cast<float>(saturationType)));
-    }
+void SnorkelSynthAudioProcessor::endPresetSwitchSubBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    if (presetFade != PresetFade::fadingOut && presetFade != PresetFade::fadingIn)
+        return;
 
-    // Filter ADSR
-    if (presetObj->hasProperty("filterAttack"))
-    {
-        float filterAttack = static_cast<float>(presetObj->getProperty("filterAttack"));
-        parameters.getParameter(FILTER_ATTACK_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(FILTER_ATTACK_ID).convertTo0to1(filterAttack));
-    }
+    // Each ramp lasts presetFadeSamples, carried across as many sub-blocks as it takes
+    const bool fadingOut = presetFade == PresetFade::fadingOut;
+    const int rampSamples = juce::jmin(numSamples, presetFadeSamples - presetFadePosition);
+    const float startGain = static_cast<float>(presetFadePosition) / static_cast<float>(presetFadeSamples);
+    const float endGain = static_cast<float>(presetFadePosition + rampSamples) / static_cast<float>(presetFadeSamples);
 
-    if (presetObj->hasProperty("filterDecay"))
-    {
-        float filterDecay = static_cast<float>(presetObj->getProperty("filterDecay"));
-        parameters.getParameter(FILTER_DECAY_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(FILTER_DECAY_ID).convertTo0to1(filterDecay));
-    }
+    if (fadingOut)
+        buffer.applyGainRamp(startSample, rampSamples, 1.0f - startGain, 1.0f - endGain);
+    else
+        buffer.applyGainRamp(startSample, rampSamples, startGain, endGain);
 
-    if (presetObj->hasProperty("filterSustain"))
-    {
-        float filterSustain = static_cast<float>(presetObj->getProperty("filterSustain"));
-        parameters.getParameter(FILTER_SUSTAIN_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(FILTER_SUSTAIN_ID).convertTo0to1(filterSustain));
-    }
+    presetFadePosition += rampSamples;
+    if (presetFadePosition < presetFadeSamples)
+        return;
 
-    if (presetObj->hasProperty("filterRelease"))
+    // The ramp ended inside this sub-block: the old preset stays silent to its end, the new one is at full level
+    if (fadingOut)
     {
-        float filterRelease = static_cast<float>(presetObj->getProperty("filterRelease"));
-        parameters.getParameter(FILTER_RELEASE_ID)->setValueNotifyingHost(
-            parameters.getParameterRange(FILTER_RELEASE_ID).convertTo0to1(filterRelease));
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            buffer.clear(channel, startSample + rampSamples, numSamples - rampSamples);
     }
 
-    // Delay Time is a Choice parameter - need to normalize index (0-11) to 0-1 range
-    int delayTimeIndex = static_cast<int>(presetObj->getProperty("delayTime"));
-    parameters.getParameter(DELAY_TIME_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(DELAY_TIME_ID).convertTo0to1(static_cast<float>(delayTimeIndex)));
-
-    parameters.getParameter(DELAY_FEEDBACK_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(DELAY_FEEDBACK_ID).convertTo0to1(static_cast<float>(presetObj->getProperty("delayFeedback"))));
-
-    parameters.getParameter(DELAY_MIX_ID)->setValueNotifyingHost(
-        parameters.getParameterRange(DELAY_MIX_ID).convertTo0to1(static_cast<float>(presetObj->getProperty("delayMix"))));
+    presetFade = fadingOut ? PresetFade::switchPending : PresetFade::holding;
 }
 
 //==============================================================================
@@ -1410,153 +887,45 @@ juce::String SnorkelSynthAudioProcessor::formatJSON(const juce::var& json, int i
 
 void SnorkelSynthAudioProcessor::loadPresetsFromJSON()
 {
-    juce::File dataDir = getDataDirectory();
-
-    // Log loading attempt
-    juce::File logFile = dataDir.getChildFile("preset_load_log.txt");
-    juce::String logMessage = juce::Time::getCurrentTime().toString(true, true) + "\n";
-    logMessage += "Loading presets from: " + dataDir.getFullPathName() + "\n";
-
-    // Load system synth presets (read-only)
-    juce::Array<juce::var> combinedPresets;
-    numSystemSynthPresets = 0;
-
-    juce::File systemPresetFile = dataDir.getChildFile("synth_presets_system.json");
-    logMessage += "System preset file exists: " + juce::String(systemPresetFile.existsAsFile() ? "yes" : "no") + "\n";
-    logMessage += "System preset file path: " + systemPresetFile.getFullPathName() + "\n";
+    presetBankLoader->load();
+}
 
-    if (systemPresetFile.existsAsFile())
-    {
-        juce::String jsonText = systemPresetFile.loadFileAsString();
-        logMessage += "System JSON length: " + juce::String(jsonText.length()) + "\n";
-        auto result = juce::JSON::parse(jsonText);
-        if (result.isObject())
-        {
-            auto* obj = result.getDynamicObject();
-            if (obj != nullptr)
-            {
-                const juce::Array<juce::var>* arr = obj->getProperty("presets").getArray();
-                if (arr != nullptr)
-                {
-                    combinedPresets.addArray(*arr);
-                    numSystemSynthPresets = arr->size();
-                    logMessage += "System presets loaded: " + juce::String(numSystemSynthPresets) + "\n";
-                }
-            }
-        }
-        else
-        {
-            logMessage += "System JSON parse failed\n";
-        }
-    }
+void SnorkelSynthAudioProcessor::applyPresetBanks(PresetBankLoader::Banks& banks)
+{
+    synthPresetBank = banks.synthPresets;
+    sequencerPresetsJSON = banks.sequencerPresets;
+    numSystemSynthPresets = banks.numSystemSynthPresets;
+    numSystemSequencerPresets = banks.numSystemSequencerPresets;
 
-    // Load user synth presets (writable)
-    juce::File userPresetFile = dataDir.getChildFile("synth_presets_user.json");
-    logMessage += "User preset file exists: " + juce::String(userPresetFile.existsAsFile() ? "yes" : "no") + "\n";
-    logMessage += "User preset file path: " + userPresetFile.getFullPathName() + "\n";
+    // Drop saved presets this load already read back from the user banks; keep listing the rest
+    pendingPresets.erase(std::remove_if(pendingPresets.begin(), pendingPresets.end(),
+                                        [&banks](const PendingPreset& p)
+                                        {
+                                            return p.reloadGeneration != 0 && p.reloadGeneration <= banks.generation;
+                                        }),
+                         pendingPresets.end());
 
-    if (userPresetFile.existsAsFile())
-    {
-        juce::String jsonText = userPresetFile.loadFileAsString();
-        logMessage += "User JSON length: " + juce::String(jsonText.length()) + "\n";
-        auto result = juce::JSON::parse(jsonText);
-        if (result.isObject())
-        {
-            auto* obj = result.getDynamicObject();
-            if (obj != nullptr)
-            {
-                const juce::Array<juce::var>* arr = obj->getProperty("presets").getArray();
-                if (arr != nullptr)
-                {
-                    combinedPresets.addArray(*arr);
-                    logMessage += "User presets loaded: " + juce::String(arr->size()) + "\n";
-                }
-            }
-        }
-        else
-        {
-            logMessage += "User JSON parse failed\n";
-        }
-    }
+    if (auto* combinedObj = sequencerPresetsJSON.getDynamicObject())
+        if (juce::Array<juce::var>* combinedArray = combinedObj->getProperty("presets").getArray())
+            for (const auto& pending : pendingPresets)
+                if (pending.bank == PresetJournal::Bank::sequencer)
+                    combinedArray->add(pending.preset);
 
-    // Create combined JSON structure
-    synthPresetsJSON = juce::var(new juce::DynamicObject());
-    synthPresetsJSON.getDynamicObject()->setProperty("presets", combinedPresets);
-    logMessage += "Total combined presets: " + juce::String(combinedPresets.size()) + "\n";
+    rebuildProgramList();
 
-    // Load sequencer presets from both system and user files
-    juce::Array<juce::var> combinedSequencerPresets;
-    numSystemSequencerPresets = 0;
+    if (!banks.randomizationConfig.isVoid())
+        randomizationConfigJSON = banks.randomizationConfig;
 
-    // Load system sequencer presets (read-only)
-    juce::File systemSeqPresetFile = dataDir.getChildFile("sequencer_presets_system.json");
-    logMessage += "System sequencer preset file exists: " + juce::String(systemSeqPresetFile.existsAsFile() ? "yes" : "no") + "\n";
+    presetBanksLoaded = true;
 
-    if (systemSeqPresetFile.existsAsFile())
-    {
-        juce::String jsonText = systemSeqPresetFile.loadFileAsString();
-        auto result = juce::JSON::parse(jsonText);
-        if (result.isObject())
-        {
-            auto* obj = result.getDynamicObject();
-            if (obj != nullptr)
-            {
-                const juce::Array<juce::var>* arr = obj->getProperty("presets").getArray();
-                if (arr != nullptr)
-                {
-                    combinedSequencerPresets.addArray(*arr);
-                    numSystemSequencerPresets = arr->size();
-                    logMessage += "System sequencer presets loaded: " + juce::String(arr->size()) + "\n";
-                }
-            }
-        }
-    }
-
-    // Load user sequencer presets (writable)
-    juce::File userSeqPresetFile = dataDir.getChildFile("sequencer_presets_user.json");
-    logMessage += "User sequencer preset file exists: " + juce::String(userSeqPresetFile.existsAsFile() ? "yes" : "no") + "\n";
-
-    if (userSeqPresetFile.existsAsFile())
-    {
-        juce::String jsonText = userSeqPresetFile.loadFileAsString();
-        auto result = juce::JSON::parse(jsonText);
-        if (result.isObject())
-        {
-            auto* obj = result.getDynamicObject();
-            if (obj != nullptr)
-            {
-                const juce::Array<juce::var>* arr = obj->getProperty("presets").getArray();
-                if (arr != nullptr)
-                {
-                    combinedSequencerPresets.addArray(*arr);
-                    logMessage += "User sequencer presets loaded: " + juce::String(arr->size()) + "\n";
-                }
-            }
-        }
-    }
-
-    // Create combined sequencer JSON structure
-    sequencerPresetsJSON = juce::var(new juce::DynamicObject());
-    sequencerPresetsJSON.getDynamicObject()->setProperty("presets", combinedSequencerPresets);
-    logMessage += "Total combined sequencer presets: " + juce::String(combinedSequencerPresets.size()) + "\n";
-
-    // Load randomization config
-    juce::File randomConfigFile = dataDir.getChildFile("randomization_config.json");
-    logMessage += "Randomization config file exists: " + juce::String(randomConfigFile.existsAsFile() ? "yes" : "no") + "\n";
-
-    if (randomConfigFile.existsAsFile())
+    // Load the first synth preset by default
+    if (initialPresetPending && synthPresetBank != nullptr && synthPresetBank->getNumPresets() > 0)
     {
-        juce::String jsonText = randomConfigFile.loadFileAsString();
-        auto result = juce::JSON::parse(jsonText);
-        if (result.isObject())
-        {
-            randomizationConfigJSON = result;
-            logMessage += "Randomization config loaded\n";
-        }
+        initialPresetPending = false;
+        loadPresetFromJSON(0);
     }
 
-    logMessage += "\n";
-    logFile.appendText(logMessage);
+    presetBanksChanged.sendChangeMessage();
 }
 
 void SnorkelSynthAudioProcessor::saveSynthPresetToJSON(const juce::String& presetName)
@@ -1567,112 +936,31 @@ void SnorkelSynthAudioProcessor::saveSynthPresetToJSON(const juce::String& prese
     presetObj->setProperty("name", presetName);
     presetObj->setProperty("description", "User preset"); // Add description for consistency
 
-    // Filter parameters
-    presetObj->setProperty("cutoff", parameters.getRawParameterValue(CUTOFF_ID)->load());
-    presetObj->setProperty("resonance", parameters.getRawParameterValue(RESONANCE_ID)->load());
-    presetObj->setProperty("envMod", parameters.getRawParameterValue(ENV_MOD_ID)->load());
-    presetObj->setProperty("accent", parameters.getRawParameterValue(ACCENT_ID)->load());
-    presetObj->setProperty("filterFeedback", parameters.getRawParameterValue(FILTER_FEEDBACK_ID)->load());
-    presetObj->setProperty("saturationType", static_cast<int>(parameters.getRawParameterValue(SATURATION_TYPE_ID)->load()));
-
-    // Oscillator 1-3 parameters
-    presetObj->setProperty("osc1Wave", parameters.getRawParameterValue(OSC1_WAVE_ID)->load());
-    presetObj->setProperty("osc1Coarse", static_cast<int>(parameters.getRawParameterValue(OSC1_COARSE_ID)->load()));
-    presetObj->setProperty("osc1Fine", parameters.getRawParameterValue(OSC1_FINE_ID)->load());
-    presetObj->setProperty("osc1Mix", parameters.getRawParameterValue(OSC1_MIX_ID)->load());
-
-    presetObj->setProperty("osc2Wave", parameters.getRawParameterValue(OSC2_WAVE_ID)->load());
-    presetObj->setProperty("osc2Coarse", static_cast<int>(parameters.getRawParameterValue(OSC2_COARSE_ID)->load()));
-    presetObj->setProperty("osc2Fine", parameters.getRawParameterValue(OSC2_FINE_ID)->load());
-    presetObj->setProperty("osc2Mix", parameters.getRawParameterValue(OSC2_MIX_ID)->load());
-
-    presetObj->setProperty("osc3Wave", parameters.getRawParameterValue(OSC3_WAVE_ID)->load());
-    presetObj->setProperty("osc3Coarse", static_cast<int>(parameters.getRawParameterValue(OSC3_COARSE_ID)->load()));
-    presetObj->setProperty("osc3Fine", parameters.getRawParameterValue(OSC3_FINE_ID)->load());
-    presetObj->setProperty("osc3Mix", parameters.getRawParameterValue(OSC3_MIX_ID)->load());
-
-    // Noise oscillator
-    presetObj->setProperty("noiseType", static_cast<int>(parameters.getRawParameterValue(NOISE_TYPE_ID)->load()));
-    presetObj->setProperty("noiseDecay", parameters.getRawParameterValue(NOISE_DECAY_ID)->load());
-    presetObj->setProperty("noiseMix", parameters.getRawParameterValue(NOISE_MIX_ID)->load());
-
-    // Global controls
-    presetObj->setProperty("drive", parameters.getRawParameterValue(DRIVE_ID)->load());
-    presetObj->setProperty("volume", parameters.getRawParameterValue(VOLUME_ID)->load());
-    presetObj->setProperty("globalOctave", static_cast<int>(parameters.getRawParameterValue(GLOBAL_OCTAVE_ID)->load()));
-
-    // Analog character
-    presetObj->setProperty("drift", parameters.getRawParameterValue(DRIFT_ID)->load());
-    presetObj->setProperty("phaseRandom", parameters.getRawParameterValue(PHASE_RANDOM_ID)->load());
-    presetObj->setProperty("unison", parameters.getRawParameterValue(UNISON_ID)->load());
-
-    // Amp ADSR
-    presetObj->setProperty("ampAttack", parameters.getRawParameterValue(AMP_ATTACK_ID)->load());
-    presetObj->setProperty("ampDecay", parameters.getRawParameterValue(AMP_DECAY_ID)->load());
-    presetObj->setProperty("ampSustain", parameters.getRawParameterValue(AMP_SUSTAIN_ID)->load());
-    presetObj->setProperty("ampRelease", parameters.getRawParameterValue(AMP_RELEASE_ID)->load());
-
-    // Filter ADSR
-    presetObj->setProperty("filterAttack", parameters.getRawParameterValue(FILTER_ATTACK_ID)->load());
-    presetObj->setProperty("filterDecay", parameters.getRawParameterValue(FILTER_DECAY_ID)->load());
-    presetObj->setProperty("filterSustain", parameters.getRawParameterValue(FILTER_SUSTAIN_ID)->load());
-    presetObj->setProperty("filterRelease", parameters.getRawParameterValue(FILTER_RELEASE_ID)->load());
-
-    // Delay
-    presetObj->setProperty("delayTime", static_cast<int>(parameters.getRawParameterValue(DELAY_TIME_ID)->load()));
-    presetObj->setProperty("delayFeedback", parameters.getRawParameterValue(DELAY_FEEDBACK_ID)->load());
-    presetObj->setProperty("delayMix", parameters.getRawParameterValue(DELAY_MIX_ID)->load());
-
-    // FIRST: Update the in-memory combined preset list immediately
-    if (synthPresetsJSON.isObject())
+    // Every parameter with a preset key in the schema
+    for (const auto& spec : Param::kSpecs)
     {
-        auto* combinedObj = synthPresetsJSON.getDynamicObject();
-        if (combinedObj != nullptr)
-        {
-            juce::Array<juce::var>* combinedArray = combinedObj->getProperty("presets").getArray();
-            if (combinedArray != nullptr)
-            {
-                combinedArray->add(preset);
-            }
-        }
-    }
+        if (spec.presetKey == nullptr)
+            continue;
 
-    // SECOND: Load existing user presets from file
-    juce::File dataDir = getDataDirectory();
-    dataDir.createDirectory();
-    juce::File userPresetFile = dataDir.getChildFile("synth_presets_user.json");
-
-    juce::Array<juce::var> userPresetsArray;
-
-    if (userPresetFile.existsAsFile())
-    {
-        juce::String jsonText = userPresetFile.loadFileAsString();
-        auto result = juce::JSON::parse(jsonText);
-        if (result.isObject())
-        {
-            auto* obj = result.getDynamicObject();
-            if (obj != nullptr)
-            {
-                const juce::Array<juce::var>* arr = obj->getProperty("presets").getArray();
-                if (arr != nullptr)
-                {
-                    userPresetsArray = *arr;
-                }
-            }
-        }
-    }
-
-    // Add new preset
-    userPresetsArray.add(preset);
-
-    // Build user presets JSON structure
-    juce::var userPresetsRoot = new juce::DynamicObject();
-    juce::var presetsArrayVar(userPresetsArray);
-    userPresetsRoot.getDynamicObject()->setProperty("presets", presetsArrayVar);
-
-    // Use JUCE's built-in JSON serializer
-    juce::String jsonOutput = juce::JSON::toString(userPresetsRoot, true);
-    userPresetFile.replaceWithText(jsonOutput);
+        if (spec.isDiscrete())
+            presetObj->setProperty(spec.presetKey, static_cast<int>(param(spec.index)));
+        else
+            presetObj->setProperty(spec.presetKey, param(spec.index));
+    }
+
+    // The row the bank will compile for it, so it can be loaded before the bank is rebuilt
+    PendingPreset pending;
+    pending.bank = PresetJournal::Bank::synth;
+    pending.preset = preset;
+    pending.values.fill(std::numeric_limits<float>::quiet_NaN());
+    for (const auto& spec : Param::kSpecs)
+        if (spec.presetKey != nullptr)
+            pending.values[static_cast<size_t>(spec.index)] = static_cast<float>(presetObj->getProperty(spec.presetKey));
+
+    // Journaled and compacted into the user bank in the background
+    pending.journalSequence = presetJournal->append(PresetJournal::Bank::synth, preset);
+    pendingPresets.push_back(pending);
+    rebuildProgramList();
 }
 
 void SnorkelSynthAudioProcessor::saveSequencerPresetToJSON(const juce::String& presetName)
@@ -1684,41 +972,47 @@ void SnorkelSynthAudioProcessor::saveSequencerPresetToJSON(const juce::String& p
     presetObj->setProperty("description", "User preset");
     presetObj->setProperty("version", 2); // New format version
 
+    const auto& patterns = patternStore.getCurrent();
+    const auto& melody = patterns.melody[currentMelodyPatternIndex.load()];
+
+    // Every playing step, and never fewer than 16 so the preset loads the same in any step count
+    const int numSteps = juce::jmax(16, patterns.getMelodyLength(static_cast<int>(param(Param::seqSteps))));
+
     // Save pattern as bitmasks (multiple notes per step)
     juce::Array<juce::var> pattern;
-    for (int i = 0; i < 16; ++i)
-        pattern.add(static_cast<int>(sequencerPattern[i])); // uint8_t bitmask
+    for (int i = 0; i < numSteps; ++i)
+        pattern.add(static_cast<int>(melody.noteMask[i])); // uint8_t bitmask
     presetObj->setProperty("pattern", pattern);
 
-    // Save per-note octave values (2D array: 16 steps x 8 degrees)
+    // Save per-note octave values (2D array: steps x 8 degrees)
     juce::Array<juce::var> octaves;
-    for (int step = 0; step < 16; ++step)
+    for (int step = 0; step < numSteps; ++step)
     {
         juce::Array<juce::var> stepOctaves;
         for (int degree = 0; degree < 8; ++degree)
-            stepOctaves.add(static_cast<int>(sequencerOctave[step][degree]));
+            stepOctaves.add(melody.getOctave(step, degree));
         octaves.add(juce::var(stepOctaves));
     }
     presetObj->setProperty("octave", octaves);
 
+    // Save step probabilities (percent)
+    juce::Array<juce::var> probabilities;
+    for (int step = 0; step < numSteps; ++step)
+        probabilities.add(static_cast<int>(melody.probability[step]));
+    presetObj->setProperty("probability", probabilities);
+
     // Save accent values per step (seqcutoff1-16)
-    const char* accentParamIds[] = {
-        SEQ_CUTOFF1_ID, SEQ_CUTOFF2_ID, SEQ_CUTOFF3_ID, SEQ_CUTOFF4_ID,
-        SEQ_CUTOFF5_ID, SEQ_CUTOFF6_ID, SEQ_CUTOFF7_ID, SEQ_CUTOFF8_ID,
-        SEQ_CUTOFF9_ID, SEQ_CUTOFF10_ID, SEQ_CUTOFF11_ID, SEQ_CUTOFF12_ID,
-        SEQ_CUTOFF13_ID, SEQ_CUTOFF14_ID, SEQ_CUTOFF15_ID, SEQ_CUTOFF16_ID
-    };
     juce::Array<juce::var> accents;
     for (int i = 0; i < 16; ++i)
-        accents.add(parameters.getRawParameterValue(accentParamIds[i])->load());
+        accents.add(param(Param::seqCutoff(i)));
     presetObj->setProperty("accents", accents);
 
     // Save accent dial settings
-    presetObj->setProperty("accentVol", parameters.getRawParameterValue(SEQ_ACCENT_VOL_ID)->load());
-    presetObj->setProperty("accentCutoff", parameters.getRawParameterValue(SEQ_ACCENT_CUTOFF_ID)->load());
-    presetObj->setProperty("accentRes", parameters.getRawParameterValue(SEQ_ACCENT_RES_ID)->load());
-    presetObj->setProperty("accentDecay", parameters.getRawParameterValue(SEQ_ACCENT_DECAY_ID)->load());
-    presetObj->setProperty("accentDrive", parameters.getRawParameterValue(SEQ_ACCENT_DRIVE_ID)->load());
+    presetObj->setProperty("accentVol", param(Param::seqAccentVol));
+    presetObj->setProperty("accentCutoff", param(Param::seqAccentCutoff));
+    presetObj->setProperty("accentRes", param(Param::seqAccentRes));
+    presetObj->setProperty("accentDecay", param(Param::seqAccentDecay));
+    presetObj->setProperty("accentDrive", param(Param::seqAccentDrive));
 
     // FIRST: Update the in-memory combined preset list immediately
     if (sequencerPresetsJSON.isObject())
@@ -1734,72 +1028,80 @@ void SnorkelSynthAudioProcessor::saveSequencerPresetToJSON(const juce::String& p
         }
     }
 
-    // SECOND: Load existing user presets from file
-    juce::File dataDir = getDataDirectory();
-    dataDir.createDirectory();
-    juce::File userSeqPresetFile = dataDir.getChildFile("sequencer_presets_user.json");
-
-    juce::Array<juce::var> userPresetsArray;
-
-    if (userSeqPresetFile.existsAsFile())
-    {
-        juce::String jsonText = userSeqPresetFile.loadFileAsString();
-        auto result = juce::JSON::parse(jsonText);
-        if (result.isObject())
-        {
-            auto* obj = result.getDynamicObject();
-            if (obj != nullptr)
-            {
-                const juce::Array<juce::var>* arr = obj->getProperty("presets").getArray();
-                if (arr != nullptr)
-                {
-                    userPresetsArray = *arr;
-                }
-            }
-        }
-    }
-
-    // Add new preset
-    userPresetsArray.add(preset);
-
-    // Build user presets JSON structure
-    juce::var userPresetsRoot = new juce::DynamicObject();
-    juce::var presetsArrayVar(userPresetsArray);
-    userPresetsRoot.getDynamicObject()->setProperty("presets", presetsArrayVar);
-
-    // Use JUCE's built-in JSON serializer
-    juce::String jsonOutput = juce::JSON::toString(userPresetsRoot, true);
-    userSeqPresetFile.replaceWithText(jsonOutput);
+    // SECOND: Journal it for the user bank (written in the background)
+    PendingPreset pending;
+    pending.bank = PresetJournal::Bank::sequencer;
+    pending.preset = preset;
+    pending.journalSequence = presetJournal->append(PresetJournal::Bank::sequencer, preset);
+    pendingPresets.push_back(pending);
 }
 
 juce::StringArray SnorkelSynthAudioProcessor::getSynthPresetNames() const
+{
+    const juce::ScopedLock sl(programLock);
+    return programNames;
+}
+
+void SnorkelSynthAudioProcessor::rebuildProgramList()
 {
     juce::StringArray names;
 
-    if (synthPresetsJSON.isObject())
+    if (synthPresetBank != nullptr)
     {
-        auto* obj = synthPresetsJSON.getDynamicObject();
-        if (obj != nullptr)
+        names.ensureStorageAllocated(synthPresetBank->getNumPresets() + 1);
+
+        for (int i = 0; i < synthPresetBank->getNumPresets(); ++i)
         {
-            const juce::Array<juce::var>* presetsArray = obj->getProperty("presets").getArray();
-            if (presetsArray != nullptr)
-            {
-                for (int i = 0; i < presetsArray->size(); ++i)
-                {
-                    // Add divider before user presets
-                    if (i == numSystemSynthPresets && numSystemSynthPresets > 0 && i < presetsArray->size())
-                    {
-                        names.add("** User presets **");
-                    }
+            // Add divider before user presets
+            if (i == numSystemSynthPresets && numSystemSynthPresets > 0)
+                names.add("** User presets **");
+
+            names.add(synthPresetBank->getName(i));
+        }
 
-                    if (auto* presetObj = (*presetsArray)[i].getDynamicObject())
-                        names.add(presetObj->getProperty("name").toString());
-                }
-            }
+        // Saved presets the bank doesn't have yet go where the reloaded bank will put them
+        bool needsDivider = synthPresetBank->getNumPresets() == numSystemSynthPresets && numSystemSynthPresets > 0;
+        for (const auto& pending : pendingPresets)
+        {
+            if (pending.bank != PresetJournal::Bank::synth)
+                continue;
+
+            if (needsDivider)
+                names.add("** User presets **");
+            needsDivider = false;
+
+            names.add(pending.preset.getProperty("name", {}).toString());
         }
     }
 
-    return names;
+    {
+        const juce::ScopedLock sl(programLock);
+        programNames.swapWith(names);
+        currentProgram = juce::jlimit(0, juce::jmax(0, programNames.size() - 1), currentProgram);
+    }
+
+    // Let the host re-read the program list
+    updateHostDisplay(juce::AudioProcessorListener::ChangeDetails().withProgramChanged(true));
+}
+
+const SnorkelSynthAudioProcessor::PendingPreset* SnorkelSynthAudioProcessor::getPendingSynthPreset(int index) const
+{
+    for (const auto& pending : pendingPresets)
+        if (pending.bank == PresetJournal::Bank::synth && index-- == 0)
+            return &pending;
+
+    return nullptr;
+}
+
+void SnorkelSynthAudioProcessor::presetsCompacted(int lastSequence)
+{
+    // The user banks on disk now hold these (or another instance's saves, or a
+    // journal left by an earlier session); the next load reads them back
+    const uint32_t generation = presetBankLoader->load();
+
+    for (auto& pending : pendingPresets)
+        if (pending.reloadGeneration == 0 && pending.journalSequence <= lastSequence)
+            pending.reloadGeneration = generation;
 }
 
 juce::StringArray SnorkelSynthAudioProcessor::getSequencerPresetNames() const
@@ -1846,40 +1148,76 @@ juce::AudioProcessorEditor* SnorkelSynthAudioProcessor::createEditor()
 //==============================================================================
 void SnorkelSynthAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = parameters.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    std::array<float, Param::numParams> values {};
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = paramValues[i]->load();
+
+    // The pattern banks are too big for the stack. Hosts save from background threads, so copy through a pin.
+    auto patterns = std::make_unique<PluginState::Patterns>();
+    patternStore.copyLatest(*patterns);
+    patterns->currentMelodyPattern = currentMelodyPatternIndex;
+    patterns->currentDrumPattern = currentDrumPatternIndex;
+
+    PluginState::write(destData, values, *patterns);
 }
 
 void SnorkelSynthAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    // Disabled: Always start with fresh Init preset, don't restore previous state
-    // This ensures the plugin/standalone always starts with known default values
+    if (data == nullptr || sizeInBytes <= 0)
+        return;
+
+    std::array<float, Param::numParams> values {};
+    auto patterns = std::make_unique<PluginState::Patterns>(); // Too big for the stack
+    bool hasPatterns = false;
+
+    if (!PluginState::read(data, static_cast<size_t>(sizeInBytes), values, *patterns, hasPatterns))
+    {
+        // States saved before the binary format hold only the parameter XML
+        std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+        if (xmlState == nullptr || !xmlState->hasTagName(parameters.state.getType()))
+            return;
+
+        parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+        initialPresetPending = false;
+        return;
+    }
+
+    // The restored state replaces the first preset that would load with the banks
+    initialPresetPending = false;
+
+    // Parameters added since the state was saved start from their defaults
+    for (const auto& spec : Param::kSpecs)
+        if (std::isnan(values[static_cast<size_t>(spec.index)]))
+            values[static_cast<size_t>(spec.index)] = spec.defaultValue;
 
-    // std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-    // if (xmlState.get() != nullptr)
-    //     if (xmlState->hasTagName(parameters.state.getType()))
-    //         parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    applyParameterValues(values.data(), false, false);
+
+    if (hasPatterns)
+    {
+        patternStore.edit([&patterns](PatternData& data) { data = *patterns; });
+        currentMelodyPatternIndex = patterns->currentMelodyPattern;
+        pendingMelodyPatternIndex = -1;
+        currentDrumPatternIndex = patterns->currentDrumPattern;
+        pendingDrumPatternIndex = -1;
+    }
 }
 
 //==============================================================================
 // Arpeggiator Implementation
 
-void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessages, int numSamples)
+void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessages, int startSample, int numSamples)
 {
-    bool arpEnabled = parameters.getRawParameterValue(ARP_ONOFF_ID)->load() > 0.5f;
+    bool arpEnabled = param(Param::arpOnOff) > 0.5f;
 
     // If arpeggiator is disabled, clear state and pass through MIDI
     if (!arpEnabled)
     {
         heldNotes.clear();
-        currentArpNote = 0;
-        arpStepTime = 0.0;
+        arpPattern.restart();
         arpStepCounter = 0;
-        lastNoteOffTime = 0.0;
         if (isNoteCurrentlyOn && lastPlayedNote >= 0)
         {
-            midiMessages.addEvent(juce::MidiMessage::noteOff(1, lastPlayedNote), 0);
+            midiMessages.addEvent(juce::MidiMessage::noteOff(1, lastPlayedNote), startSample);
             isNoteCurrentlyOn = false;
         }
         lastPlayedNote = -1;
@@ -1887,7 +1225,8 @@ void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessag
     }
 
     // Arpeggiator is enabled - process incoming MIDI to build held notes list
-    juce::MidiBuffer processedMidi;
+    auto& processedMidi = arpMidi;
+    processedMidi.clear();
 
     for (const auto metadata : midiMessages)
     {
@@ -1897,16 +1236,13 @@ void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessag
         {
             int note = message.getNoteNumber();
             // Add note to held notes if not already there
-            if (std::find(heldNotes.begin(), heldNotes.end(), note) == heldNotes.end())
+            bool wasEmpty = heldNotes.empty();
+            if (heldNotes.add(note)) // Kept in played order; the arp pattern sorts for the other modes
             {
-                bool wasEmpty = heldNotes.empty();
-                heldNotes.push_back(note);
-                std::sort(heldNotes.begin(), heldNotes.end()); // Keep sorted for Up mode
-
-                // If this is the first note pressed, trigger immediately by setting arpStepTime high
+                // If this is the first note pressed, trigger immediately
                 if (wasEmpty)
                 {
-                    arpStepTime = 999999.0; // Large value to trigger first note immediately
+                    arpCursor.restartAt(transportClock.getBeat());
                     arpStepCounter = 0; // Reset swing counter for new arpeggio sequence
                 }
             }
@@ -1915,7 +1251,7 @@ void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessag
         {
             int note = message.getNoteNumber();
             // Remove note from held notes
-            heldNotes.erase(std::remove(heldNotes.begin(), heldNotes.end(), note), heldNotes.end());
+            heldNotes.remove(note);
 
             // If no notes held, send note-off for last played note
             if (heldNotes.empty())
@@ -1926,8 +1262,7 @@ void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessag
                     isNoteCurrentlyOn = false;
                 }
                 lastPlayedNote = -1;
-                currentArpNote = 0;
-                arpStepTime = 0.0;
+                arpPattern.restart();
                 arpStepCounter = 0;
             }
         }
@@ -1935,7 +1270,7 @@ void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessag
     }
 
     // If progression is enabled and no manual keys are pressed, generate chord notes automatically
-    bool progEnabled = parameters.getRawParameterValue(PROG_ENABLED_ID)->load() > 0.5f;
+    bool progEnabled = param(Param::progEnabled) > 0.5f;
     bool hasManualNotes = false;
 
     // Check if there are any manually held notes (from MIDI input)
@@ -1953,24 +1288,23 @@ void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessag
             int progressionOffset = getCurrentProgressionOffset();
 
             // Convert to MIDI note (using sequencer scale and root)
-            int rootNote = static_cast<int>(parameters.getRawParameterValue(SEQ_ROOT_ID)->load());
-            int scaleType = static_cast<int>(parameters.getRawParameterValue(SEQ_SCALE_ID)->load());
+            int rootNote = static_cast<int>(param(Param::seqRoot));
+            int scaleType = static_cast<int>(param(Param::seqScale));
 
             // Generate a triad (root, 3rd, 5th) based on the progression value
-            int baseNote = scaleDegreesToMidiNote(progressionOffset, rootNote, scaleType);
-            int third = scaleDegreesToMidiNote((progressionOffset + 2) % 8, rootNote, scaleType);
-            int fifth = scaleDegreesToMidiNote((progressionOffset + 4) % 8, rootNote, scaleType);
+            int baseNote = SequencerEventList::scaleDegreeToNote(progressionOffset, rootNote, scaleType);
+            int third = SequencerEventList::scaleDegreeToNote((progressionOffset + 2) % 8, rootNote, scaleType);
+            int fifth = SequencerEventList::scaleDegreeToNote((progressionOffset + 4) % 8, rootNote, scaleType);
 
             // Clear and regenerate chord notes for arpeggiator
             heldNotes.clear();
-            heldNotes.push_back(baseNote);
-            heldNotes.push_back(third);
-            heldNotes.push_back(fifth);
-            std::sort(heldNotes.begin(), heldNotes.end());
+            heldNotes.add(baseNote);
+            heldNotes.add(third);
+            heldNotes.add(fifth);
 
             // Reset arp to start from beginning with new chord
-            currentArpNote = 0;
-            arpStepTime = 999999.0; // Trigger immediately
+            arpPattern.restart();
+            arpCursor.restartAt(transportClock.getBeat()); // Trigger immediately
             arpStepCounter = 0;
         }
     }
@@ -1983,39 +1317,32 @@ void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessag
     // Generate arpeggiated notes only if playback is active
     if (!heldNotes.empty() && isPlaybackActive)
     {
-        double baseStepLength = getArpStepLengthInSamples();
-        float gateLength = parameters.getRawParameterValue(ARP_GATE_ID)->load();
-        int octaveShift = static_cast<int>(parameters.getRawParameterValue(ARP_OCTAVE_SHIFT_ID)->load());
-        float swing = parameters.getRawParameterValue(ARP_SWING_ID)->load();
+        double baseStepBeats = getArpStepBeats();
+        float gateLength = param(Param::arpGate);
+        int octaveShift = static_cast<int>(param(Param::arpOctaveShift));
+        float swing = param(Param::arpSwing);
 
-        // Apply swing: delays off-beat notes without changing note length
-        // Even steps (0, 2, 4...) wait longer before next note, odd steps wait shorter
-        // This keeps total pair duration constant while shifting the off-beat
-        double swingAmount = (arpStepCounter % 2 == 0) ? (1.0 + swing * 0.5) : (1.0 - swing * 0.5);
-        double stepLength = baseStepLength * swingAmount;
-        double noteOffTime = baseStepLength * gateLength; // Note length unaffected by swing
-
-        // Clamp arpStepTime when BPM increases (prevents rapid note triggers)
-        if (arpStepTime > stepLength)
-        {
-            arpStepTime = std::fmod(arpStepTime, stepLength);
-        }
-        arpStepTime += numSamples;
+        // Events fall due at the start of this sub-block: processBlock splits
+        // sub-blocks at step and gate boundaries (see getSamplesUntilNextStepEvent)
 
         // Check if we need to turn off the current note
-        if (isNoteCurrentlyOn && lastNoteOffTime <= 0 && lastPlayedNote >= 0)
+        if (isNoteCurrentlyOn && transportClock.isDue(arpNoteOffBeat) && lastPlayedNote >= 0)
         {
-            processedMidi.addEvent(juce::MidiMessage::noteOff(1, lastPlayedNote), 0);
+            processedMidi.addEvent(juce::MidiMessage::noteOff(1, lastPlayedNote), startSample);
             isNoteCurrentlyOn = false;
         }
 
         // Check if it's time for the next arp step
-        if (arpStepTime >= stepLength)
+        if (arpCursor.isDue(transportClock))
         {
+            // Swing delays off-beat notes without changing note length: even steps
+            // wait longer before the next note, odd steps shorter (see TransportClock)
+            const double stepBeats = TransportClock::swungStepBeats(baseStepBeats, swing, arpStepCounter);
+
             // Send note-off for previous note if still on
             if (isNoteCurrentlyOn && lastPlayedNote >= 0)
             {
-                processedMidi.addEvent(juce::MidiMessage::noteOff(1, lastPlayedNote), 0);
+                processedMidi.addEvent(juce::MidiMessage::noteOff(1, lastPlayedNote), startSample);
                 isNoteCurrentlyOn = false;
             }
 
@@ -2030,205 +1357,146 @@ void SnorkelSynthAudioProcessor::processArpeggiator(juce::MidiBuffer& midiMessag
                 // Constrain to valid MIDI range (0-127)
                 shiftedNote = juce::jlimit(0, 127, shiftedNote);
 
-                processedMidi.addEvent(juce::MidiMessage::noteOn(1, shiftedNote, (juce::uint8)100), 0);
+                processedMidi.addEvent(juce::MidiMessage::noteOn(1, shiftedNote, (juce::uint8)100), startSample);
                 lastPlayedNote = shiftedNote;
                 isNoteCurrentlyOn = true;
-                lastNoteOffTime = noteOffTime;
+                arpNoteOffBeat = arpCursor.getNextBeat() + baseStepBeats * gateLength; // Note length unaffected by swing
 
                 // Increment step counter for swing timing
                 arpStepCounter++;
             }
 
-            arpStepTime -= stepLength;
-
-            // Recalculate stepLength for next step (swing depends on step counter)
-            swingAmount = (arpStepCounter % 2 == 0) ? (1.0 + swing * 0.5) : (1.0 - swing * 0.5);
-            stepLength = baseStepLength * swingAmount;
+            arpCursor.advance(stepBeats, transportClock);
         }
-
-        lastNoteOffTime -= numSamples;
     }
 
     // Replace MIDI buffer with processed arpeggiator output
     midiMessages.swapWith(processedMidi);
 }
 
-double SnorkelSynthAudioProcessor::getArpStepLengthInSamples() const
+double SnorkelSynthAudioProcessor::getArpStepBeats() const
 {
-    int rateIndex = static_cast<int>(parameters.getRawParameterValue(ARP_RATE_ID)->load());
-
-    // Rate divisions: 1/32, 1/32., 1/16, 1/16., 1/16T, 1/8, 1/8., 1/8T, 1/4, 1/4., 1/4T, 1/2, 1/2., 1/1
-    const double divisions[] = {
-        8.0,        // 1/32
-        5.333,      // 1/32. (dotted)
-        4.0,        // 1/16
-        2.667,      // 1/16. (dotted)
-        6.0,        // 1/16T (triplet)
-        2.0,        // 1/8
-        1.333,      // 1/8. (dotted)
-        3.0,        // 1/8T (triplet)
-        1.0,        // 1/4
-        0.667,      // 1/4. (dotted)
-        1.5,        // 1/4T (triplet)
-        0.5,        // 1/2
-        0.333,      // 1/2. (dotted)
-        0.25        // 1/1 (whole note)
-    };
-
-    rateIndex = juce::jlimit(0, 13, rateIndex);
-
-    double beatsPerSecond = currentBPM / 60.0;
-    double notesPerBeat = divisions[rateIndex];
-    double stepFrequency = beatsPerSecond * notesPerBeat;
-
-    return currentSampleRate / stepFrequency;
+    return TransportClock::noteRateToBeats(static_cast<int>(param(Param::arpRate)));
 }
 
 int SnorkelSynthAudioProcessor::getNextArpNote()
 {
-    if (heldNotes.empty())
-        return -1;
-
-    int mode = static_cast<int>(parameters.getRawParameterValue(ARP_MODE_ID)->load());
-    int octaves = static_cast<int>(parameters.getRawParameterValue(ARP_OCTAVES_ID)->load());
-
-    // Calculate total number of notes across octaves
-    int totalNotes = static_cast<int>(heldNotes.size()) * octaves;
-
-    if (totalNotes == 0)
-        return -1;
-
-    int noteIndex = 0;
-
-    switch (mode)
-    {
-        case 0: // Up
-            noteIndex = currentArpNote % totalNotes;
-            break;
-
-        case 1: // Down
-            noteIndex = (totalNotes - 1) - (currentArpNote % totalNotes);
-            break;
-
-        case 2: // Up-Down
-        {
-            int cycle = totalNotes * 2 - 2;
-            if (cycle <= 0) cycle = 1;
-            int pos = currentArpNote % cycle;
-            noteIndex = (pos < totalNotes) ? pos : (cycle - pos);
-            break;
-        }
-
-        case 3: // Random
-            noteIndex = juce::Random::getSystemRandom().nextInt(totalNotes);
-            break;
-
-        case 4: // As Played
-            noteIndex = currentArpNote % totalNotes;
-            break;
-    }
-
-    // Convert note index to actual MIDI note with octave
-    int baseNoteIndex = noteIndex % static_cast<int>(heldNotes.size());
-    int octaveOffset = noteIndex / static_cast<int>(heldNotes.size());
-    int midiNote = heldNotes[baseNoteIndex] + (octaveOffset * 12);
-
-    currentArpNote++;
-
-    return juce::jlimit(0, 127, midiNote);
+    // The cycle only recompiles when the held notes, mode or octaves changed since the last step
+    arpPattern.update(heldNotes, static_cast<int>(param(Param::arpMode)), static_cast<int>(param(Param::arpOctaves)));
+    return arpPattern.next();
 }
 
 //==============================================================================
 // Sequencer Implementation
 
-void SnorkelSynthAudioProcessor::processSequencer(juce::MidiBuffer& midiMessages, int numSamples)
+void SnorkelSynthAudioProcessor::processSequencer(juce::MidiBuffer& midiMessages, int startSample, int numSamples)
 {
-    bool seqEnabled = parameters.getRawParameterValue(SEQ_ENABLED_ID)->load() > 0.5f;
+    bool seqEnabled = param(Param::seqEnabled) > 0.5f;
 
     // Check if playback is active and sequencer is enabled
     if (!seqEnabled || !isPlaybackActive)
     {
-        // Reset sequencer state when disabled
+        // Reset sequencer state when disabled; when enabled it starts on the next swing pair
         currentSeqStep = 0;
-        seqStepTime = 0.0;
+        seqCursor.restartAt(transportClock.nextGridBeat(getSeqStepBeats() * 2.0));
+
+        // Nothing is playing, so a song starts over and a selected pattern takes over at once
+        if (param(Param::seqSongEnabled) > 0.5f)
+        {
+            setSongPosition({});
+        }
+        else
+        {
+            const int pending = pendingMelodyPatternIndex.exchange(-1);
+            if (pending >= 0)
+                currentMelodyPatternIndex = pending;
+        }
+
         if (isSeqNoteCurrentlyOn && !lastSeqPlayedNotes.empty())
         {
             for (int note : lastSeqPlayedNotes)
-                midiMessages.addEvent(juce::MidiMessage::noteOff(1, note, (juce::uint8)64), 0);
+                midiMessages.addEvent(juce::MidiMessage::noteOff(1, note, (juce::uint8)64), startSample);
             lastSeqPlayedNotes.clear();
             isSeqNoteCurrentlyOn = false;
         }
         return;
     }
 
-    // Get step length in samples with swing
-    double baseStepLength = getSeqStepLengthInSamples();
-    float swing = parameters.getRawParameterValue(ARP_SWING_ID)->load();
-    // Swing delays off-beat notes: even steps wait longer, odd steps wait shorter
-    double swingAmount = (currentSeqStep % 2 == 0) ? (1.0 + swing * 0.5) : (1.0 - swing * 0.5);
-    double stepLength = baseStepLength * swingAmount;
-    float gateLength = parameters.getRawParameterValue(SEQ_GATE_ID)->load();
-    double noteOffLength = baseStepLength * gateLength; // Note length unaffected by swing
+    double baseStepBeats = getSeqStepBeats();
+    float swing = param(Param::arpSwing);
 
-    juce::MidiBuffer processedMidi;
+    auto& processedMidi = seqMidi;
+    processedMidi.clear();
 
-    // Handle note-off for previous notes
-    if (isSeqNoteCurrentlyOn && lastSeqNoteOffTime >= 0.0)
+    // Handle note-off for previous notes once their gate ends
+    if (isSeqNoteCurrentlyOn && transportClock.isDue(seqNoteOffBeat))
     {
-        lastSeqNoteOffTime -= numSamples;
-        if (lastSeqNoteOffTime <= 0.0 && !lastSeqPlayedNotes.empty())
-        {
-            for (int note : lastSeqPlayedNotes)
-                processedMidi.addEvent(juce::MidiMessage::noteOff(1, note, (juce::uint8)64), 0);
-            lastSeqPlayedNotes.clear();
-            isSeqNoteCurrentlyOn = false;
-            lastSeqNoteOffTime = -1.0;
-        }
+        for (int note : lastSeqPlayedNotes)
+            processedMidi.addEvent(juce::MidiMessage::noteOff(1, note, (juce::uint8)64), startSample);
+        lastSeqPlayedNotes.clear();
+        isSeqNoteCurrentlyOn = false;
     }
 
-    seqStepTime += numSamples;
-
-    // Trigger new step (limit to 1 step per block to prevent machine-gun effect on BPM increase)
-    if (seqStepTime >= stepLength)
+    // Trigger the step due at the start of this sub-block (processBlock cuts sub-blocks at every step)
+    if (seqCursor.isDue(transportClock))
     {
-        seqStepTime -= stepLength;
-
         // Turn off any currently playing notes before starting new ones
         if (isSeqNoteCurrentlyOn && !lastSeqPlayedNotes.empty())
         {
             for (int note : lastSeqPlayedNotes)
-                processedMidi.addEvent(juce::MidiMessage::noteOff(1, note, (juce::uint8)64), 0);
+                processedMidi.addEvent(juce::MidiMessage::noteOff(1, note, (juce::uint8)64), startSample);
             lastSeqPlayedNotes.clear();
             isSeqNoteCurrentlyOn = false;
         }
 
-        // Get all notes for current step
-        std::vector<int> midiNotes = getSequencerNotes(currentSeqStep);
+        // The bar's notes are compiled ahead; this only recompiles after an edit or a chord change
+        seqEvents.update(getSequencerInputs());
 
-        if (!midiNotes.empty())
+        const auto* first = seqEvents.stepBegin(currentSeqStep);
+        const auto* last = seqEvents.stepEnd(currentSeqStep);
+
+        // A step's notes play or rest together, at the step's probability
+        if (first != last && first->probability < PatternData::MelodyPattern::alwaysPlays
+            && seqGenerator.nextInt(100) >= first->probability)
+            first = last;
+
+        if (first != last)
         {
             // Trigger note-on for all notes
-            for (int midiNote : midiNotes)
-                processedMidi.addEvent(juce::MidiMessage::noteOn(1, midiNote, (juce::uint8)100), 0);
+            for (const auto* event = first; event != last; ++event)
+            {
+                processedMidi.addEvent(juce::MidiMessage::noteOn(1, event->note, event->velocity), startSample);
+                lastSeqPlayedNotes.add(event->note);
+            }
 
-            lastSeqPlayedNotes = midiNotes;
             isSeqNoteCurrentlyOn = true;
 
             // Schedule note-off (use unswung length)
-            lastSeqNoteOffTime = noteOffLength;
+            seqNoteOffBeat = seqCursor.getNextBeat()
+                           + baseStepBeats * first->length / SequencerEventList::ticksPerStep;
         }
 
-        // Advance to next step (wrap around based on user-defined step count)
-        int numSteps = static_cast<int>(parameters.getRawParameterValue(SEQ_STEPS_ID)->load());
-        currentSeqStep = (currentSeqStep + 1) % numSteps;
+        // Swing delays off-beat notes: even steps wait longer, odd steps wait shorter
+        seqCursor.advance(TransportClock::swungStepBeats(baseStepBeats, swing, currentSeqStep), transportClock);
 
-        // Recalculate stepLength for new step (swing depends on step number)
-        swingAmount = (currentSeqStep % 2 == 0) ? (1.0 + swing * 0.5) : (1.0 - swing * 0.5);
-        stepLength = baseStepLength * swingAmount;
+        // Advance to next step (wrap around based on user-defined step count)
+        currentSeqStep = (currentSeqStep + 1) % getSeqStepCount();
 
-        // Clamp seqStepTime to prevent accumulation on BPM increase
-        if (seqStepTime > stepLength)
-            seqStepTime = stepLength * 0.5;
+        // The song's next pattern, or a selected one, takes over when the current one loops
+        if (currentSeqStep == 0)
+        {
+            if (param(Param::seqSongEnabled) > 0.5f)
+            {
+                advanceSong();
+            }
+            else
+            {
+                songStarted = false;
+                const int pending = pendingMelodyPatternIndex.exchange(-1);
+                if (pending >= 0)
+                    currentMelodyPatternIndex = pending;
+            }
+        }
     }
 
     // Add processed MIDI to output
@@ -2236,135 +1504,180 @@ void SnorkelSynthAudioProcessor::processSequencer(juce::MidiBuffer& midiMessages
         midiMessages.addEvent(metadata.getMessage(), metadata.samplePosition);
 }
 
-double SnorkelSynthAudioProcessor::getSeqStepLengthInSamples() const
+double SnorkelSynthAudioProcessor::getSeqStepBeats() const
 {
-    int rateIndex = static_cast<int>(parameters.getRawParameterValue(SEQ_RATE_ID)->load());
+    return TransportClock::noteRateToBeats(static_cast<int>(param(Param::seqRate)));
+}
 
-    // Rate divisions: 1/32, 1/32., 1/16, 1/16., 1/16T, 1/8, 1/8., 1/8T, 1/4, 1/4., 1/4T, 1/2, 1/2., 1/1
-    const double divisions[] = {
-        8.0,        // 1/32
-        5.333,      // 1/32. (dotted)
-        4.0,        // 1/16
-        2.667,      // 1/16. (dotted)
-        6.0,        // 1/16T (triplet)
-        2.0,        // 1/8
-        1.333,      // 1/8. (dotted)
-        3.0,        // 1/8T (triplet)
-        1.0,        // 1/4
-        0.667,      // 1/4. (dotted)
-        1.5,        // 1/4T (triplet)
-        0.5,        // 1/2
-        0.333,      // 1/2. (dotted)
-        0.25        // 1/1 (whole note)
-    };
+int SnorkelSynthAudioProcessor::getSeqStepCount() const
+{
+    const int lastPageSteps = static_cast<int>(param(Param::seqSteps));
+    return activePatterns != nullptr ? activePatterns->getMelodyLength(lastPageSteps)
+                                     : juce::jlimit(1, PatternData::stepsPerPage, lastPageSteps);
+}
 
-    double beatsPerSecond = currentBPM / 60.0;
-    double notesPerBeat = divisions[rateIndex];
-    double stepFrequency = beatsPerSecond * notesPerBeat;
+void SnorkelSynthAudioProcessor::setSongPosition(PatternData::MelodySong::Position position)
+{
+    if (activePatterns == nullptr)
+        return;
+
+    currentSongEntry = position.entry;
+    currentSongRepeat = position.repeat;
+    songStarted = true;
 
-    return currentSampleRate / stepFrequency;
+    // Every pattern is resident, so switching is just a different pattern for the event list to read
+    currentMelodyPatternIndex = activePatterns->song.getPattern(position.entry);
+    pendingMelodyPatternIndex = -1;
 }
 
-void SnorkelSynthAudioProcessor::processDrums(int numSamples)
+void SnorkelSynthAudioProcessor::advanceSong()
 {
-    bool drumEnabled = parameters.getRawParameterValue("drumenable")->load() > 0.5f;
+    if (activePatterns == nullptr)
+        return;
+
+    // A song switched on mid-playback starts from its first entry
+    const auto& song = activePatterns->song;
+    setSongPosition(songStarted ? song.next({ currentSongEntry, currentSongRepeat }) : PatternData::MelodySong::Position {});
+}
 
-    // Get sidechain parameters (sqrt curve on magnitude for better response)
-    float sidechainMagRaw = parameters.getRawParameterValue("drumsidechainmag")->load();
-    float sidechainMag = std::sqrt(sidechainMagRaw); // 50% dial → ~71% ducking
-    float sidechainLen = parameters.getRawParameterValue("drumsidechainlen")->load();
+int SnorkelSynthAudioProcessor::getSamplesUntilNextStepEvent(int maxSamples) const
+{
+    if (!isPlaybackActive)
+        return maxSamples;
 
-    // Decay the sidechain envelope
-    // Length controls decay time: 0 = instant, 1 = full step length
-    if (sidechainLen > 0.001f)
+    // Every engine's next event is a beat on the shared clock; events already
+    // due are handled at the start of the coming sub-block
+    int samplesUntil = maxSamples;
+    auto consider = [this, &samplesUntil](double beat)
     {
-        double stepLength = getSeqStepLengthInSamples();
-        float decayTime = stepLength * sidechainLen * 2.0f; // Up to 2x step length
-        float decayRate = numSamples / decayTime;
-        sidechainEnvelope = std::max(0.0f, sidechainEnvelope - decayRate);
-    }
-    else
+        const int samples = transportClock.samplesUntil(beat);
+        if (samples > 0)
+            samplesUntil = juce::jmin(samplesUntil, samples);
+    };
+
+    // Arpeggiator step and gate
+    if (param(Param::arpOnOff) > 0.5f && !heldNotes.empty())
     {
-        sidechainEnvelope = 0.0f;
+        consider(arpCursor.getNextBeat());
+        if (isNoteCurrentlyOn)
+            consider(arpNoteOffBeat);
     }
 
-    if (!drumEnabled || !isPlaybackActive)
+    // Sequencer step and gate
+    if (param(Param::seqEnabled) > 0.5f)
     {
-        currentDrumStep = 0;
-        drumStepTime = 0.0;
-        return;
+        consider(seqCursor.getNextBeat());
+        if (isSeqNoteCurrentlyOn)
+            consider(seqNoteOffBeat);
     }
 
-    // Use same step length as sequencer with swing
-    double baseStepLength = getSeqStepLengthInSamples();
-    float swing = parameters.getRawParameterValue(ARP_SWING_ID)->load();
-    double swingAmount = (currentDrumStep % 2 == 0) ? (1.0 + swing * 0.5) : (1.0 - swing * 0.5);
-    double stepLength = baseStepLength * swingAmount;
+    // Drum steps (same grid as the sequencer)
+    if (param(Param::drumEnable) > 0.5f)
+        consider(drumCursor.getNextBeat());
+
+    // Progression steps (the arp picks up a new chord on them)
+    if (param(Param::progEnabled) > 0.5f)
+        consider(progressionCursor.getNextBeat());
+
+    return juce::jmax(1, samplesUntil);
+}
+
+void SnorkelSynthAudioProcessor::processDrums()
+{
+    bool drumEnabled = param(Param::drumEnable) > 0.5f;
+
+    // Sidechain shape for the next kick (sqrt curve on magnitude for better response)
+    // Length sets the release: 0 = off, 1 = 2x step length
+    float sidechainMag = std::sqrt(param(Param::drumSidechainMag)); // 50% dial → ~71% ducking
+    float sidechainLen = param(Param::drumSidechainLen);
+    float releaseSamples = static_cast<float>(getSeqStepBeats() * transportClock.getSamplesPerBeat()) * sidechainLen * 2.0f;
+    float msToSamples = static_cast<float>(currentSampleRate / 1000.0);
+    sidechainEnvelope.setShape(param(Param::drumSidechainAttack) * msToSamples,
+                               param(Param::drumSidechainHold) * msToSamples,
+                               sidechainLen > 0.001f ? releaseSamples : 0.0f,
+                               sidechainMag);
+
+    // Use same step length as sequencer
+    double baseStepBeats = getSeqStepBeats();
 
-    // Clamp drumStepTime when BPM increases (prevents rapid triggers)
-    if (drumStepTime > stepLength)
+    if (!drumEnabled || !isPlaybackActive)
     {
-        drumStepTime = std::fmod(drumStepTime, stepLength);
+        // Start on the next swing pair once enabled
+        currentDrumStep = 0;
+        drumCursor.restartAt(transportClock.nextGridBeat(baseStepBeats * 2.0));
+        return;
     }
-    drumStepTime += numSamples;
 
-    // Trigger new step
-    while (drumStepTime >= stepLength)
+    // Trigger the step due at the start of this sub-block (processBlock cuts sub-blocks at every step)
+    if (drumCursor.isDue(transportClock))
     {
-        drumStepTime -= stepLength;
+        // Swing depends on the step being played
+        drumCursor.advance(TransportClock::swungStepBeats(baseStepBeats, param(Param::arpSwing), currentDrumStep),
+                           transportClock);
 
         // Check each lane for triggers on this step
+        const uint32_t lanes = activePatterns->drums[currentDrumPatternIndex].lanesAt(currentDrumStep);
         for (int lane = 0; lane < NUM_DRUM_LANES; ++lane)
         {
-            if (drumPatterns[currentDrumPatternIndex][lane][currentDrumStep] != 0)
+            if ((lanes & (1u << lane)) != 0)
             {
-                // Trigger this sample
-                drumSamplePlaying[lane] = true;
-                drumSamplePositions[lane] = 0;
+                // Trigger this sample (the sub-block starts on the step)
+                drumSampler.trigger(lane);
 
                 // Kick triggers sidechain
                 if (lane == 0)
-                    sidechainEnvelope = sidechainMag;
+                    sidechainEnvelope.trigger();
             }
         }
 
-        // Advance to next step (16 steps)
-        currentDrumStep = (currentDrumStep + 1) % NUM_DRUM_STEPS;
+        // Advance to next step (wrap around based on user-defined step count)
+        currentDrumStep = (currentDrumStep + 1) % juce::jmax(1, static_cast<int>(param(Param::drumSteps)));
 
-        // At bar boundary (step 0), handle pattern switching
+        // When the pattern loops (step 0), handle pattern switching
         if (currentDrumStep == 0)
         {
-            bool chainEnabled = parameters.getRawParameterValue("drumchainenabled")->load() > 0.5f;
+            bool chainEnabled = param(Param::drumChainEnabled) > 0.5f;
 
             if (chainEnabled)
             {
                 // Advance chain step
-                int chainSteps = static_cast<int>(parameters.getRawParameterValue("drumchainsteps")->load());
+                int chainSteps = static_cast<int>(param(Param::drumChainSteps));
                 currentDrumChainStep = (currentDrumChainStep + 1) % chainSteps;
 
                 // Get pattern for this chain step
-                const char* chainStepIds[] = {
-                    "drumchainstep1", "drumchainstep2", "drumchainstep3", "drumchainstep4",
-                    "drumchainstep5", "drumchainstep6", "drumchainstep7", "drumchainstep8"
-                };
-                int patternNum = static_cast<int>(parameters.getRawParameterValue(chainStepIds[currentDrumChainStep])->load());
-                currentDrumPatternIndex = patternNum - 1; // Convert 1-8 to 0-7
+                currentDrumPatternIndex = getDrumChainPattern(currentDrumChainStep);
                 pendingDrumPatternIndex = -1; // Clear any pending manual selection
             }
-            else if (pendingDrumPatternIndex >= 0)
+            else
             {
-                // Manual pattern switch
-                currentDrumPatternIndex = pendingDrumPatternIndex;
-                pendingDrumPatternIndex = -1;
+                // Manual pattern switch (taken in one exchange so a selection made meanwhile isn't lost)
+                const int pending = pendingDrumPatternIndex.exchange(-1);
+                if (pending >= 0)
+                    currentDrumPatternIndex = pending;
             }
         }
-
-        // Recalculate stepLength for new step (swing depends on step number)
-        swingAmount = (currentDrumStep % 2 == 0) ? (1.0 + swing * 0.5) : (1.0 - swing * 0.5);
-        stepLength = baseStepLength * swingAmount;
     }
 }
 
+int SnorkelSynthAudioProcessor::getDrumChainPattern(int chainStep) const
+{
+    const int chainStepValue = static_cast<int>(param(Param::drumChainStep(chainStep)));
+    return activePatterns != nullptr ? activePatterns->getDrumChainPattern(chainStepValue)
+                                     : juce::jlimit(0, NUM_DRUM_PATTERNS - 1, chainStepValue - 1);
+}
+
+void SnorkelSynthAudioProcessor::renderDrumSamples(int startSample, int numSamples)
+{
+    float drumMasterVol = param(Param::drumMasterVol);
+    const Param::Id laneVolIds[NUM_DRUM_LANES] = { Param::drumKickVol, Param::drumSnareVol, Param::drumClosedHatVol, Param::drumOpenHatVol };
+
+    float laneGains[NUM_DRUM_LANES];
+    for (int lane = 0; lane < NUM_DRUM_LANES; ++lane)
+        laneGains[lane] = drumMasterVol * param(laneVolIds[lane]);
+
+    drumSampler.render(drumBuffer, startSample, numSamples, laneGains);
+}
+
 void SnorkelSynthAudioProcessor::selectDrumPattern(int index)
 {
     if (index >= 0 && index < NUM_DRUM_PATTERNS)
@@ -2376,7 +1689,7 @@ void SnorkelSynthAudioProcessor::selectDrumPattern(int index)
         else
         {
             // Disable chain if enabled (user implicitly chose manual control)
-            if (auto* chainParam = parameters.getParameter("drumchainenabled"))
+            if (auto* chainParam = paramObjects[static_cast<size_t>(Param::drumChainEnabled)])
                 chainParam->setValueNotifyingHost(0.0f);
 
             // Check if playback is active
@@ -2398,112 +1711,56 @@ void SnorkelSynthAudioProcessor::selectDrumPattern(int index)
     }
 }
 
-void SnorkelSynthAudioProcessor::loadDrumSamples()
+void SnorkelSynthAudioProcessor::selectMelodyPattern(int index)
 {
-    juce::File dataDir = getDataDirectory();
-    juce::File samplesDir = dataDir.getChildFile("samples");
-
-    // Sample file names for each lane
-    const juce::String sampleNames[NUM_DRUM_LANES] = {
-        "Kick - 9X9.wav",
-        "Snare - Snare Hi.wav",
-        "HatClosed - Closed Hat.wav",
-        "HatOpen - Open Hat.wav"
-    };
-
-    juce::AudioFormatManager formatManager;
-    formatManager.registerBasicFormats();
+    if (index < 0 || index >= NUM_MELODY_PATTERNS)
+        return;
 
-    for (int lane = 0; lane < NUM_DRUM_LANES; ++lane)
+    if (index == currentMelodyPatternIndex)
     {
-        juce::File sampleFile = samplesDir.getChildFile(sampleNames[lane]);
-        if (sampleFile.existsAsFile())
-        {
-            std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(sampleFile));
-            if (reader != nullptr)
-            {
-                drumSamples[lane].setSize((int)reader->numChannels, (int)reader->lengthInSamples);
-                reader->read(&drumSamples[lane], 0, (int)reader->lengthInSamples, 0, true, true);
-            }
-        }
+        pendingMelodyPatternIndex = -1; // Cancel pending if selecting current
+        return;
     }
-}
-
-std::vector<int> SnorkelSynthAudioProcessor::getSequencerNotes(int step)
-{
-    std::vector<int> notes;
-
-    if (step < 0 || step >= NUM_SEQ_STEPS)
-        return notes;
 
-    uint8_t pattern = sequencerPattern[step];
-    if (pattern == 0)
-        return notes; // No notes at this step
+    // Disable song mode (user implicitly chose manual control)
+    if (auto* songParam = paramObjects[static_cast<size_t>(Param::seqSongEnabled)])
+        songParam->setValueNotifyingHost(0.0f);
 
-    int rootNote = static_cast<int>(parameters.getRawParameterValue(SEQ_ROOT_ID)->load());
-    int scaleType = static_cast<int>(parameters.getRawParameterValue(SEQ_SCALE_ID)->load());
-    int progressionOffset = getCurrentProgressionOffset();
-
-    // Check each bit for active degrees
-    for (int degree = 0; degree < 8; ++degree)
+    // While playing, the current pattern finishes its loop first
+    if (isPlaybackActive && param(Param::seqEnabled) > 0.5f)
     {
-        if (pattern & (1 << degree))
-        {
-            int adjustedDegree = (degree + progressionOffset) % 8;
-            int midiNote = scaleDegreesToMidiNote(adjustedDegree, rootNote, scaleType);
-            // Apply per-note octave shift
-            midiNote += sequencerOctave[step][degree] * 12;
-            notes.push_back(midiNote);
-        }
+        pendingMelodyPatternIndex = index;
+    }
+    else
+    {
+        currentMelodyPatternIndex = index;
+        pendingMelodyPatternIndex = -1;
     }
+}
 
-    return notes;
+SequencerEventList::Inputs SnorkelSynthAudioProcessor::getSequencerInputs() const
+{
+    SequencerEventList::Inputs inputs;
+    inputs.pattern = activePatterns != nullptr ? &activePatterns->melody[currentMelodyPatternIndex.load()] : nullptr;
+    inputs.patternVersion = activePatterns != nullptr ? activePatterns->version : 0;
+    inputs.rootNote = static_cast<int>(param(Param::seqRoot));
+    inputs.scaleType = static_cast<int>(param(Param::seqScale));
+    inputs.activeSteps = getSeqStepCount();
+    inputs.progressionOffset = getCurrentProgressionOffset();
+    inputs.gate = param(Param::seqGate);
+
+    for (int step = 0; step < NUM_SEQ_ACCENTS; ++step)
+        inputs.accents[static_cast<size_t>(step)] = param(Param::seqCutoff(step));
+
+    return inputs;
 }
 
 float SnorkelSynthAudioProcessor::getCurrentSeqCutoffMod() const
 {
-    if (currentSeqStep < 0 || currentSeqStep >= NUM_SEQ_STEPS)
+    if (currentSeqStep < 0 || currentSeqStep >= MAX_SEQ_STEPS)
         return 0.0f;
 
-    const char* cutoffParamIds[] = {
-        SEQ_CUTOFF1_ID, SEQ_CUTOFF2_ID, SEQ_CUTOFF3_ID, SEQ_CUTOFF4_ID,
-        SEQ_CUTOFF5_ID, SEQ_CUTOFF6_ID, SEQ_CUTOFF7_ID, SEQ_CUTOFF8_ID,
-        SEQ_CUTOFF9_ID, SEQ_CUTOFF10_ID, SEQ_CUTOFF11_ID, SEQ_CUTOFF12_ID,
-        SEQ_CUTOFF13_ID, SEQ_CUTOFF14_ID, SEQ_CUTOFF15_ID, SEQ_CUTOFF16_ID
-    };
-
-    return parameters.getRawParameterValue(cutoffParamIds[currentSeqStep])->load();
-}
-
-int SnorkelSynthAudioProcessor::scaleDegreesToMidiNote(int scaleDegree, int rootNote, int scaleType)
-{
-    // Base octave (C3 = MIDI 60)
-    const int baseOctave = 60;
-
-    // Scale intervals (semitones from root)
-    // scaleDegree: 0-7 where 0=1st, 1=2nd, ..., 6=7th, 7=octave
-    static const int scaleIntervals[][8] = {
-        {0, 2, 4, 5, 7, 9, 11, 12},  // Major
-        {0, 2, 3, 5, 7, 8, 10, 12},  // Minor (Natural)
-        {0, 2, 3, 5, 7, 9, 10, 12},  // Dorian
-        {0, 1, 3, 5, 7, 8, 10, 12},  // Phrygian
-        {0, 2, 4, 6, 7, 9, 11, 12},  // Lydian
-        {0, 2, 4, 5, 7, 9, 10, 12},  // Mixolydian
-        {0, 2, 3, 5, 7, 8, 10, 12},  // Aeolian (same as Natural Minor)
-        {0, 1, 3, 5, 6, 8, 10, 12},  // Locrian
-        {0, 2, 3, 5, 7, 8, 11, 12},  // Harmonic Minor
-        {0, 2, 3, 5, 7, 9, 11, 12},  // Melodic Minor
-        {0, 2, 4, 7, 9, 12, 12, 12}, // Pentatonic Major
-        {0, 3, 5, 7, 10, 12, 12, 12},// Pentatonic Minor
-        {0, 3, 5, 6, 7, 10, 12, 12}  // Blues
-    };
-
-    scaleType = juce::jlimit(0, 12, scaleType);
-    scaleDegree = juce::jlimit(0, 7, scaleDegree);
-
-    int midiNote = baseOctave + rootNote + scaleIntervals[scaleType][scaleDegree];
-
-    return juce::jlimit(0, 127, midiNote);
+    return param(Param::seqCutoff(currentSeqStep % NUM_SEQ_ACCENTS));
 }
 
 //==============================================================================
@@ -2512,9 +1769,9 @@ int SnorkelSynthAudioProcessor::scaleDegreesToMidiNote(int scaleDegree, int root
 void SnorkelSynthAudioProcessor::updateDelayMixLFO()
 {
     // Read current LFO settings from parameters
-    delayMixLFO.rate = static_cast<int>(parameters.getRawParameterValue(DELAYMIX_LFO_RATE_ID)->load());
-    delayMixLFO.waveform = static_cast<int>(parameters.getRawParameterValue(DELAYMIX_LFO_WAVE_ID)->load());
-    delayMixLFO.depth = parameters.getRawParameterValue(DELAYMIX_LFO_DEPTH_ID)->load();
+    delayMixLFO.rate = static_cast<int>(param(Param::lfoRate(VoiceParams::delayMixLFO)));
+    delayMixLFO.waveform = static_cast<int>(param(Param::lfoWave(VoiceParams::delayMixLFO)));
+    delayMixLFO.depth = param(Param::lfoDepth(VoiceParams::delayMixLFO));
 
     // Calculate LFO frequency based on rate (tempo-synced)
     // Rates: 1/16, 1/8, 1/4, 1/3, 1/2, 3/4, 1/1, 3/2, 2/1, 3/1, 4/1, 6/1, 8/1, 12/1, 16/1
@@ -2524,7 +1781,7 @@ void SnorkelSynthAudioProcessor::updateDelayMixLFO()
     delayMixLFO.frequency = beatsPerSecond * rateMultipliers[rateIndex];
 }
 
-double SnorkelSynthAudioProcessor::getDelayMixLFOValue()
+double SnorkelSynthAudioProcessor::getDelayMixLFOValue() const
 {
     // Generate LFO value based on waveform type
     double value = 0.0;
@@ -2546,11 +1803,7 @@ double SnorkelSynthAudioProcessor::getDelayMixLFOValue()
         case 4: // Square
             value = (delayMixLFO.phase < juce::MathConstants<double>::pi) ? 1.0 : -1.0;
             break;
-        case 5: // Random (sample & hold)
-            if (delayMixLFO.phase < juce::MathConstants<double>::pi && delayMixLFO.phase + (delayMixLFO.frequency * juce::MathConstants<double>::twoPi / currentSampleRate) >= juce::MathConstants<double>::pi)
-            {
-                delayMixLFO.lastRandomValue = (static_cast<float>(rand()) / RAND_MAX) * 2.0f - 1.0f;
-            }
+        case 5: // Random (sample & hold, picked in advanceDelayMixLFO)
             value = delayMixLFO.lastRandomValue;
             break;
     }
@@ -2558,94 +1811,198 @@ double SnorkelSynthAudioProcessor::getDelayMixLFOValue()
     return value; // Returns -1 to +1
 }
 
-void SnorkelSynthAudioProcessor::advanceDelayMixLFO()
+void SnorkelSynthAudioProcessor::advanceDelayMixLFO(int numSamples)
 {
-    delayMixLFO.phase += delayMixLFO.frequency * juce::MathConstants<double>::twoPi / currentSampleRate;
-    if (delayMixLFO.phase >= juce::MathConstants<double>::twoPi)
-        delayMixLFO.phase -= juce::MathConstants<double>::twoPi;
-}
+    const double increment = delayMixLFO.frequency * juce::MathConstants<double>::twoPi / currentSampleRate * numSamples;
 
-//==============================================================================
-// Progression Implementation
+    // Pick a new random value each time the phase crosses the half-cycle point
+    if (delayMixLFO.phase < juce::MathConstants<double>::pi && delayMixLFO.phase + increment >= juce::MathConstants<double>::pi)
+        delayMixLFO.lastRandomValue = delayMixRandom.nextFloat() * 2.0f - 1.0f;
+
+    delayMixLFO.phase = std::fmod(delayMixLFO.phase + increment, juce::MathConstants<double>::twoPi);
+}
 
-void SnorkelSynthAudioProcessor::updateProgressionStep(int numSamples)
+void SnorkelSynthAudioProcessor::fillDelayMixCurve(float baseMix, int startSample, int numSamples)
 {
-    bool progEnabled = parameters.getRawParameterValue(PROG_ENABLED_ID)->load() > 0.5f;
+    jassert(static_cast<int>(delayMixCurve.size()) >= startSample + numSamples); // Sized in prepareToPlay
+    float* curve = delayMixCurve.data() + startSample;
 
-    if (!progEnabled || !isPlaybackActive)
+    if (delayMixLFO.depth <= 0.001f)
     {
-        progressionBarTime = 0.0;
-        currentProgressionStep = 0;
-        progressionWasEnabled = false;
-        progressionSyncedToBar = false;
+        juce::FloatVectorOperations::fill(curve, juce::jlimit(0.0f, 1.0f, baseMix), numSamples);
+        delayMixLFO.segmentPosition = -1; // Start a fresh segment when the LFO comes back
         return;
     }
 
-    // Calculate samples per bar (4 beats)
-    double samplesPerBar = (currentSampleRate * 60.0 / currentBPM) * 4.0;
+    // Evaluate the LFO every kDelayMixLFOInterval samples and ramp linearly in between.
+    // Segments carry on across calls, so where they fall doesn't depend on block sizes.
+    auto mixAtPhase = [this, baseMix]
+    {
+        return juce::jlimit(0.0f, 1.0f, baseMix + static_cast<float>(getDelayMixLFOValue()) * delayMixLFO.depth);
+    };
 
-    // If progression was just enabled, wait for next bar boundary
-    if (!progressionWasEnabled)
+    if (delayMixLFO.segmentPosition < 0)
     {
-        progressionWasEnabled = true;
-        progressionSyncedToBar = false;
-        progressionBarTime = 0.0;
-        currentProgressionStep = 0;
+        delayMixLFO.segmentEnd = mixAtPhase();
+        delayMixLFO.segmentPosition = kDelayMixLFOInterval;
+    }
+
+    for (int i = 0; i < numSamples;)
+    {
+        if (delayMixLFO.segmentPosition >= kDelayMixLFOInterval)
+        {
+            delayMixLFO.segmentStart = delayMixLFO.segmentEnd;
+            advanceDelayMixLFO(kDelayMixLFOInterval);
+            delayMixLFO.segmentEnd = mixAtPhase();
+            delayMixLFO.segmentPosition = 0;
+        }
+
+        const int count = juce::jmin(numSamples - i, kDelayMixLFOInterval - delayMixLFO.segmentPosition);
+        const float step = (delayMixLFO.segmentEnd - delayMixLFO.segmentStart) / static_cast<float>(kDelayMixLFOInterval);
+        for (int j = 0; j < count; ++j)
+            curve[i + j] = delayMixLFO.segmentStart + step * static_cast<float>(delayMixLFO.segmentPosition + j);
+
+        delayMixLFO.segmentPosition += count;
+        i += count;
     }
+}
 
-    // Wait for bar boundary before starting
-    if (!progressionSyncedToBar)
+//==============================================================================
+// Host timeline
+
+void SnorkelSynthAudioProcessor::followHostTimeline(bool hostPlaying, juce::Optional<double> hostPpq)
+{
+    if (hostPlaying)
     {
-        // Calculate position within current bar
-        double positionInBar = fmod(totalPlaybackTime, samplesPerBar);
+        isPlaybackActive = true;
 
-        // Check if we're close to a bar boundary (within this buffer)
-        if (positionInBar < numSamples || (samplesPerBar - positionInBar) < numSamples)
+        if (hostPpq.hasValue())
         {
-            progressionSyncedToBar = true;
-            progressionBarTime = 0.0;
-            currentProgressionStep = 0;
+            // The clock predicts where this block starts; small differences (tempo
+            // ramps within a block) just move the clock, anything else is a jump
+            const double drift = *hostPpq - transportClock.getBeat();
+            if (!hostTimelineLocked || std::abs(drift) > kMaxHostDriftBeats)
+                chaseHostPosition(*hostPpq);
+            else
+                transportClock.reset(*hostPpq);
         }
-        return; // Don't advance progression until synced
+    }
+    else if (hostWasPlaying)
+    {
+        // Host stopped: stop with it (the editor's play button drives standalone playback)
+        stopPlayback();
+    }
+
+    hostWasPlaying = hostPlaying;
+    hostTimelineLocked = hostPlaying && hostPpq.hasValue();
+}
+
+void SnorkelSynthAudioProcessor::chaseHostPosition(double beat)
+{
+    transportClock.reset(beat);
+
+    auto wrap = [](long long index, int length)
+    {
+        const auto wrapped = static_cast<int>(index % length);
+        return wrapped < 0 ? wrapped + length : wrapped;
+    };
+
+    const float swing = param(Param::arpSwing);
+
+    // Sounding notes belong to the old position: end them now
+    arpNoteOffBeat = beat;
+    seqNoteOffBeat = beat;
+
+    // Arpeggiator: keep its note order, re-phase its swing
+    const auto arpStep = TransportClock::locateStep(beat, getArpStepBeats(), swing);
+    arpCursor.restartAt(arpStep.beat);
+    arpStepCounter = wrap(arpStep.index, 2);
+
+    // Sequencer and drums: the step the pattern would be on had it played from beat 0
+    const double seqStepBeats = getSeqStepBeats();
+    const auto seqStep = TransportClock::locateStep(beat, seqStepBeats, swing);
+    seqCursor.restartAt(seqStep.beat);
+    const int seqSteps = getSeqStepCount();
+    currentSeqStep = wrap(seqStep.index, seqSteps);
+    if (param(Param::seqSongEnabled) > 0.5f && activePatterns != nullptr)
+    {
+        const long long loop = seqStep.index >= 0 ? seqStep.index / seqSteps : (seqStep.index + 1) / seqSteps - 1;
+        setSongPosition(activePatterns->song.locate(loop));
+    }
+
+    const int drumSteps = juce::jmax(1, static_cast<int>(param(Param::drumSteps)));
+    drumCursor.restartAt(seqStep.beat);
+    currentDrumStep = wrap(seqStep.index, drumSteps);
+    if (param(Param::drumChainEnabled) > 0.5f)
+    {
+        const long long loop = seqStep.index >= 0 ? seqStep.index / drumSteps : (seqStep.index + 1) / drumSteps - 1;
+        currentDrumChainStep = wrap(loop, juce::jmax(1, static_cast<int>(param(Param::drumChainSteps))));
+        currentDrumPatternIndex = getDrumChainPattern(currentDrumChainStep);
+    }
+
+    // Progression: the step whose span contains beat, on the host's bar grid
+    if (param(Param::progEnabled) > 0.5f)
+    {
+        const double barMultiplier[] = { 0.5, 1.0, 2.0, 3.0, 4.0 };
+        const int lengthIndex = juce::jlimit(0, 4, static_cast<int>(param(Param::progLength)));
+        const double stepBeats = transportClock.getBeatsPerBar() * barMultiplier[lengthIndex];
+        const double phase = transportClock.getBarPhase();
+        const double index = std::floor((beat - phase) / stepBeats + 1.0e-9);
+
+        currentProgressionStep = wrap(static_cast<long long>(index), juce::jmax(1, static_cast<int>(param(Param::progSteps))));
+        progressionSyncedToBar = true;
+        progressionCursor.restartAt(phase + (index + 1.0) * stepBeats);
+    }
+}
+
+//==============================================================================
+// Progression Implementation
+
+void SnorkelSynthAudioProcessor::updateProgressionStep()
+{
+    bool progEnabled = param(Param::progEnabled) > 0.5f;
+
+    // Bar length follows the host's time signature (4/4 standalone)
+    const double beatsPerBar = transportClock.getBeatsPerBar();
+
+    if (!progEnabled || !isPlaybackActive)
+    {
+        // Once enabled, wait for the next bar boundary before starting
+        currentProgressionStep = 0;
+        progressionSyncedToBar = false;
+        progressionCursor.restartAt(transportClock.nextBarBeat());
+        return;
     }
 
+    if (!progressionCursor.isDue(transportClock))
+        return;
+
     // Get progression parameters
-    int numSteps = static_cast<int>(parameters.getRawParameterValue(PROG_STEPS_ID)->load());
-    int lengthIndex = static_cast<int>(parameters.getRawParameterValue(PROG_LENGTH_ID)->load());
+    int numSteps = static_cast<int>(param(Param::progSteps));
+    int lengthIndex = static_cast<int>(param(Param::progLength));
 
     // Convert length index to bar multiplier (0=0.5, 1=1, 2=2, 3=3, 4=4)
     double barMultiplier[] = {0.5, 1.0, 2.0, 3.0, 4.0};
     double stepLengthBars = barMultiplier[lengthIndex];
 
-    // Calculate samples per step
-    double samplesPerStep = samplesPerBar * stepLengthBars;
-
-    progressionBarTime += numSamples;
+    // The first boundary starts step 0; later ones advance through the active steps
+    if (progressionSyncedToBar)
+        currentProgressionStep = (currentProgressionStep + 1) % numSteps;
+    else
+        progressionSyncedToBar = true;
 
-    // Check if we need to advance to next progression step
-    if (progressionBarTime >= samplesPerStep)
-    {
-        progressionBarTime -= samplesPerStep;
-        currentProgressionStep = (currentProgressionStep + 1) % numSteps; // Cycle through active steps
-    }
+    progressionCursor.advance(beatsPerBar * stepLengthBars, transportClock);
 }
 
 int SnorkelSynthAudioProcessor::getCurrentProgressionOffset() const
 {
-    bool progEnabled = parameters.getRawParameterValue(PROG_ENABLED_ID)->load() > 0.5f;
+    bool progEnabled = param(Param::progEnabled) > 0.5f;
 
     if (!progEnabled)
         return 0;
 
     // Get the progression value for the current step (1-16)
-    const char* progStepIds[] = {
-        PROG_STEP1_ID, PROG_STEP2_ID, PROG_STEP3_ID, PROG_STEP4_ID,
-        PROG_STEP5_ID, PROG_STEP6_ID, PROG_STEP7_ID, PROG_STEP8_ID,
-        PROG_STEP9_ID, PROG_STEP10_ID, PROG_STEP11_ID, PROG_STEP12_ID,
-        PROG_STEP13_ID, PROG_STEP14_ID, PROG_STEP15_ID, PROG_STEP16_ID
-    };
-
-    int stepValue = static_cast<int>(parameters.getRawParameterValue(progStepIds[currentProgressionStep])->load());
+    int stepValue = static_cast<int>(param(Param::progStep(currentProgressionStep)));
 
     // Convert to offset (step 1 = 0 offset, step 2 = 1 offset, etc.)
     return stepValue - 1;
@@ -2656,31 +2013,32 @@ int SnorkelSynthAudioProcessor::getCurrentProgressionOffset() const
 void SnorkelSynthAudioProcessor::startPlayback()
 {
     isPlaybackActive = true;
-    totalPlaybackTime = 0.0;
+
+    // Every engine starts its step 1 on beat 0
+    transportClock.reset();
 
     // Reset arpeggiator state to start from step 1
-    currentArpNote = 0;
-    arpStepTime = 0.0;
+    arpPattern.restart();
+    arpCursor.restartAt(0.0);
     arpStepCounter = 0;
-    lastNoteOffTime = 0.0;
     lastProgressionStepForArp = -1; // Force chord generation on first step
 
-    // Reset sequencer state to start from step 1
+    // Reset sequencer and drum state to start from step 1
     currentSeqStep = 0;
-    seqStepTime = 0.0;
-    lastSeqNoteOffTime = 0.0;
+    seqCursor.restartAt(0.0);
+    currentDrumStep = 0;
+    drumCursor.restartAt(0.0);
 
     // Reset progression state to start from step 1
-    progressionBarTime = 0.0;
     currentProgressionStep = 0;
-    progressionWasEnabled = true; // Prevent the reset logic in updateProgressionStep
-    progressionSyncedToBar = true; // Don't wait for bar sync, start immediately
+    progressionSyncedToBar = false;
+    progressionCursor.restartAt(0.0);
 }
 
 void SnorkelSynthAudioProcessor::stopPlayback()
 {
     isPlaybackActive = false;
-    totalPlaybackTime = 0.0; // Reset playback timer
+    transportClock.reset();
 
     // Stop any currently playing arpeggiator notes
     if (isNoteCurrentlyOn && lastPlayedNote >= 0)
@@ -2690,32 +2048,25 @@ void SnorkelSynthAudioProcessor::stopPlayback()
     lastPlayedNote = -1;
     isNoteCurrentlyOn = false;
     heldNotes.clear();
-    currentArpNote = 0;
-    arpStepTime = 0.0;
+    arpPattern.restart();
     arpStepCounter = 0;
-    lastNoteOffTime = 0.0;
     lastProgressionStepForArp = -1;
 
     // Stop any currently playing sequencer notes
-    if (isSeqNoteCurrentlyOn && lastSeqPlayedNote >= 0)
-    {
-        synth.noteOff(1, lastSeqPlayedNote, 0.0f, true);
-    }
-    lastSeqPlayedNote = -1;
+    for (int note : lastSeqPlayedNotes)
+        synth.noteOff(1, note, 0.0f, true);
+    lastSeqPlayedNotes.clear();
     isSeqNoteCurrentlyOn = false;
     currentSeqStep = 0;
-    seqStepTime = 0.0;
-    lastSeqNoteOffTime = 0.0;
 
     // Reset progression state
-    progressionBarTime = 0.0;
     currentProgressionStep = 0;
-    progressionWasEnabled = false;
     progressionSyncedToBar = false;
 }
 
 void SnorkelSynthAudioProcessor::showEditorMessage(const juce::String& message)
 {
+    SNORKEL_RT_BLOCKING("showEditorMessage"); // Touches the editor; message thread only
     if (currentEditor != nullptr)
     {
         // Call showMessage on the editor - defined in PluginEditor.h
@@ -0,0 +1,298 @@
+#include "PluginState.h"
+
+namespace
+{
+    void writeChunk(juce::MemoryOutputStream& out, uint32_t chunkTag, const juce::MemoryOutputStream& payload)
+    {
+        out.writeInt(static_cast<int>(chunkTag));
+        out.writeInt(static_cast<int>(payload.getDataSize()));
+        out.write(payload.getData(), payload.getDataSize());
+    }
+}
+
+void PluginState::write(juce::MemoryBlock& dest, const std::array<float, Param::numParams>& values, const Patterns& patterns)
+{
+    juce::MemoryOutputStream out(dest, false);
+    out.writeInt(static_cast<int>(kMagic));
+    out.writeInt(static_cast<int>(kVersion));
+    out.writeInt(static_cast<int>(Param::schemaHash()));
+
+    juce::MemoryOutputStream params, keys;
+    for (const auto& spec : Param::kSpecs)
+    {
+        params.writeFloat(values[static_cast<size_t>(spec.index)]);
+        keys.writeInt(static_cast<int>(Param::idHash(spec.id)));
+    }
+    writeChunk(out, tag("PARM"), params);
+    writeChunk(out, tag("PKEY"), keys);
+
+    // Melody bank: each pattern up to its last non-empty step
+    juce::MemoryOutputStream melody;
+    melody.writeByte(static_cast<char>(patterns.currentMelodyPattern));
+    melody.writeByte(static_cast<char>(numMelodyPatterns));
+    melody.writeByte(static_cast<char>(numScaleDegrees));
+    for (const auto& pattern : patterns.melody)
+    {
+        int numSteps = maxSteps;
+        while (numSteps > 0 && pattern.isStepEmpty(numSteps - 1))
+            --numSteps;
+
+        melody.writeShort(static_cast<short>(numSteps));
+        melody.write(pattern.noteMask, static_cast<size_t>(numSteps));
+        for (int step = 0; step < numSteps; ++step)
+            for (int byte = 0; byte < 3; ++byte) // 8 degrees x 3 bits
+                melody.writeByte(static_cast<char>((pattern.octaves[step] >> (byte * 8)) & 0xffu));
+        melody.write(pattern.probability, static_cast<size_t>(numSteps));
+    }
+    writeChunk(out, tag("MELO"), melody);
+
+    // Drum bank: one bit per step, each pattern up to its last trigger
+    juce::MemoryOutputStream drums;
+    drums.writeByte(static_cast<char>(patterns.currentDrumPattern));
+    drums.writeByte(static_cast<char>(numDrumPatterns));
+    drums.writeByte(static_cast<char>(numDrumLanes));
+    for (const auto& pattern : patterns.drums)
+    {
+        int numSteps = maxSteps;
+        while (numSteps > 0 && pattern.lanesAt(numSteps - 1) == 0)
+            --numSteps;
+
+        drums.writeShort(static_cast<short>(numSteps));
+        for (int lane = 0; lane < numDrumLanes; ++lane)
+        {
+            for (int firstStep = 0; firstStep < numSteps; firstStep += 8)
+            {
+                uint8_t bits = 0;
+                for (int step = firstStep; step < juce::jmin(firstStep + 8, numSteps); ++step)
+                    bits = static_cast<uint8_t>(bits | (pattern.isOn(lane, step) ? 1u : 0u) << (step - firstStep));
+                drums.writeByte(static_cast<char>(bits));
+            }
+        }
+    }
+    writeChunk(out, tag("DRUM"), drums);
+
+    // Melody song
+    juce::MemoryOutputStream song;
+    song.writeByte(static_cast<char>(patterns.song.getNumEntries()));
+    for (int entry = 0; entry < patterns.song.getNumEntries(); ++entry)
+    {
+        song.writeByte(static_cast<char>(patterns.song.getPattern(entry)));
+        song.writeByte(static_cast<char>(patterns.song.getRepeats(entry)));
+    }
+    writeChunk(out, tag("SONG"), song);
+
+    // Step count and chain beyond the parameter ranges
+    juce::MemoryOutputStream extents;
+    extents.writeByte(static_cast<char>(patterns.melodyPages));
+    extents.writeByte(static_cast<char>(patterns.drumChainBank));
+    writeChunk(out, tag("SEQX"), extents);
+}
+
+bool PluginState::isBinaryState(const void* data, size_t size)
+{
+    return data != nullptr && size >= 12
+        && static_cast<uint32_t>(juce::ByteOrder::littleEndianInt(data)) == kMagic;
+}
+
+bool PluginState::read(const void* data, size_t size, std::array<float, Param::numParams>& values,
+                       Patterns& patterns, bool& hasPatterns)
+{
+    values.fill(std::numeric_limits<float>::quiet_NaN());
+    hasPatterns = false;
+
+    if (!isBinaryState(data, size))
+        return false;
+
+    juce::MemoryInputStream in(data, size, false);
+    in.readInt(); // Magic
+    const auto version = static_cast<uint32_t>(in.readInt());
+    const bool sameSchema = static_cast<uint32_t>(in.readInt()) == Param::schemaHash();
+    if (version == 0)
+        return false;
+
+    // Find every chunk first: PARM needs PKEY when the schema has changed
+    const auto* bytes = static_cast<const char*>(data);
+    std::unique_ptr<juce::MemoryInputStream> params, keys, melody, drums, song, extents;
+
+    while (in.getNumBytesRemaining() >= 8)
+    {
+        const auto chunkTag = static_cast<uint32_t>(in.readInt());
+        const auto chunkSize = static_cast<juce::int64>(static_cast<uint32_t>(in.readInt()));
+        if (chunkSize > in.getNumBytesRemaining())
+            break; // Truncated; keep what was complete
+
+        auto chunk = std::make_unique<juce::MemoryInputStream>(bytes + in.getPosition(), static_cast<size_t>(chunkSize), false);
+        if (chunkTag == tag("PARM"))
+            params = std::move(chunk);
+        else if (chunkTag == tag("PKEY"))
+            keys = std::move(chunk);
+        else if (chunkTag == tag("MELO"))
+            melody = std::move(chunk);
+        else if (chunkTag == tag("DRUM"))
+            drums = std::move(chunk);
+        else if (chunkTag == tag("SONG"))
+            song = std::move(chunk);
+        else if (chunkTag == tag("SEQX"))
+            extents = std::move(chunk);
+
+        in.skipNextBytes(chunkSize);
+    }
+
+    if (params != nullptr)
+        readParameters(*params, keys.get(), sameSchema, values);
+
+    if (melody != nullptr)
+        readMelody(*melody, patterns);
+
+    if (drums != nullptr)
+        readDrums(*drums, patterns);
+
+    if (song != nullptr)
+        readSong(*song, patterns);
+
+    if (extents != nullptr)
+        readExtents(*extents, patterns);
+
+    hasPatterns = melody != nullptr || drums != nullptr || song != nullptr || extents != nullptr;
+    return true;
+}
+
+void PluginState::readParameters(juce::MemoryInputStream& params, juce::MemoryInputStream* keys, bool sameSchema,
+                                 std::array<float, Param::numParams>& values)
+{
+    const int numStored = static_cast<int>(params.getDataSize() / sizeof(float));
+
+    if (sameSchema)
+    {
+        for (int i = 0; i < juce::jmin(numStored, static_cast<int>(Param::numParams)); ++i)
+            values[static_cast<size_t>(i)] = params.readFloat();
+        return;
+    }
+
+    // Written by a different parameter table: match values to parameters by ID hash,
+    // dropping parameters that no longer exist
+    if (keys == nullptr || static_cast<int>(keys->getDataSize() / sizeof(uint32_t)) != numStored)
+        return;
+
+    for (int i = 0; i < numStored; ++i)
+    {
+        const float value = params.readFloat();
+        const auto key = static_cast<uint32_t>(keys->readInt());
+
+        for (const auto& spec : Param::kSpecs)
+        {
+            if (Param::idHash(spec.id) == key)
+            {
+                values[static_cast<size_t>(spec.index)] = value;
+                break;
+            }
+        }
+    }
+}
+
+void PluginState::readMelody(juce::MemoryInputStream& in, Patterns& patterns)
+{
+    const int current = static_cast<uint8_t>(in.readByte());
+    const int numStoredPatterns = static_cast<uint8_t>(in.readByte());
+    const int numStoredDegrees = static_cast<uint8_t>(in.readByte());
+    if (numStoredDegrees != numScaleDegrees)
+        return;
+
+    for (int index = 0; index < numStoredPatterns && !in.isExhausted(); ++index)
+    {
+        const int numSteps = static_cast<uint16_t>(in.readShort());
+        PatternData::MelodyPattern stored;
+
+        for (int step = 0; step < numSteps; ++step)
+        {
+            const auto mask = static_cast<uint8_t>(in.readByte());
+            if (step < maxSteps)
+                stored.noteMask[step] = mask;
+        }
+
+        for (int step = 0; step < numSteps; ++step)
+        {
+            uint32_t bits = 0;
+            for (int byte = 0; byte < 3; ++byte)
+                bits |= static_cast<uint32_t>(static_cast<uint8_t>(in.readByte())) << (byte * 8);
+
+            if (step >= maxSteps)
+                continue;
+
+            // Through setOctave, so out-of-range values are clamped
+            for (int degree = 0; degree < numScaleDegrees; ++degree)
+            {
+                const auto octaveBits = static_cast<int>((bits >> (degree * 3)) & 0x7u);
+                stored.setOctave(step, degree, octaveBits >= 4 ? octaveBits - 8 : octaveBits);
+            }
+        }
+
+        for (int step = 0; step < numSteps; ++step)
+        {
+            const int probability = static_cast<uint8_t>(in.readByte());
+            if (step < maxSteps)
+                stored.probability[step] = static_cast<uint8_t>(juce::jmin(probability, 100));
+        }
+
+        if (index < numMelodyPatterns)
+            patterns.melody[index] = stored;
+    }
+
+    patterns.currentMelodyPattern = juce::jlimit(0, numMelodyPatterns - 1, current);
+}
+
+void PluginState::readDrums(juce::MemoryInputStream& in, Patterns& patterns)
+{
+    const int current = static_cast<uint8_t>(in.readByte());
+    const int numStoredPatterns = static_cast<uint8_t>(in.readByte());
+    const int numStoredLanes = static_cast<uint8_t>(in.readByte());
+
+    for (int index = 0; index < numStoredPatterns && !in.isExhausted(); ++index)
+    {
+        const int numSteps = static_cast<uint16_t>(in.readShort());
+        PatternData::DrumPattern stored;
+
+        for (int lane = 0; lane < numStoredLanes; ++lane)
+        {
+            for (int firstStep = 0; firstStep < numSteps; firstStep += 8)
+            {
+                const auto bits = static_cast<uint8_t>(in.readByte());
+                for (int step = firstStep; step < juce::jmin(firstStep + 8, numSteps, maxSteps); ++step)
+                    if (lane < numDrumLanes)
+                        stored.set(lane, step, ((bits >> (step - firstStep)) & 1u) != 0);
+            }
+        }
+
+        if (index < numDrumPatterns)
+            patterns.drums[index] = stored;
+    }
+
+    patterns.currentDrumPattern = juce::jlimit(0, numDrumPatterns - 1, current);
+}
+
+void PluginState::readSong(juce::MemoryInputStream& in, Patterns& patterns)
+{
+    const int numStored = static_cast<uint8_t>(in.readByte());
+
+    for (int entry = 0; entry < numStored; ++entry)
+    {
+        const int pattern = static_cast<uint8_t>(in.readByte());
+        const int repeats = static_cast<uint8_t>(in.readByte());
+        if (entry >= PatternData::maxSongEntries)
+            continue;
+
+        patterns.song.entries[entry].pattern = static_cast<uint8_t>(juce::jmin(pattern, numMelodyPatterns - 1));
+        patterns.song.entries[entry].repeats = static_cast<uint8_t>(juce::jlimit(1, PatternData::MelodySong::maxRepeats, repeats));
+    }
+
+    patterns.song.numEntries = juce::jlimit(1, PatternData::maxSongEntries, numStored);
+}
+
+void PluginState::readExtents(juce::MemoryInputStream& in, Patterns& patterns)
+{
+    const int melodyPages = static_cast<uint8_t>(in.readByte());
+    const int drumChainBank = static_cast<uint8_t>(in.readByte());
+
+    patterns.melodyPages = juce::jlimit(1, PatternData::maxMelodyPages, melodyPages);
+    patterns.drumChainBank = juce::jlimit(0, PatternData::numDrumBanks - 1, drumChainBank);
+}
@@ -0,0 +1,108 @@
+#include "PresetBankLoader.h"
+
+PresetBankLoader::PresetBankLoader(const juce::File& dir)
+    : juce::Thread("Preset bank loader"),
+      dataDirectory(dir)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+PresetBankLoader::~PresetBankLoader()
+{
+    signalThreadShouldExit();
+    loadRequested.signal();
+    stopThread(4000);
+    cancelPendingUpdate();
+}
+
+uint32_t PresetBankLoader::load()
+{
+    const auto generation = ++requestedGeneration;
+    loadRequested.signal();
+    return generation;
+}
+
+void PresetBankLoader::run()
+{
+    while (!threadShouldExit())
+    {
+        loadRequested.wait();
+        if (threadShouldExit())
+            break;
+
+        // Requests made from here on are served by the next pass
+        const auto generation = requestedGeneration.load();
+        auto banks = std::make_unique<Banks>(readBanks());
+        banks->generation = generation;
+
+        {
+            const juce::ScopedLock sl(resultLock);
+            result = std::move(banks);
+        }
+
+        triggerAsyncUpdate();
+    }
+}
+
+void PresetBankLoader::handleAsyncUpdate()
+{
+    std::unique_ptr<Banks> banks;
+    {
+        const juce::ScopedLock sl(resultLock);
+        banks = std::move(result);
+    }
+
+    if (banks != nullptr && onLoaded)
+        onLoaded(*banks);
+}
+
+std::shared_ptr<const CompiledPresetBank> PresetBankLoader::openSynthBank(const juce::File& dataDirectory, SharedResourceCache& cache)
+{
+    return CompiledPresetBank::openOrCompile(dataDirectory.getChildFile("synth_presets.bin"),
+                                             dataDirectory.getChildFile("synth_presets_system.json"),
+                                             dataDirectory.getChildFile("synth_presets_user.json"),
+                                             cache);
+}
+
+PresetBankLoader::Banks PresetBankLoader::readBanks()
+{
+    Banks banks;
+
+    banks.synthPresets = openSynthBank(dataDirectory, *sharedResources);
+    banks.numSystemSynthPresets = banks.synthPresets->getNumSystemPresets();
+
+    banks.sequencerPresets = readCombined(dataDirectory.getChildFile("sequencer_presets_system.json"),
+                                          dataDirectory.getChildFile("sequencer_presets_user.json"),
+                                          banks.numSystemSequencerPresets);
+
+    auto config = sharedResources->getJSON(dataDirectory.getChildFile("randomization_config.json"));
+    if (config.isObject())
+        banks.randomizationConfig = config;
+
+    return banks;
+}
+
+juce::var PresetBankLoader::readCombined(const juce::File& systemFile, const juce::File& userFile, int& numSystemPresets)
+{
+    // System presets (read-only) first, then user presets (writable)
+    juce::Array<juce::var> combined;
+    numSystemPresets = 0;
+
+    for (const auto& file : { systemFile, userFile })
+    {
+        auto json = sharedResources->getJSON(file);
+        if (auto* obj = json.getDynamicObject())
+        {
+            if (const juce::Array<juce::var>* arr = obj->getProperty("presets").getArray())
+            {
+                combined.addArray(*arr);
+                if (file == systemFile)
+                    numSystemPresets = arr->size();
+            }
+        }
+    }
+
+    juce::var root(new juce::DynamicObject());
+    root.getDynamicObject()->setProperty("presets", combined);
+    return root;
+}
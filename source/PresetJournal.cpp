@@ -0,0 +1,218 @@
+#include "PresetJournal.h"
+
+PresetJournal::PresetJournal()
+    : juce::Thread("Preset journal")
+{
+}
+
+void PresetJournal::open(const juce::File& dir)
+{
+    if (isThreadRunning())
+        return;
+
+    dataDirectory = dir;
+    journalFile = dir.getChildFile("user_presets.journal");
+
+    // Saves from a session that ended before compacting are folded in on start
+    journalDirty = journalFile.existsAsFile();
+    startThread(juce::Thread::Priority::low);
+}
+
+PresetJournal::~PresetJournal()
+{
+    // run() writes and compacts whatever is still queued before it returns
+    signalThreadShouldExit();
+    recordsQueued.signal();
+    stopThread(4000);
+    cancelPendingUpdate();
+}
+
+int PresetJournal::append(Bank bank, const juce::var& preset)
+{
+    juce::var record(new juce::DynamicObject());
+    record.getDynamicObject()->setProperty("bank", bank == Bank::synth ? "synth" : "sequencer");
+    record.getDynamicObject()->setProperty("preset", preset);
+
+    // Serialized here so the writer thread never touches the caller's var
+    const int sequence = nextSequence++;
+    {
+        const juce::ScopedLock sl(queueLock);
+        queue.add({ sequence, juce::JSON::toString(record, true) });
+    }
+
+    recordsQueued.signal();
+    return sequence;
+}
+
+void PresetJournal::run()
+{
+    bool writePending = false; // Records are still queued because the file lock wasn't available
+
+    while (!threadShouldExit())
+    {
+        // Wake for new saves; compact once they've been quiet for a while
+        const bool woken = recordsQueued.wait(journalDirty || writePending ? kCompactDelayMs : -1);
+        if (threadShouldExit())
+            break;
+
+        writePending = !writeQueued();
+
+        if (!woken && journalDirty && compact())
+            triggerAsyncUpdate();
+    }
+
+    writeQueued();
+    if (journalDirty)
+        compact();
+}
+
+void PresetJournal::handleAsyncUpdate()
+{
+    const int lastSequence = lastCompactedSequence.load();
+    listeners.call([lastSequence](Listener& l) { l.presetsCompacted(lastSequence); });
+}
+
+bool PresetJournal::writeQueued()
+{
+    juce::Array<Record> records;
+    {
+        const juce::ScopedLock sl(queueLock);
+        records.swapWith(queue);
+    }
+
+    if (records.isEmpty())
+        return true;
+
+    dataDirectory.createDirectory();
+
+    // Another process may be compacting the same journal; without the lock,
+    // put the records back in front of any newer ones and try again later
+    const juce::InterProcessLock::ScopedLockType processLock(fileLock);
+    juce::FileOutputStream out(journalFile); // Appends to an existing file
+
+    if (!processLock.isLocked() || out.failedToOpen())
+    {
+        const juce::ScopedLock sl(queueLock);
+        records.addArray(queue);
+        queue.swapWith(records);
+        return false;
+    }
+
+    for (const auto& record : records)
+    {
+        out.writeText(record.line + "\n", false, false, nullptr);
+        lastWrittenSequence = record.sequence;
+    }
+
+    out.flush();
+    journalDirty = true;
+    return true;
+}
+
+bool PresetJournal::compact()
+{
+    // Nothing may append between reading the journal and deleting it
+    const juce::InterProcessLock::ScopedLockType processLock(fileLock);
+    if (!processLock.isLocked())
+        return false;
+
+    juce::Array<juce::var> synthPresets, sequencerPresets;
+    juce::StringArray sequencerLines;
+
+    // Missing if another process already compacted it (lines it held are in the banks)
+    juce::StringArray lines;
+    lines.addLines(journalFile.loadFileAsString());
+
+    for (const auto& line : lines)
+    {
+        // A line cut short by a crash doesn't parse and is dropped
+        auto record = juce::JSON::parse(line);
+        auto* obj = record.getDynamicObject();
+        if (obj == nullptr || !obj->getProperty("preset").isObject())
+            continue;
+
+        if (obj->getProperty("bank").toString() == "synth")
+            synthPresets.add(obj->getProperty("preset"));
+        else if (obj->getProperty("bank").toString() == "sequencer")
+        {
+            sequencerPresets.add(obj->getProperty("preset"));
+            sequencerLines.add(line);
+        }
+    }
+
+    // Check both banks can be read before replacing either, and keep the
+    // journal until both are written
+    juce::String synthJSON, sequencerJSON;
+    const auto synthFile = dataDirectory.getChildFile("synth_presets_user.json");
+    const auto sequencerFile = dataDirectory.getChildFile("sequencer_presets_user.json");
+
+    if (!mergeBank(synthFile, synthPresets, synthJSON) || !mergeBank(sequencerFile, sequencerPresets, sequencerJSON))
+        return false;
+
+    // Write both banks out in full before renaming either over its old file
+    juce::TemporaryFile synthTemp(synthFile), sequencerTemp(sequencerFile);
+    if (!writeTemporary(synthTemp, synthJSON) || !writeTemporary(sequencerTemp, sequencerJSON))
+        return false;
+
+    if (!commitTemporary(synthTemp, synthJSON))
+        return false;
+
+    if (!commitTemporary(sequencerTemp, sequencerJSON))
+    {
+        // The synth presets are in their bank now: keep only the sequencer
+        // records, so the next compaction doesn't add the synth ones again
+        replaceAtomically(journalFile, sequencerLines.joinIntoString("\n") + "\n");
+        return false;
+    }
+
+    journalFile.deleteFile();
+    journalDirty = false;
+    lastCompactedSequence = lastWrittenSequence;
+    return true;
+}
+
+bool PresetJournal::mergeBank(const juce::File& userFile, const juce::Array<juce::var>& journaled, juce::String& mergedJSON)
+{
+    if (journaled.isEmpty())
+        return true; // Nothing to add; mergedJSON stays empty and the file is left alone
+
+    juce::Array<juce::var> presets;
+    if (userFile.existsAsFile())
+    {
+        // Never replace a bank we couldn't read; the journal keeps the new presets
+        auto existing = juce::JSON::parse(userFile.loadFileAsString());
+        auto* obj = existing.getDynamicObject();
+        const juce::Array<juce::var>* arr = obj != nullptr ? obj->getProperty("presets").getArray() : nullptr;
+        if (arr == nullptr)
+            return false;
+
+        presets = *arr;
+    }
+
+    presets.addArray(journaled);
+
+    juce::var root(new juce::DynamicObject());
+    root.getDynamicObject()->setProperty("presets", presets);
+    mergedJSON = juce::JSON::toString(root, true);
+    return true;
+}
+
+bool PresetJournal::writeTemporary(juce::TemporaryFile& temp, const juce::String& text)
+{
+    return text.isEmpty() || temp.getFile().replaceWithText(text);
+}
+
+bool PresetJournal::commitTemporary(juce::TemporaryFile& temp, const juce::String& text)
+{
+    return text.isEmpty() || temp.overwriteTargetFileWithTemporary();
+}
+
+bool PresetJournal::replaceAtomically(const juce::File& file, const juce::String& text)
+{
+    if (text.isEmpty())
+        return true;
+
+    // Write next to the target and rename over it, so a crash never leaves a half-written file
+    juce::TemporaryFile temp(file);
+    return temp.getFile().replaceWithText(text) && temp.overwriteTargetFileWithTemporary();
+}
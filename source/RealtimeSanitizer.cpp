@@ -0,0 +1,121 @@
+#include "RealtimeSanitizer.h"
+
+#if SNORKEL_RT_SANITIZER
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__has_feature)
+ #if __has_feature(realtime_sanitizer)
+  #define SNORKEL_HAS_RTSAN 1
+ #endif
+#endif
+
+#if SNORKEL_HAS_RTSAN
+// Provided by the -fsanitize=realtime runtime
+extern "C" void __rtsan_realtime_enter();
+extern "C" void __rtsan_realtime_exit();
+extern "C" void __rtsan_notify_blocking_call(const char* functionName);
+#endif
+
+namespace
+{
+    thread_local int scopeDepth = 0;
+    thread_local bool reporting = false; // Reporting allocates; don't report that
+    std::atomic<int> violationCount { 0 };
+
+    void reportViolation(const char* what, const char* detail)
+    {
+        if (scopeDepth == 0 || reporting)
+            return;
+
+        reporting = true;
+        ++violationCount;
+        std::fprintf(stderr, "Real-time violation: %s%s%s\n%s\n", what, detail != nullptr ? " " : "",
+                     detail != nullptr ? detail : "", juce::SystemStats::getStackBacktrace().toRawUTF8());
+        reporting = false;
+    }
+
+    void* checkedAlloc(std::size_t size)
+    {
+        reportViolation("heap allocation", nullptr);
+        return std::malloc(size);
+    }
+
+    void checkedFree(void* ptr)
+    {
+        if (ptr != nullptr)
+            reportViolation("heap free", nullptr);
+        std::free(ptr);
+    }
+}
+
+namespace RealtimeSanitizer
+{
+    Scope::Scope()
+    {
+        ++scopeDepth;
+       #if SNORKEL_HAS_RTSAN
+        __rtsan_realtime_enter();
+       #endif
+    }
+
+    Scope::~Scope()
+    {
+       #if SNORKEL_HAS_RTSAN
+        __rtsan_realtime_exit();
+       #endif
+        --scopeDepth;
+    }
+
+    bool isInRealtimeScope() { return scopeDepth > 0; }
+
+    void notifyBlockingCall(const char* functionName)
+    {
+       #if SNORKEL_HAS_RTSAN
+        __rtsan_notify_blocking_call(functionName); // RTSan reports it with its own stack trace
+       #else
+        reportViolation("blocking call to", functionName);
+       #endif
+    }
+
+    int getViolationCount() { return violationCount.load(); }
+}
+
+//==============================================================================
+// Allocation hooks for builds without RTSan (which intercepts malloc itself).
+// These catch operator new and delete: std containers, juce::String, owned
+// objects. juce::HeapBlock (and so Array and MidiBuffer growth) calls malloc
+// directly and is only caught with RTSan; replacing malloc from a plugin
+// isn't safe, as thread-local storage in a shared library can itself malloc.
+#if ! SNORKEL_HAS_RTSAN
+
+void* operator new(std::size_t size)
+{
+    if (void* ptr = checkedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* ptr = checkedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return checkedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return checkedAlloc(size); }
+
+void operator delete(void* ptr) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr) noexcept { checkedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { checkedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { checkedFree(ptr); }
+
+#endif
+
+#endif
@@ -0,0 +1,97 @@
+#include "SequencerEventList.h"
+
+bool SequencerEventList::Inputs::operator==(const Inputs& other) const
+{
+    return pattern == other.pattern
+        && patternVersion == other.patternVersion
+        && rootNote == other.rootNote
+        && scaleType == other.scaleType
+        && activeSteps == other.activeSteps
+        && progressionOffset == other.progressionOffset
+        && gate == other.gate
+        && accents == other.accents;
+}
+
+bool SequencerEventList::update(const Inputs& inputs)
+{
+    if (compiled && inputs == compiledInputs)
+        return false;
+
+    compiledInputs = inputs;
+    compiled = true;
+    compile();
+    return true;
+}
+
+void SequencerEventList::compile()
+{
+    numEvents = 0;
+
+    const auto& in = compiledInputs;
+    const int activeSteps = juce::jlimit(0, numSteps, in.activeSteps);
+    const auto length = static_cast<uint16_t>(juce::roundToInt(in.gate * static_cast<float>(ticksPerStep)));
+
+    const int compiledSteps = in.pattern != nullptr ? activeSteps : 0;
+
+    for (int step = 0; step < compiledSteps; ++step)
+    {
+        stepStart[static_cast<size_t>(step)] = numEvents;
+
+        const uint8_t mask = in.pattern->noteMask[step];
+        if (mask == 0)
+            continue;
+
+        // Each set bit is a scale degree; the progression shifts them all
+        for (int degree = 0; degree < numScaleDegrees; ++degree)
+        {
+            if ((mask & (1 << degree)) == 0)
+                continue;
+
+            const int adjustedDegree = (degree + in.progressionOffset) % numScaleDegrees;
+            const int note = scaleDegreeToNote(adjustedDegree, in.rootNote, in.scaleType)
+                           + in.pattern->getOctave(step, degree) * 12; // Per-note octave shift
+
+            auto& event = events[static_cast<size_t>(numEvents++)];
+            event.tick = static_cast<uint32_t>(step * ticksPerStep);
+            event.length = length;
+            event.note = static_cast<uint8_t>(juce::jlimit(0, 127, note));
+            event.velocity = 100;
+            event.probability = in.pattern->probability[step];
+            event.accent = in.accents[static_cast<size_t>(step % numAccents)];
+        }
+    }
+
+    // Inactive steps are empty
+    std::fill(stepStart.begin() + compiledSteps, stepStart.end(), numEvents);
+}
+
+int SequencerEventList::scaleDegreeToNote(int scaleDegree, int rootNote, int scaleType)
+{
+    // Base octave (C3 = MIDI 60)
+    const int baseOctave = 60;
+
+    // Scale intervals (semitones from root)
+    // scaleDegree: 0-7 where 0=1st, 1=2nd, ..., 6=7th, 7=octave
+    static const int scaleIntervals[][8] = {
+        {0, 2, 4, 5, 7, 9, 11, 12},  // Major
+        {0, 2, 3, 5, 7, 8, 10, 12},  // Minor (Natural)
+        {0, 2, 3, 5, 7, 9, 10, 12},  // Dorian
+        {0, 1, 3, 5, 7, 8, 10, 12},  // Phrygian
+        {0, 2, 4, 6, 7, 9, 11, 12},  // Lydian
+        {0, 2, 4, 5, 7, 9, 10, 12},  // Mixolydian
+        {0, 2, 3, 5, 7, 8, 10, 12},  // Aeolian (same as Natural Minor)
+        {0, 1, 3, 5, 6, 8, 10, 12},  // Locrian
+        {0, 2, 3, 5, 7, 8, 11, 12},  // Harmonic Minor
+        {0, 2, 3, 5, 7, 9, 11, 12},  // Melodic Minor
+        {0, 2, 4, 7, 9, 12, 12, 12}, // Pentatonic Major
+        {0, 3, 5, 7, 10, 12, 12, 12},// Pentatonic Minor
+        {0, 3, 5, 6, 7, 10, 12, 12}  // Blues
+    };
+
+    scaleType = juce::jlimit(0, 12, scaleType);
+    scaleDegree = juce::jlimit(0, 7, scaleDegree);
+
+    int midiNote = baseOctave + rootNote + scaleIntervals[scaleType][scaleDegree];
+
+    return juce::jlimit(0, 127, midiNote);
+}
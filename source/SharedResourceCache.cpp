@@ -0,0 +1,115 @@
+#include "SharedResourceCache.h"
+
+SharedResourceCache::SharedResourceCache()
+{
+    formatManager.registerBasicFormats();
+}
+
+juce::var SharedResourceCache::getJSON(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return {};
+
+    const auto stamp = FileStamp::of(file);
+    const juce::ScopedLock sl(jsonLock);
+
+    auto& entry = jsonEntries[file.getFullPathName()];
+    if (!(entry.stamp == stamp))
+    {
+        auto result = juce::JSON::parse(file.loadFileAsString());
+        entry.value = result.isObject() ? result : juce::var();
+        entry.stamp = stamp;
+    }
+
+    return entry.value;
+}
+
+std::shared_ptr<const SharedResourceCache::AudioSample> SharedResourceCache::getAudio(const juce::File& file, double targetSampleRate)
+{
+    if (!file.existsAsFile())
+        return nullptr;
+
+    const auto stamp = FileStamp::of(file);
+    const juce::ScopedLock sl(audioLock);
+
+    // The decoded file at its own rate is the source for every resampled version
+    auto& decodedEntry = audioEntries[file.getFullPathName()];
+    auto decoded = decodedEntry.stamp == stamp ? decodedEntry.sample.lock() : nullptr;
+    if (decoded == nullptr)
+    {
+        decoded = decode(file);
+        if (decoded == nullptr)
+            return nullptr;
+
+        decodedEntry = { stamp, decoded };
+    }
+
+    if (targetSampleRate <= 0.0 || std::abs(decoded->sampleRate - targetSampleRate) < 1.0e-6)
+        return decoded;
+
+    auto& resampledEntry = audioEntries[file.getFullPathName() + "@" + juce::String(targetSampleRate)];
+    auto resampled = resampledEntry.stamp == stamp ? resampledEntry.sample.lock() : nullptr;
+    if (resampled == nullptr)
+    {
+        resampled = resample(*decoded, targetSampleRate);
+        resampledEntry = { stamp, resampled };
+    }
+
+    return resampled;
+}
+
+std::shared_ptr<const SharedResourceCache::AudioSample> SharedResourceCache::decode(const juce::File& file)
+{
+    auto* format = formatManager.findFormatForFileExtension(file.getFileExtension());
+    if (format == nullptr)
+        return nullptr;
+
+    auto sample = std::make_shared<AudioSample>();
+
+    // Large files are mapped so decoding doesn't go through buffered stream reads
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    if (file.getSize() > kMemoryMapThreshold)
+    {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+        if (mapped != nullptr && mapped->mapEntireFile())
+            reader = std::move(mapped);
+    }
+
+    if (reader == nullptr)
+        reader.reset(formatManager.createReaderFor(file));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return nullptr;
+
+    const int length = static_cast<int>(reader->lengthInSamples);
+    sample->buffer.setSize(static_cast<int>(reader->numChannels), length);
+    reader->read(&sample->buffer, 0, length, 0, true, true);
+    sample->sampleRate = reader->sampleRate;
+
+    return sample;
+}
+
+std::shared_ptr<const SharedResourceCache::AudioSample> SharedResourceCache::resample(const AudioSample& source, double targetSampleRate)
+{
+    auto sample = std::make_shared<AudioSample>();
+    sample->sampleRate = targetSampleRate;
+
+    const int sourceLength = source.buffer.getNumSamples();
+    const double speedRatio = source.sampleRate / targetSampleRate;
+    const int targetLength = juce::jmax(1, static_cast<int>(std::ceil(sourceLength / speedRatio)));
+    sample->buffer.setSize(source.buffer.getNumChannels(), targetLength);
+    sample->buffer.clear();
+
+    // Lagrange interpolation reads ahead, so give it a zero-padded copy of each channel
+    juce::HeapBlock<float> padded(static_cast<size_t>(sourceLength + 8), true);
+
+    for (int channel = 0; channel < source.buffer.getNumChannels(); ++channel)
+    {
+        juce::FloatVectorOperations::copy(padded.get(), source.buffer.getReadPointer(channel), sourceLength);
+
+        juce::LagrangeInterpolator interpolator;
+        interpolator.process(speedRatio, padded.get(), sample->buffer.getWritePointer(channel), targetLength);
+    }
+
+    return sample;
+}
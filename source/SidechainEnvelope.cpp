@@ -0,0 +1,109 @@
+#include "SidechainEnvelope.h"
+
+void SidechainEnvelope::setShape(float attackSamples, float holdSamples, float releaseSamples, float depth)
+{
+    attackLength = juce::jmax(0.0f, attackSamples);
+    holdLength = juce::jmax(0.0f, holdSamples);
+    releaseLength = juce::jmax(0.0f, releaseSamples);
+    targetDepth = juce::jlimit(0.0f, 1.0f, depth);
+}
+
+void SidechainEnvelope::trigger()
+{
+    stageDepth = targetDepth;
+
+    if (stageDepth <= 0.0f || releaseLength < 1.0f)
+    {
+        reset();
+        return;
+    }
+
+    enterStage(Stage::attack);
+}
+
+void SidechainEnvelope::reset()
+{
+    stage = Stage::idle;
+    level = 0.0f;
+    increment = 0.0f;
+    samplesLeft = 0;
+}
+
+void SidechainEnvelope::enterStage(Stage newStage)
+{
+    stage = newStage;
+
+    switch (stage)
+    {
+        case Stage::attack:
+            samplesLeft = juce::roundToInt(attackLength);
+            if (samplesLeft > 0)
+            {
+                increment = (stageDepth - level) / static_cast<float>(samplesLeft);
+                break;
+            }
+            level = stageDepth;
+            enterStage(Stage::hold);
+            break;
+
+        case Stage::hold:
+            samplesLeft = juce::roundToInt(holdLength);
+            increment = 0.0f;
+            if (samplesLeft <= 0)
+                enterStage(Stage::release);
+            break;
+
+        case Stage::release:
+            samplesLeft = juce::jmax(1, juce::roundToInt(releaseLength));
+            increment = -level / static_cast<float>(samplesLeft);
+            break;
+
+        case Stage::idle:
+            level = 0.0f;
+            increment = 0.0f;
+            samplesLeft = 0;
+            break;
+    }
+}
+
+void SidechainEnvelope::render(float* gain, int numSamples)
+{
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        if (stage == Stage::idle)
+        {
+            juce::FloatVectorOperations::fill(gain + done, 1.0f, numSamples - done);
+            return;
+        }
+
+        // Each stage is a straight line, so fill it in one run
+        const int run = juce::jmin(numSamples - done, samplesLeft);
+        for (int i = 0; i < run; ++i)
+        {
+            level += increment;
+            gain[done + i] = 1.0f - level;
+        }
+
+        done += run;
+        samplesLeft -= run;
+
+        if (samplesLeft <= 0)
+        {
+            if (stage == Stage::attack)
+            {
+                level = stageDepth;
+                enterStage(Stage::hold);
+            }
+            else if (stage == Stage::hold)
+            {
+                enterStage(Stage::release);
+            }
+            else
+            {
+                enterStage(Stage::idle);
+            }
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#include "PluginProcessor.h"
+#include "SongTab.h"
+
+namespace
+{
+    // Layout shared by paint() and resized()
+    constexpr int startX = 80;
+    constexpr int horizontalSpacing = 90;
+    constexpr int row1Y = 120;
+    constexpr int rowSpacing = 105;
+    constexpr int boxWidth = 60;
+    constexpr int boxHeight = 30;
+    constexpr int labelHeight = 20;
+    constexpr int entriesPerRow = 8;
+}
+
+//==============================================================================
+SongTab::SongTab(SnorkelSynthAudioProcessor& p)
+    : audioProcessor(p)
+{
+    // Configure enable toggle
+    enableToggle.setButtonText("Enabled");
+    addAndMakeVisible(enableToggle);
+    enableLabel.setText("Song", juce::dontSendNotification);
+    enableLabel.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(enableLabel);
+
+    // Attach enable toggle to parameter
+    enableAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getValueTreeState(), "seqsongenabled", enableToggle);
+
+    // Configure entry count (stored with the patterns, not a parameter)
+    entriesSlider.setSliderStyle(juce::Slider::IncDecButtons);
+    entriesSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 40, 20);
+    entriesSlider.setRange(1, NUM_ENTRIES, 1);
+    entriesSlider.setIncDecButtonsMode(juce::Slider::incDecButtonsDraggable_Vertical);
+    entriesSlider.onValueChange = [this]()
+    {
+        const int numEntries = static_cast<int>(entriesSlider.getValue());
+        audioProcessor.patternStore.edit([=](PatternData& patterns) { patterns.song.numEntries = numEntries; });
+        resized();
+    };
+    addAndMakeVisible(entriesSlider);
+    entriesLabel.setText("Entries", juce::dontSendNotification);
+    entriesLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(entriesLabel);
+
+    auto styleBox = [](juce::Slider& slider, int maximum)
+    {
+        slider.setSliderStyle(juce::Slider::IncDecButtons);
+        slider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 40, boxHeight);
+        slider.setRange(1, maximum, 1);
+        slider.setIncDecButtonsMode(juce::Slider::incDecButtonsDraggable_Vertical);
+
+        // Style the box to look similar to sequencer boxes
+        slider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+        slider.setColour(juce::Slider::textBoxBackgroundColourId, juce::Colour(0xff404040));
+        slider.setColour(juce::Slider::textBoxOutlineColourId, juce::Colour(0xff606060));
+    };
+
+    for (int i = 0; i < NUM_ENTRIES; ++i)
+    {
+        // Pattern played by this entry
+        styleBox(patternSliders[i], PatternData::numMelodyPatterns);
+        patternSliders[i].setTooltip("Pattern");
+        patternSliders[i].onValueChange = [this, i]()
+        {
+            const auto pattern = static_cast<uint8_t>(patternSliders[i].getValue() - 1);
+            audioProcessor.patternStore.edit([=](PatternData& patterns) { patterns.song.entries[i].pattern = pattern; });
+        };
+        addAndMakeVisible(patternSliders[i]);
+
+        // Loops of the pattern before the next entry
+        styleBox(repeatSliders[i], PatternData::MelodySong::maxRepeats);
+        repeatSliders[i].setTextValueSuffix("x");
+        repeatSliders[i].setTooltip("Repeats");
+        repeatSliders[i].onValueChange = [this, i]()
+        {
+            const auto repeats = static_cast<uint8_t>(repeatSliders[i].getValue());
+            audioProcessor.patternStore.edit([=](PatternData& patterns) { patterns.song.entries[i].repeats = repeats; });
+        };
+        addAndMakeVisible(repeatSliders[i]);
+
+        // Configure label
+        entryLabels[i].setText("Entry " + juce::String(i + 1), juce::dontSendNotification);
+        entryLabels[i].setJustificationType(juce::Justification::centred);
+        entryLabels[i].setColour(juce::Label::textColourId, juce::Colours::lightgrey);
+        addAndMakeVisible(entryLabels[i]);
+    }
+
+    refreshFromSong();
+
+    // Start timer to update current entry visualization
+    startTimer(50); // Update at 20Hz
+}
+
+SongTab::~SongTab()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void SongTab::paint(juce::Graphics& g)
+{
+    // Background
+    g.fillAll(juce::Colour(0xff2a2a2a));
+
+    // Draw panel for the song entries (four rows)
+    g.setColour(juce::Colour(0xff3a3a3a));
+    g.fillRoundedRectangle(30, 70, getWidth() - 60, 450, 10);
+
+    // Highlight the entry playing, only while the song drives the sequencer
+    const bool songEnabled = audioProcessor.getValueTreeState().getRawParameterValue("seqsongenabled")->load() > 0.5f;
+    if (songEnabled && currentEntry >= 0 && currentEntry < static_cast<int>(entriesSlider.getValue()))
+    {
+        const int x = startX + (currentEntry % entriesPerRow) * horizontalSpacing;
+        const int y = row1Y + (currentEntry / entriesPerRow) * rowSpacing;
+
+        g.setColour(juce::Colours::orange.withAlpha(0.3f));
+        g.fillRect(x - 5, y - labelHeight - 10, boxWidth + 10, 2 * boxHeight + labelHeight + 20);
+    }
+}
+
+void SongTab::resized()
+{
+    // Enable toggle at the top
+    enableLabel.setBounds(20, 20, 120, 25);
+    enableToggle.setBounds(140, 20, 80, 30);
+
+    // Entry count
+    entriesLabel.setBounds(240, 20, 60, 25);
+    entriesSlider.setBounds(310, 20, 60, 30);
+
+    // Get current number of entries
+    const int numEntries = static_cast<int>(entriesSlider.getValue());
+
+    // Entries 1-8 in the first row, 9-16 in the second, and so on
+    for (int i = 0; i < NUM_ENTRIES; ++i)
+    {
+        bool isVisible = (i < numEntries);
+        entryLabels[i].setVisible(isVisible);
+        patternSliders[i].setVisible(isVisible);
+        repeatSliders[i].setVisible(isVisible);
+
+        if (isVisible)
+        {
+            const int x = startX + (i % entriesPerRow) * horizontalSpacing;
+            const int y = row1Y + (i / entriesPerRow) * rowSpacing;
+
+            entryLabels[i].setBounds(x, y - labelHeight - 5, boxWidth, labelHeight);
+            patternSliders[i].setBounds(x, y, boxWidth, boxHeight);
+            repeatSliders[i].setBounds(x, y + boxHeight + 5, boxWidth, boxHeight);
+        }
+    }
+}
+
+void SongTab::timerCallback()
+{
+    // Pick up songs changed elsewhere (a preset or state load)
+    if (audioProcessor.patternStore.getCurrent().version != shownVersion)
+        refreshFromSong();
+
+    // Update current entry from processor
+    int newEntry = audioProcessor.currentSongEntry;
+    if (newEntry != currentEntry)
+    {
+        currentEntry = newEntry;
+        repaint();
+    }
+}
+
+void SongTab::refreshFromSong()
+{
+    const auto& patterns = audioProcessor.patternStore.getCurrent();
+    shownVersion = patterns.version;
+
+    entriesSlider.setValue(patterns.song.getNumEntries(), juce::dontSendNotification);
+    for (int i = 0; i < NUM_ENTRIES; ++i)
+    {
+        patternSliders[i].setValue(patterns.song.getPattern(i) + 1, juce::dontSendNotification);
+        repeatSliders[i].setValue(patterns.song.getRepeats(i), juce::dontSendNotification);
+    }
+
+    resized();
+    repaint();
+}
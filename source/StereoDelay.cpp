@@ -0,0 +1,141 @@
+#include "StereoDelay.h"
+
+void StereoDelay::prepare(double newSampleRate, int maximumBlockSize, double maximumDelaySeconds)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+
+    // Power-of-two ring so wrapping is a mask instead of a modulo
+    const int minimumLength = static_cast<int>(std::ceil(maximumDelaySeconds * sampleRate)) + 2;
+    const int ringLength = juce::nextPowerOfTwo(juce::jmax(2, minimumLength));
+    ring.setSize(kMaxChannels, ringLength);
+    ringMask = ringLength - 1;
+
+    wetScratch.setSize(kMaxChannels, juce::jmax(1, maximumBlockSize));
+
+    delaySamples.reset(sampleRate, kGlideSeconds);
+    reset();
+}
+
+void StereoDelay::reset()
+{
+    ring.clear();
+    wetScratch.clear();
+    writePosition = 0;
+    hasDelayTime = false;
+}
+
+void StereoDelay::setDelaySamples(float newDelaySamples)
+{
+    const float clamped = juce::jlimit(1.0f, static_cast<float>(ringMask - 1), newDelaySamples);
+
+    // The first time after a reset there's nothing to glide from
+    if (!hasDelayTime)
+    {
+        delaySamples.setCurrentAndTargetValue(clamped);
+        hasDelayTime = true;
+    }
+    else if (clamped != delaySamples.getTargetValue())
+    {
+        delaySamples.setTargetValue(clamped);
+    }
+}
+
+void StereoDelay::process(float* const* channels, int numChannels, int numSamples, const float* mixCurve)
+{
+    numChannels = juce::jmin(numChannels, kMaxChannels);
+    if (numChannels <= 0 || numSamples <= 0 || ringMask == 0 || !hasDelayTime)
+        return;
+
+    // Hosts may exceed the prepared block size; work through it in scratch-sized pieces
+    const int maxSpan = wetScratch.getNumSamples();
+    for (int start = 0; start < numSamples; start += maxSpan)
+    {
+        const int span = juce::jmin(maxSpan, numSamples - start);
+
+        if (delaySamples.isSmoothing())
+            processGliding(channels, numChannels, start, span, mixCurve);
+        else
+            processSteady(channels, numChannels, start, span, mixCurve);
+    }
+}
+
+void StereoDelay::processSteady(float* const* channels, int numChannels, int startSample, int numSamples,
+                                const float* mixCurve)
+{
+    using FVO = juce::FloatVectorOperations;
+
+    const int ringLength = ringMask + 1;
+    const int delay = juce::jlimit(1, ringMask - 1, juce::roundToInt(delaySamples.getTargetValue()));
+
+    for (int done = 0; done < numSamples;)
+    {
+        // A span no longer than the delay only reads samples written before it
+        const int span = juce::jmin(numSamples - done, delay);
+        const int readPosition = (writePosition - delay) & ringMask;
+        const int readFirst = juce::jmin(span, ringLength - readPosition);
+        const int writeFirst = juce::jmin(span, ringLength - writePosition);
+        const float* mix = mixCurve + startSample + done;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* io = channels[ch] + startSample + done;
+            float* wet = wetScratch.getWritePointer(ch);
+            float* line = ring.getWritePointer(ch);
+
+            // Read the delayed span (at most two pieces around the wrap)
+            FVO::copy(wet, line + readPosition, readFirst);
+            if (readFirst < span)
+                FVO::copy(wet + readFirst, line, span - readFirst);
+
+            // Feed the line with input + delayed * feedback
+            FVO::copy(line + writePosition, io, writeFirst);
+            FVO::addWithMultiply(line + writePosition, wet, feedback, writeFirst);
+            if (writeFirst < span)
+            {
+                FVO::copy(line, io + writeFirst, span - writeFirst);
+                FVO::addWithMultiply(line, wet + writeFirst, feedback, span - writeFirst);
+            }
+
+            // Output = dry + (wet - dry) * mix
+            FVO::subtract(wet, io, span);
+            FVO::multiply(wet, mix, span);
+            FVO::add(io, wet, span);
+        }
+
+        writePosition = (writePosition + span) & ringMask;
+        done += span;
+    }
+}
+
+void StereoDelay::processGliding(float* const* channels, int numChannels, int startSample, int numSamples,
+                                 const float* mixCurve)
+{
+    const float maxDelay = static_cast<float>(ringMask - 1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float delay = juce::jlimit(1.0f, maxDelay, delaySamples.getNextValue());
+
+        // Linear interpolation between the two samples around the fractional read position
+        const float readPosition = static_cast<float>(writePosition) - delay;
+        const int readIndex = static_cast<int>(std::floor(readPosition));
+        const float frac = readPosition - static_cast<float>(readIndex);
+        const int indexA = readIndex & ringMask;
+        const int indexB = (readIndex + 1) & ringMask;
+        const float mix = mixCurve[startSample + i];
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* line = ring.getWritePointer(ch);
+            float& sample = channels[ch][startSample + i];
+
+            const float delayed = line[indexA] + (line[indexB] - line[indexA]) * frac;
+            const float input = sample;
+
+            line[writePosition] = input + delayed * feedback;
+            sample = input + (delayed - input) * mix;
+        }
+
+        writePosition = (writePosition + 1) & ringMask;
+    }
+}
@@ -0,0 +1,68 @@
+#include "TransportClock.h"
+
+int TransportClock::samplesUntil(double beat) const
+{
+    const double samples = (beat - currentBeat) * getSamplesPerBeat();
+    if (samples <= 0.0)
+        return 0;
+
+    // Round up so the sub-block ending here leaves the clock on or just past the event
+    return static_cast<int>(std::ceil(samples - 1.0e-6));
+}
+
+void TransportClock::setTimeSignature(int numerator, int denominator)
+{
+    if (numerator > 0 && denominator > 0)
+        beatsPerBar = numerator * 4.0 / denominator;
+}
+
+double TransportClock::getBarPhase() const
+{
+    const double phase = std::fmod(barOriginBeat, beatsPerBar);
+    return phase < 0.0 ? phase + beatsPerBar : phase;
+}
+
+double TransportClock::nextBarBeat() const
+{
+    const double phase = getBarPhase();
+    return phase + std::ceil((currentBeat - phase) / beatsPerBar - kBeatEpsilon) * beatsPerBar;
+}
+
+double TransportClock::noteRateToBeats(int rateIndex)
+{
+    // Steps per beat: 1/32, 1/32., 1/16, 1/16., 1/16T, 1/8, 1/8., 1/8T, 1/4, 1/4., 1/4T, 1/2, 1/2., 1/1
+    static const double stepsPerBeat[] = {
+        8.0,        // 1/32
+        16.0 / 3.0, // 1/32. (dotted)
+        4.0,        // 1/16
+        8.0 / 3.0,  // 1/16. (dotted)
+        6.0,        // 1/16T (triplet)
+        2.0,        // 1/8
+        4.0 / 3.0,  // 1/8. (dotted)
+        3.0,        // 1/8T (triplet)
+        1.0,        // 1/4
+        2.0 / 3.0,  // 1/4. (dotted)
+        1.5,        // 1/4T (triplet)
+        0.5,        // 1/2
+        1.0 / 3.0,  // 1/2. (dotted)
+        0.25        // 1/1 (whole note)
+    };
+
+    return 1.0 / stepsPerBeat[juce::jlimit(0, 13, rateIndex)];
+}
+
+TransportClock::StepPosition TransportClock::locateStep(double beat, double stepBeats, float swing)
+{
+    // Swing keeps each pair of steps 2 * stepBeats long, so find the pair first
+    const double pairBeats = stepBeats * 2.0;
+    const double pair = std::floor(beat / pairBeats);
+    const double pairStart = pair * pairBeats;
+    const double offBeat = pairStart + swungStepBeats(stepBeats, swing, 0);
+    const auto firstIndex = static_cast<long long>(pair) * 2;
+
+    if (beat <= pairStart + kBeatEpsilon)
+        return { firstIndex, pairStart };
+    if (beat <= offBeat + kBeatEpsilon)
+        return { firstIndex + 1, offBeat };
+    return { firstIndex + 2, pairStart + pairBeats };
+}
@@ -0,0 +1,194 @@
+#include "VoiceRenderPool.h"
+#include <thread>
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr int kMaxWorkers = 3;         // The pool is shared, so keep it small
+    constexpr int kSpinIterations = 2000;  // Busy-wait this long before polling
+    constexpr int kIdlePollMs = 1;         // Poll interval of an awake worker with no jobs
+    constexpr int kTimerIntervalMs = 250;
+    constexpr int kTicksBeforeParking = 4; // About a second without a batch request
+
+    inline void cpuRelax() noexcept
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #endif
+    }
+}
+
+//==============================================================================
+class VoiceRenderPool::Worker : public juce::Thread
+{
+public:
+    Worker(VoiceRenderPool& ownerPool, int index)
+        : juce::Thread("Voice Render " + juce::String(index + 1)),
+          pool(ownerPool)
+    {
+    }
+
+    void run() override { pool.workerLoop(*this); }
+
+    juce::WaitableEvent wakeEvent;
+
+private:
+    VoiceRenderPool& pool;
+};
+
+//==============================================================================
+VoiceRenderPool::VoiceRenderPool()
+{
+    startTimer(kTimerIntervalMs);
+}
+
+VoiceRenderPool::~VoiceRenderPool()
+{
+    stopTimer();
+
+    for (auto* worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->wakeEvent.signal();
+    }
+
+    for (auto* worker : workers)
+        worker->stopThread(1000);
+}
+
+void VoiceRenderPool::timerCallback()
+{
+    if (!batchRequested.exchange(false, std::memory_order_relaxed))
+    {
+        // Nobody has asked for a while: let the workers park
+        if (workersAwake.load(std::memory_order_relaxed) && ++idleTicks >= kTicksBeforeParking)
+            workersAwake.store(false, std::memory_order_release);
+        return;
+    }
+
+    idleTicks = 0;
+    if (workersAwake.load(std::memory_order_relaxed))
+        return;
+
+    // First request: start the threads (leaving one core for the host's audio
+    // thread, which also takes part in every batch)
+    if (workers.isEmpty())
+    {
+        const int numWorkers = juce::jlimit(0, kMaxWorkers, juce::SystemStats::getNumCpus() - 1);
+
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            auto* worker = workers.add(new Worker(*this, i));
+
+            if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}))
+                worker->startThread(juce::Thread::Priority::highest);
+        }
+    }
+
+    if (workers.isEmpty())
+        return;
+
+    workersAwake.store(true, std::memory_order_release);
+    for (auto* worker : workers)
+        worker->wakeEvent.signal();
+}
+
+//==============================================================================
+bool VoiceRenderPool::runBatch(Job& job, int numJobs)
+{
+    jassert(numJobs >= 0 && numJobs <= 0xffff);
+
+    if (numJobs < 2)
+        return false;
+
+    // The timer starts or wakes the workers; this batch renders on the caller
+    batchRequested.store(true, std::memory_order_relaxed);
+    if (!workersAwake.load(std::memory_order_acquire))
+        return false;
+
+    // Another instance is using the pool - let the caller render on its own
+    bool expected = false;
+    if (!batchInProgress.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        return false;
+
+    currentJob.store(&job, std::memory_order_relaxed);
+    jobsFinished.store(0, std::memory_order_relaxed);
+    ++batchCounter;
+
+    // Publishing the job word releases the job pointer and counter reset to the workers
+    jobWord.store((static_cast<uint64_t>(batchCounter) << 32)
+                      | (static_cast<uint64_t>(numJobs) << 16),
+                  std::memory_order_seq_cst);
+
+    // The calling thread claims jobs too; if the workers are parking or polling,
+    // it ends up running every job nobody else claimed
+    runPendingJobs();
+
+    // Barrier: spin, then yield, until the workers have finished the jobs they claimed
+    for (int spins = 0; jobsFinished.load(std::memory_order_acquire) < numJobs; ++spins)
+    {
+        if (spins < kSpinIterations)
+            cpuRelax();
+        else
+            std::this_thread::yield();
+    }
+
+    batchInProgress.store(false, std::memory_order_release);
+    return true;
+}
+
+bool VoiceRenderPool::runPendingJobs()
+{
+    bool ranAnyJob = false;
+
+    for (;;)
+    {
+        auto word = jobWord.load(std::memory_order_acquire);
+        const auto nextJob = static_cast<int>(word & 0xffff);
+        const auto jobCount = static_cast<int>((word >> 16) & 0xffff);
+
+        if (nextJob >= jobCount)
+            return ranAnyJob;
+
+        // Claim the job; fails if another thread got there first or a new batch started
+        if (!jobWord.compare_exchange_weak(word, word + 1,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire))
+            continue;
+
+        // The batch cannot complete (and the job pointer cannot change) until this job is done
+        currentJob.load(std::memory_order_acquire)->run(nextJob);
+        jobsFinished.fetch_add(1, std::memory_order_acq_rel);
+        ranAnyJob = true;
+    }
+}
+
+void VoiceRenderPool::workerLoop(Worker& worker)
+{
+    int idleSpins = 0;
+
+    while (!worker.threadShouldExit())
+    {
+        if (runPendingJobs())
+        {
+            idleSpins = 0;
+            continue;
+        }
+
+        // Parked until the timer sees the next batch request (or the pool shuts down)
+        if (!workersAwake.load(std::memory_order_acquire))
+        {
+            worker.wakeEvent.wait(-1);
+            idleSpins = 0;
+            continue;
+        }
+
+        if (++idleSpins < kSpinIterations)
+            cpuRelax();
+        else
+            juce::Thread::sleep(kIdlePollMs);
+    }
+}
@@ -0,0 +1,44 @@
+#include "RenderHarness.h"
+
+//==============================================================================
+/**
+ * Sub-blocks are cut at MIDI and at every step on the transport clock, so what
+ * the processor renders mustn't depend on the host's block size. Renders the
+ * same MIDI and transport script (a tempo change and a loop included) at 1, 64
+ * and 2048 samples per block and compares the outputs sample for sample.
+ */
+class BlockSizeTest : public juce::UnitTest
+{
+public:
+    BlockSizeTest() : juce::UnitTest("Block size independence", "SnorkelSynth") {}
+
+    void runTest() override
+    {
+        beginTest("1, 64 and 2048 sample blocks render the same output");
+
+        const auto reference = renderWithBlockSize(2048);
+        expect(reference.getMagnitude(0, reference.getNumSamples()) > 0.01f, "The script rendered silence");
+
+        for (int blockSize : { 1, 64 })
+        {
+            const int difference = RenderHarness::findFirstDifference(renderWithBlockSize(blockSize), reference, kTolerance);
+            expect(difference < 0, juce::String(blockSize) + "-sample blocks differ from 2048-sample blocks at sample "
+                                       + juce::String(difference));
+        }
+    }
+
+private:
+    // Float rounding only: a step or note landing one sample early or late differs by far more
+    static constexpr float kTolerance = 1.0e-6f;
+
+    static juce::AudioBuffer<float> renderWithBlockSize(int blockSize)
+    {
+        SnorkelSynthAudioProcessor processor;
+        RenderHarness::loadTestScene(processor);
+
+        RenderHarness::ScriptedPlayHead playHead(RenderHarness::tempoChangeAndLoop());
+        return RenderHarness::render(processor, playHead, RenderHarness::heldChords(), RenderHarness::scriptLength, blockSize);
+    }
+};
+
+static BlockSizeTest blockSizeTest;
@@ -0,0 +1,126 @@
+#include "RenderHarness.h"
+
+//==============================================================================
+/**
+ * A preset switch fades the output out and back in, but it mustn't move the
+ * transport clock or any step. Switches, through the host program list, to a
+ * preset that only changes the noise type, which is inaudible with the noise
+ * mix at 0. Then checks the render against one without the switch: the
+ * two must be sample-identical everywhere except the fade, and inside the fade
+ * the switched render may only be quieter.
+ */
+class PresetSwitchTest : public juce::UnitTest
+{
+public:
+    PresetSwitchTest() : juce::UnitTest("Preset switch timing", "SnorkelSynth") {}
+
+    void runTest() override
+    {
+        beginTest("A preset switch leaves every step on the same sample");
+
+        const auto reference = renderWithBlockSize(2048, false);
+        expect(reference.getMagnitude(0, reference.getNumSamples()) > 0.01f, "The script rendered silence");
+
+        for (int blockSize : { 64, 2048 })
+        {
+            const auto switched = renderWithBlockSize(blockSize, true);
+            const juce::String label = juce::String(blockSize) + "-sample blocks: ";
+
+            // Everything before the switch and after its fade matches sample for sample
+            const int before = findFirstDifference(switched, reference, 0, kSwitchSample);
+            expect(before < 0, label + "output differs before the switch at sample " + juce::String(before));
+
+            const int after = findFirstDifference(switched, reference, kSwitchSample + kSwitchWindow, reference.getNumSamples());
+            expect(after < 0, label + "output differs after the switch at sample " + juce::String(after));
+
+            // The fade only ever lowers the level, and it did happen
+            bool onlyQuieter = true;
+            for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+                for (int i = kSwitchSample; i < kSwitchSample + kSwitchWindow; ++i)
+                    onlyQuieter = onlyQuieter
+                               && std::abs(switched.getSample(channel, i)) <= std::abs(reference.getSample(channel, i)) + kTolerance;
+
+            expect(onlyQuieter, label + "the switch added signal instead of fading it");
+            expect(findFirstDifference(switched, reference, kSwitchSample, kSwitchSample + kSwitchWindow) >= 0,
+                   label + "the preset switch never reached the audio thread");
+        }
+    }
+
+private:
+    static constexpr float kTolerance = 1.0e-6f;
+
+    // A 2048-sample boundary between the tempo change and the loop, so every block size starts a block there
+    static constexpr int kSwitchSample = 2048 * 50;
+
+    // Fade out, the rest of the sub-block the fade ended in (at most 32 samples), fade in
+    static constexpr int kFadeSamples = 221; // 5 ms at 44.1 kHz, as in PluginProcessor.cpp
+    static constexpr int kSwitchWindow = 2 * kFadeSamples + 32;
+
+    juce::AudioBuffer<float> renderWithBlockSize(int blockSize, bool switchPreset)
+    {
+        juce::TemporaryFile systemJSON(".json"), compiledBank(".bin"); // Outlive the processor, which maps the bank
+        SnorkelSynthAudioProcessor processor;
+        RenderHarness::loadTestScene(processor);
+
+        // Echoes would carry the faded audio past the end of the fade
+        RenderHarness::setParameter(processor, "delaymix", 0.0f);
+        RenderHarness::setParameter(processor, "delaymixlfodepth", 0.0f);
+
+        RenderHarness::BlockCallback beforeBlock;
+
+        if (switchPreset)
+        {
+            writePresetJSON(processor, systemJSON.getFile());
+            juce::SharedResourcePointer<SharedResourceCache> cache;
+            processor.synthPresetBank = CompiledPresetBank::openOrCompile(compiledBank.getFile(), systemJSON.getFile(),
+                                                                          juce::File(), *cache);
+            expectEquals(processor.synthPresetBank->getNumPresets(), 1);
+
+            beforeBlock = [&processor](juce::int64 blockStart)
+            {
+                if (blockStart == kSwitchSample)
+                    processor.setCurrentProgram(0);
+            };
+        }
+
+        RenderHarness::ScriptedPlayHead playHead(RenderHarness::tempoChangeAndLoop());
+        return RenderHarness::render(processor, playHead, RenderHarness::heldChords(), RenderHarness::scriptLength,
+                                     blockSize, beforeBlock);
+    }
+
+    // One preset holding the scene's current values, except a different noise type
+    static void writePresetJSON(SnorkelSynthAudioProcessor& processor, const juce::File& file)
+    {
+        auto* preset = new juce::DynamicObject();
+        preset->setProperty("name", "Switch test");
+
+        for (const auto& spec : Param::kSpecs)
+        {
+            if (spec.presetKey == nullptr)
+                continue;
+
+            auto* parameter = processor.getValueTreeState().getParameter(spec.id);
+            const float value = parameter->convertFrom0to1(parameter->getValue());
+            preset->setProperty(spec.presetKey, spec.isDiscrete() ? juce::var(juce::roundToInt(value)) : juce::var(value));
+        }
+
+        auto* noiseType = processor.getValueTreeState().getParameter("noisetype");
+        preset->setProperty("noiseType", noiseType->convertFrom0to1(noiseType->getValue()) > 0.5f ? 0.2f : 0.8f);
+
+        auto* bank = new juce::DynamicObject();
+        bank->setProperty("presets", juce::Array<juce::var> { juce::var(preset) });
+        file.replaceWithText(juce::JSON::toString(juce::var(bank)));
+    }
+
+    static int findFirstDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int start, int end)
+    {
+        for (int i = start; i < end; ++i)
+            for (int channel = 0; channel < a.getNumChannels(); ++channel)
+                if (std::abs(a.getSample(channel, i) - b.getSample(channel, i)) > kTolerance)
+                    return i;
+
+        return -1;
+    }
+};
+
+static PresetSwitchTest presetSwitchTest;
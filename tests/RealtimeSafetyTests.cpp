@@ -0,0 +1,122 @@
+#include "RenderHarness.h"
+#include "RealtimeSanitizer.h"
+
+//==============================================================================
+/**
+ * processBlock must not touch the allocator. The test app is always built
+ * with SNORKEL_RT_SANITIZER, so every operator new or delete inside
+ * processBlock is counted; these tests fail if the count goes up. The
+ * scripted session also exercises what the host and the editor do between
+ * blocks: re-preparing, automation, preset and kit switches, pattern edits. With
+ * -DSNORKEL_RT_SANITIZER=ON and Clang 20 or later, RTSan also stops the run
+ * at the first lock, file access or malloc.
+ */
+class RealtimeSafetyTest : public juce::UnitTest
+{
+public:
+    RealtimeSafetyTest() : juce::UnitTest("Real-time safety", "SnorkelSynth") {}
+
+    void runTest() override
+    {
+        beginTest("Arpeggiator, sequencer and drums render without allocating");
+        {
+            SnorkelSynthAudioProcessor processor;
+            RenderHarness::loadTestScene(processor);
+            RenderHarness::ScriptedPlayHead playHead(RenderHarness::tempoChangeAndLoop());
+
+            const int violationsBefore = RealtimeSanitizer::getViolationCount();
+            const auto output = RenderHarness::render(processor, playHead, RenderHarness::heldChords(),
+                                                      RenderHarness::scriptLength, 512);
+
+            expect(output.getMagnitude(0, output.getNumSamples()) > 0.01f, "The script rendered silence");
+            expectEquals(RealtimeSanitizer::getViolationCount() - violationsBefore, 0,
+                         "processBlock allocated or freed memory (see the reports on stderr)");
+        }
+
+        beginTest("A session with automation, preset and kit switches renders without allocating");
+        {
+            juce::TemporaryFile systemJSON(".json"), compiledBank(".bin"); // Outlive the processor, which maps the bank
+            SnorkelSynthAudioProcessor processor;
+            RenderHarness::loadTestScene(processor);
+
+            systemJSON.getFile().replaceWithText(kPresetBankJSON);
+            juce::SharedResourcePointer<SharedResourceCache> cache;
+            processor.synthPresetBank = CompiledPresetBank::openOrCompile(compiledBank.getFile(), systemJSON.getFile(),
+                                                                          juce::File(), *cache);
+            expectEquals(processor.synthPresetBank->getNumPresets(), 2);
+
+            const int violationsBefore = RealtimeSanitizer::getViolationCount();
+
+            // Prepared twice, the way a host does when its buffer size changes
+            for (int blockSize : { 256, 1024 })
+            {
+                RenderHarness::ScriptedPlayHead playHead(RenderHarness::tempoChangeAndLoop());
+                RenderHarness::render(processor, playHead, RenderHarness::heldChords(), RenderHarness::scriptLength, blockSize,
+                                      [&processor, blockSize](juce::int64 blockStart)
+                                      {
+                                          runSessionScript(processor, static_cast<int>(blockStart / blockSize));
+                                      });
+            }
+
+            expectEquals(RealtimeSanitizer::getViolationCount() - violationsBefore, 0,
+                         "processBlock allocated or freed memory during the session (see the reports on stderr)");
+        }
+    }
+
+private:
+    static constexpr const char* kPresetBankJSON = R"({ "presets": [
+        { "name": "Dark", "cutoff": 400, "resonance": 0.9, "drive": 0.4, "saturationType": 2, "delayMix": 0.3, "delayTime": 4 },
+        { "name": "Bright", "cutoff": 3000, "resonance": 0.3, "noiseMix": 0.2, "unison": 1, "delayMix": 0.0 }
+    ] })";
+
+    // Message-thread work done between blocks: what a user and the host's automation
+    // would do over a few minutes, compressed. Noise, drift and unison come and go
+    // too, unlike in the deterministic renders.
+    static void runSessionScript(SnorkelSynthAudioProcessor& processor, int block)
+    {
+        using RenderHarness::setParameter;
+
+        // Automation every block
+        const float phase = static_cast<float>(block % 64) / 64.0f;
+        setParameter(processor, "cutoff", 300.0f + 3000.0f * phase);
+        setParameter(processor, "resonance", 0.2f + 0.6f * phase);
+        setParameter(processor, "delaymix", block % 96 < 48 ? 0.3f : 0.0f);
+        setParameter(processor, "delaymixlfodepth", block % 128 < 64 ? 0.2f : 0.0f);
+        setParameter(processor, "drift", block % 80 < 40 ? 0.5f : 0.0f);
+
+        // Rates, modes and swing change less often
+        if (block % 16 == 0)
+        {
+            const int step = block / 16;
+            setParameter(processor, "arprate", static_cast<float>(step % 6));
+            setParameter(processor, "arpmode", static_cast<float>(step % 5));
+            setParameter(processor, "arpswing", static_cast<float>(step % 3) * 0.25f);
+            setParameter(processor, "seqrate", static_cast<float>(2 + step % 4));
+            setParameter(processor, "delaytime", static_cast<float>(step % 12));
+        }
+
+        // Preset switches through the host program list, with their crossfade
+        if (block % 40 == 20)
+            processor.setCurrentProgram((block / 40) % 2);
+
+        // Kit switches, with the loader's clean-up of the kits the audio thread let go
+        if (block % 60 == 30)
+            processor.drumSampler.postKit(RenderHarness::makeTestKit());
+        processor.drumSampler.collectRetiredKits();
+
+        // Pattern edits and queued pattern changes
+        if (block % 50 == 10)
+        {
+            processor.patternStore.edit([block](PatternData& patterns)
+            {
+                const int step = (block / 50) % 16;
+                patterns.melody[1].noteMask[step] = static_cast<uint8_t>(1u << (block % 7));
+                patterns.drums[1].set(DrumSampler::snare, step, true);
+            });
+            processor.selectMelodyPattern((block / 50) % 2);
+            processor.selectDrumPattern((block / 50) % 2);
+        }
+    }
+};
+
+static RealtimeSafetyTest realtimeSafetyTest;
@@ -0,0 +1,191 @@
+#include "RenderHarness.h"
+
+namespace RenderHarness
+{
+    //==============================================================================
+    ScriptedPlayHead::ScriptedPlayHead(std::vector<TransportSegment> segmentsToUse)
+        : segments(std::move(segmentsToUse))
+    {
+        jassert(!segments.empty() && segments.front().startSample == 0);
+    }
+
+    juce::Optional<juce::AudioPlayHead::PositionInfo> ScriptedPlayHead::getPosition() const
+    {
+        auto segment = segments.front();
+        for (const auto& next : segments)
+            if (next.startSample <= samplePosition)
+                segment = next;
+
+        const double ppq = segment.startPpq
+                         + static_cast<double>(samplePosition - segment.startSample) * segment.bpm / (60.0 * sampleRate);
+
+        PositionInfo info;
+        info.setIsPlaying(true);
+        info.setBpm(segment.bpm);
+        info.setTimeSignature(TimeSignature {});
+        info.setTimeInSamples(samplePosition);
+        info.setPpqPosition(ppq);
+        info.setPpqPositionOfLastBarStart(std::floor(ppq / 4.0) * 4.0);
+        return info;
+    }
+
+    //==============================================================================
+    std::vector<TransportSegment> tempoChangeAndLoop()
+    {
+        constexpr juce::int64 tempoChange = 2048 * 40;
+        constexpr juce::int64 loop = 2048 * 80;
+
+        return {
+            { 0, 0.0, 120.0 },
+            { tempoChange, static_cast<double>(tempoChange) * 120.0 / (60.0 * sampleRate), 140.0 },
+            { loop, 0.0, 140.0 }
+        };
+    }
+
+    std::vector<ScriptedEvent> heldChords()
+    {
+        return {
+            { 1000, juce::MidiMessage::noteOn(1, 48, 0.8f) },
+            { 1517, juce::MidiMessage::noteOn(1, 55, 0.7f) },
+            { 70001, juce::MidiMessage::noteOff(1, 55) },
+            { 70001, juce::MidiMessage::noteOn(1, 51, 0.9f) },
+            { 150333, juce::MidiMessage::noteOff(1, 48) },
+            { 150333, juce::MidiMessage::noteOff(1, 51) },
+            { 170071, juce::MidiMessage::noteOn(1, 43, 0.6f) },
+            { 231111, juce::MidiMessage::noteOff(1, 43) }
+        };
+    }
+
+    //==============================================================================
+    void loadTestScene(SnorkelSynthAudioProcessor& processor)
+    {
+        setParameter(processor, "parallelrender", 0.0f);
+        setParameter(processor, "noisemix", 0.0f);
+        setParameter(processor, "drift", 0.0f);
+        setParameter(processor, "phaserandom", 0.0f);
+        setParameter(processor, "unison", 0.0f);
+
+        setParameter(processor, "arponoff", 1.0f);
+        setParameter(processor, "seqenabled", 1.0f);
+        setParameter(processor, "drumenable", 1.0f);
+        setParameter(processor, "drumsidechainmag", 0.6f);
+        setParameter(processor, "cutofflfod", 0.2f); // Voice LFOs run per sample, so they take part
+        setParameter(processor, "delaymix", 0.3f);
+        setParameter(processor, "delaymixlfodepth", 0.2f); // The mix LFO's segments run on a fixed grid
+
+        processor.patternStore.edit([](PatternData& patterns)
+        {
+            auto& melody = patterns.melody[0];
+            melody = PatternData::MelodyPattern();
+            for (int step : { 0, 4, 8, 12 })
+                melody.noteMask[step] = static_cast<uint8_t>(1u << 0);
+            for (int step : { 2, 10 })
+                melody.noteMask[step] = static_cast<uint8_t>(1u << 2);
+            melody.noteMask[6] = static_cast<uint8_t>(1u << 4);
+            melody.setOctave(6, 4, 1);
+
+            auto& drums = patterns.drums[0];
+            drums = PatternData::DrumPattern();
+            for (int step = 0; step < 16; ++step)
+            {
+                drums.set(DrumSampler::kick, step, step % 4 == 0);
+                drums.set(DrumSampler::snare, step, step % 8 == 4);
+                drums.set(DrumSampler::closedHat, step, step % 2 == 0); // Chokes the open hat on step 0
+                drums.set(DrumSampler::openHat, step, step == 14);
+            }
+        });
+
+        processor.drumSampler.postKit(makeTestKit());
+    }
+
+    std::unique_ptr<DrumSampler::Kit> makeTestKit()
+    {
+        auto kit = std::make_unique<DrumSampler::Kit>();
+        kit->name = "Test";
+        kit->sampleRate = sampleRate;
+
+        const double lengthSeconds[DrumSampler::numLanes] = { 0.25, 0.15, 0.05, 0.3 };
+        juce::Random random(0x5eed);
+
+        for (int lane = 0; lane < DrumSampler::numLanes; ++lane)
+        {
+            auto sample = std::make_shared<SharedResourceCache::AudioSample>();
+            sample->sampleRate = sampleRate;
+            sample->buffer.setSize(1, juce::roundToInt(lengthSeconds[lane] * sampleRate));
+
+            auto* data = sample->buffer.getWritePointer(0);
+            for (int i = 0; i < sample->buffer.getNumSamples(); ++i)
+            {
+                const float decay = 1.0f - static_cast<float>(i) / static_cast<float>(sample->buffer.getNumSamples());
+                const float tone = lane == DrumSampler::kick
+                                 ? std::sin(juce::MathConstants<float>::twoPi * 60.0f * static_cast<float>(i) / static_cast<float>(sampleRate))
+                                 : random.nextFloat() * 2.0f - 1.0f;
+                data[i] = 0.5f * tone * decay * decay;
+            }
+
+            kit->lanes[lane] = std::move(sample);
+        }
+
+        return kit;
+    }
+
+    void setParameter(SnorkelSynthAudioProcessor& processor, const juce::String& id, float plainValue)
+    {
+        auto* parameter = processor.getValueTreeState().getParameter(id);
+        jassert(parameter != nullptr);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+    }
+
+    //==============================================================================
+    juce::AudioBuffer<float> render(SnorkelSynthAudioProcessor& processor, ScriptedPlayHead& playHead,
+                                    const std::vector<ScriptedEvent>& events, int numSamples, int blockSize,
+                                    const BlockCallback& beforeBlock)
+    {
+        // Rendered offline, as in a bounce: the CPU governor stays at full quality
+        processor.setNonRealtime(true);
+        processor.setPlayHead(&playHead);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> output(numChannels, numSamples);
+        juce::AudioBuffer<float> block(numChannels, blockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize(1024);
+        size_t nextEvent = 0;
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            const int size = juce::jmin(blockSize, numSamples - start);
+            block.setSize(numChannels, size, false, false, true);
+
+            midi.clear();
+            for (; nextEvent < events.size() && events[nextEvent].samplePosition < start + size; ++nextEvent)
+                midi.addEvent(events[nextEvent].message, static_cast<int>(events[nextEvent].samplePosition - start));
+
+            if (beforeBlock != nullptr)
+                beforeBlock(start);
+
+            playHead.setSamplePosition(start);
+            processor.processBlock(block, midi);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                output.copyFrom(channel, start, block, channel, 0, size);
+        }
+
+        processor.releaseResources();
+        processor.setPlayHead(nullptr);
+        return output;
+    }
+
+    int findFirstDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, float tolerance)
+    {
+        jassert(a.getNumChannels() == b.getNumChannels() && a.getNumSamples() == b.getNumSamples());
+
+        for (int i = 0; i < a.getNumSamples(); ++i)
+            for (int channel = 0; channel < a.getNumChannels(); ++channel)
+                if (std::abs(a.getSample(channel, i) - b.getSample(channel, i)) > tolerance)
+                    return i;
+
+        return -1;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+#include <functional>
+#include <vector>
+
+//==============================================================================
+/**
+ * Offline rendering for the tests: plays a processor through a fixed MIDI and
+ * transport script in blocks of any size, the way a host would, and collects
+ * what it renders.
+ */
+namespace RenderHarness
+{
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int numChannels = 2;
+
+    /** A stretch of the host timeline: from startSample the transport plays at bpm from startPpq. */
+    struct TransportSegment
+    {
+        juce::int64 startSample = 0;
+        double startPpq = 0.0;
+        double bpm = 120.0;
+    };
+
+    /** Host play head following a list of transport segments; a tempo change or a loop starts the next one. */
+    class ScriptedPlayHead : public juce::AudioPlayHead
+    {
+    public:
+        explicit ScriptedPlayHead(std::vector<TransportSegment> segmentsToUse);
+
+        // Where the next block starts
+        void setSamplePosition(juce::int64 newPosition) { samplePosition = newPosition; }
+
+        juce::Optional<PositionInfo> getPosition() const override;
+
+    private:
+        std::vector<TransportSegment> segments; // Sorted by startSample, first one at 0
+        juce::int64 samplePosition = 0;
+    };
+
+    /** A MIDI message at an absolute sample position. */
+    struct ScriptedEvent
+    {
+        juce::int64 samplePosition = 0;
+        juce::MidiMessage message;
+    };
+
+    // The shared script: 120 bpm, a change to 140 bpm, then a loop back to beat 0.
+    // Both happen on 2048-sample boundaries, where every tested block size starts a block.
+    static constexpr int scriptLength = 2048 * 120;
+    std::vector<TransportSegment> tempoChangeAndLoop();
+
+    // Held chords for the arpeggiator, at positions that don't line up with any block size
+    std::vector<ScriptedEvent> heldChords();
+
+    // Sets up arpeggiator, sequencer, drums (with a generated kit), sidechain and delay,
+    // with everything that draws random numbers or works per host block (noise, drift,
+    // parallel voices) off
+    void loadTestScene(SnorkelSynthAudioProcessor& processor);
+
+    // A kit of short generated hits, so the tests don't depend on samples on disk
+    std::unique_ptr<DrumSampler::Kit> makeTestKit();
+
+    void setParameter(SnorkelSynthAudioProcessor& processor, const juce::String& id, float plainValue);
+
+    // Called before each block with the block's first sample (message-thread work, automation)
+    using BlockCallback = std::function<void(juce::int64 blockStart)>;
+
+    /** Prepares processor for blockSize and renders numSamples of the script offline.
+        Returns the output, numChannels by numSamples. */
+    juce::AudioBuffer<float> render(SnorkelSynthAudioProcessor& processor, ScriptedPlayHead& playHead,
+                                    const std::vector<ScriptedEvent>& events, int numSamples, int blockSize,
+                                    const BlockCallback& beforeBlock = nullptr);
+
+    // First sample where a and b differ by more than tolerance on any channel, or -1
+    int findFirstDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, float tolerance);
+}
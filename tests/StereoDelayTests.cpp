@@ -0,0 +1,196 @@
+#include "RenderHarness.h"
+#include "StereoDelay.h"
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+//==============================================================================
+/**
+ * StereoDelay copies whole spans through its ring buffer. Checks that against a
+ * plain per-sample feedback delay. The block sizes are random, and some blocks
+ * are longer than the prepared size. Delays are shorter and longer than a block,
+ * and the ring wraps many times. Also checks that a delay change glides the same
+ * way whatever the block size, and logs how long StereoDelay takes next to a
+ * per-sample juce::dsp::DelayLine.
+ */
+class StereoDelayTest : public juce::UnitTest
+{
+public:
+    StereoDelayTest() : juce::UnitTest("Stereo delay", "SnorkelSynth") {}
+
+    void runTest() override
+    {
+        beginTest("A steady delay matches a per-sample delay line");
+        {
+            for (int delay : { 1, 7, 300, 3000 })
+            {
+                const auto input = makeInput(kLength);
+                const auto mix = makeMixCurve(kLength);
+                const auto expected = renderReference(input, mix, delay);
+
+                auto actual = input;
+                renderBlocks(actual, mix, { { 0, static_cast<float>(delay) } }, getRandom().nextInt());
+
+                const int difference = RenderHarness::findFirstDifference(actual, expected, 1.0e-5f);
+                expect(difference < 0, "Delay of " + juce::String(delay) + " samples differs at sample " + juce::String(difference));
+            }
+        }
+
+        beginTest("A delay change glides the same at any block size");
+        {
+            const auto input = makeInput(kLength);
+            const auto mix = makeMixCurve(kLength);
+            const std::vector<DelayChange> changes { { 0, 2000.0f }, { 12000, 1500.0f }, { 30000, 2500.0f } };
+
+            auto perSample = input;
+            renderBlocks(perSample, mix, changes, 0);
+
+            auto blocks = input;
+            renderBlocks(blocks, mix, changes, getRandom().nextInt());
+
+            const int difference = RenderHarness::findFirstDifference(blocks, perSample, 1.0e-6f);
+            expect(difference < 0, "Block and per-sample renders differ at sample " + juce::String(difference));
+        }
+
+        beginTest("Timing against a per-sample dsp::DelayLine");
+        {
+            // Timings vary with the machine and build type, so they're only logged
+            const auto input = makeInput(kBenchmarkLength);
+            const auto mix = makeMixCurve(kBenchmarkLength);
+
+            auto spans = input;
+            const double spansMs = timeRender([&] { renderBlocks(spans, mix, { { 0, kBenchmarkDelay } }, 1); });
+
+            auto perSample = input;
+            const double perSampleMs = timeRender([&] { renderDelayLine(perSample, mix); });
+
+            logMessage("StereoDelay: " + juce::String(spansMs, 2) + " ms, dsp::DelayLine: " + juce::String(perSampleMs, 2)
+                       + " ms for " + juce::String(kBenchmarkLength / kSampleRate, 1) + " s of stereo");
+
+            expect(spans.getMagnitude(0, spans.getNumSamples()) > 0.01f, "StereoDelay rendered silence");
+            expect(perSample.getMagnitude(0, perSample.getNumSamples()) > 0.01f, "dsp::DelayLine rendered silence");
+        }
+    }
+
+private:
+    static constexpr double kSampleRate = 44100.0;
+    static constexpr int kMaxBlockSize = 512;
+    static constexpr int kLength = 50000;
+    static constexpr float kFeedback = 0.6f;
+    static constexpr double kMaxDelaySeconds = 0.1; // A short ring, so it wraps several times
+    static constexpr int kBenchmarkLength = 44100 * 20;
+    static constexpr float kBenchmarkDelay = 3000.0f;
+
+    struct DelayChange
+    {
+        int sample = 0;
+        float delaySamples = 0.0f; // Whole samples, so a finished glide reads the same as the steady path
+    };
+
+    juce::AudioBuffer<float> makeInput(int numSamples)
+    {
+        juce::AudioBuffer<float> input(2, numSamples);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample(channel, i, (i / 4000) % 2 == 0 ? getRandom().nextFloat() * 2.0f - 1.0f : 0.0f); // Bursts and gaps
+
+        return input;
+    }
+
+    static std::vector<float> makeMixCurve(int numSamples)
+    {
+        std::vector<float> mix(static_cast<size_t>(numSamples));
+        for (int i = 0; i < numSamples; ++i)
+            mix[static_cast<size_t>(i)] = 0.5f + 0.3f * std::sin(static_cast<float>(i) * 0.001f);
+
+        return mix;
+    }
+
+    // The textbook delay: every sample reads the one written delay samples earlier
+    static juce::AudioBuffer<float> renderReference(const juce::AudioBuffer<float>& input, const std::vector<float>& mix, int delay)
+    {
+        juce::AudioBuffer<float> output(input);
+        std::vector<float> line(static_cast<size_t>(input.getNumSamples()), 0.0f);
+
+        for (int channel = 0; channel < input.getNumChannels(); ++channel)
+        {
+            std::fill(line.begin(), line.end(), 0.0f);
+            float* io = output.getWritePointer(channel);
+
+            for (int i = 0; i < input.getNumSamples(); ++i)
+            {
+                const float delayed = i >= delay ? line[static_cast<size_t>(i - delay)] : 0.0f;
+                const float dry = io[i];
+
+                line[static_cast<size_t>(i)] = dry + delayed * kFeedback;
+                io[i] = dry + (delayed - dry) * mix[static_cast<size_t>(i)];
+            }
+        }
+
+        return output;
+    }
+
+    template <typename Render>
+    static double timeRender(Render&& render)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        render();
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1000.0;
+    }
+
+    // The same feedback delay through juce::dsp::DelayLine, one sample at a time
+    static void renderDelayLine(juce::AudioBuffer<float>& buffer, const std::vector<float>& mix)
+    {
+        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> line(
+            static_cast<int>(kSampleRate * kMaxDelaySeconds) + 1);
+        line.prepare({ kSampleRate, static_cast<juce::uint32>(kMaxBlockSize), 2 });
+        line.setDelay(kBenchmarkDelay);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            float* io = buffer.getWritePointer(channel);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const float delayed = line.popSample(channel);
+                const float dry = io[i];
+
+                line.pushSample(channel, dry + delayed * kFeedback);
+                io[i] = dry + (delayed - dry) * mix[static_cast<size_t>(i)];
+            }
+        }
+    }
+
+    // Processes buffer in place; a seed of 0 means one sample per block, otherwise random block
+    // sizes from that seed, with every fourth block longer than the prepared size
+    static void renderBlocks(juce::AudioBuffer<float>& buffer, const std::vector<float>& mix,
+                             const std::vector<DelayChange>& changes, int seed)
+    {
+        StereoDelay delay;
+        delay.prepare(kSampleRate, kMaxBlockSize, kMaxDelaySeconds);
+        delay.setFeedback(kFeedback);
+
+        juce::Random random(seed);
+        size_t nextChange = 0;
+        int blockCount = 0;
+
+        for (int start = 0; start < buffer.getNumSamples();)
+        {
+            int blockSize = 1;
+            if (seed != 0)
+                blockSize = ++blockCount % 4 == 0 ? kMaxBlockSize + 1 + random.nextInt(kMaxBlockSize) : 1 + random.nextInt(kMaxBlockSize);
+
+            // Delay changes arrive at the start of a block, as they do from processBlock
+            if (nextChange < changes.size() && changes[nextChange].sample <= start)
+                delay.setDelaySamples(changes[nextChange++].delaySamples);
+            if (nextChange < changes.size())
+                blockSize = juce::jmin(blockSize, changes[nextChange].sample - start);
+            blockSize = juce::jmin(blockSize, buffer.getNumSamples() - start);
+
+            float* channels[] = { buffer.getWritePointer(0, start), buffer.getWritePointer(1, start) };
+            delay.process(channels, 2, blockSize, mix.data() + start);
+            start += blockSize;
+        }
+    }
+};
+
+static StereoDelayTest stereoDelayTest;
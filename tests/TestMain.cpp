@@ -0,0 +1,35 @@
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+//==============================================================================
+// Runs every juce::UnitTest in the "SnorkelSynth" category, or the one named on
+// the command line, and exits non-zero if any expectation failed.
+int main(int argc, char* argv[])
+{
+    // The processor starts timers and async updates, so it needs a message manager
+    // (nothing dispatches it, which keeps background preset loads out of the renders)
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (argc > 1)
+    {
+        juce::Array<juce::UnitTest*> tests;
+        for (auto* test : juce::UnitTest::getTestsInCategory("SnorkelSynth"))
+            if (test->getName() == juce::String(argv[1]))
+                tests.add(test);
+
+        runner.runTests(tests);
+    }
+    else
+    {
+        runner.runTestsInCategory("SnorkelSynth");
+    }
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+
+    return runner.getNumResults() > 0 && failures == 0 ? 0 : 1;
+}